@@ -1,6 +1,8 @@
 #include "../../shared.h"
+#include "../../cuda/shared.h"
 #include "../hale_data.h"
 #include "hale.h"
+#include "init.k"
 #include <math.h>
 
 // Initialises the cell mass, sub-cell mass and sub-cell volume
@@ -13,7 +15,8 @@ void init_mesh_mass(const int ncells, const int nnodes,
     int* cells_to_nodes_offsets, int* cells_to_nodes,
     int* subcells_to_faces_offsets, int* subcells_to_faces,
     int* nodes_to_cells_offsets, int* nodes_to_cells,
-    double* subcell_centroids_x, double* subcell_centroids_y,
+    int* nodes_to_subcells, double* subcell_centroids_x,
+    double* subcell_centroids_y,
     double* subcell_centroids_z, double* subcell_volume,
     double* cell_volume, double* nodal_volumes,
     double* cell_mass) {
@@ -88,9 +91,9 @@ void calc_volumes_centroids(
 }
 
 // Initialises the centroids for each cell
-void init_cell_centroids(const int ncells, const int* cells_to_nodes_offsets,
-    const int* cells_to_nodes, const double* nodes_x,
-    const double* nodes_y, const double* nodes_z,
+void init_cell_centroids(const int ncells, const int* cell_list,
+    const int* cells_to_nodes_offsets, const int* cells_to_nodes,
+    const double* nodes_x, const double* nodes_y, const double* nodes_z,
     double* cell_centroids_x, double* cell_centroids_y,
     double* cell_centroids_z) {
 
@@ -99,7 +102,7 @@ void init_cell_centroids(const int ncells, const int* cells_to_nodes_offsets,
   // Calculate the cell centroids
   START_PROFILING(&compute_profile);
   calc_cell_centroids<<<nblocks_cells, NTHREADS>>>(
-      ncells,  cells_to_nodes_offsets, cells_to_nodes,  nodes_x,
+      ncells, cell_list, cells_to_nodes_offsets, cells_to_nodes,  nodes_x,
       nodes_y,  nodes_z,
       cell_centroids_x,  cell_centroids_y,
       cell_centroids_z);
@@ -366,6 +369,31 @@ void init_subcells_to_subcells(
   }
 }
 
+// Initialises the orientation of each subcell face about the subcell's node,
+// and the slot of each subcell neighbour that refers back to the subcell
+void init_subcell_face_orientations(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* cells_to_nodes, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_cclockwise_cell,
+    const int* subcells_to_faces_offsets, const int* subcells_to_faces,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    int* subcell_face_rnodes, int* subcell_face_lnodes,
+    int* subcell_face_r_faces, int* subcell_face_l_faces,
+    int* subcell_face_r_face_rnodes, int* subcell_neighbour_slots) {
+
+  const int nblocks_cells = ceil(ncells/(double)NTHREADS);
+
+  START_PROFILING(&compute_profile);
+  calc_subcell_face_orientations<<<nblocks_cells, NTHREADS>>>(
+      ncells, cells_to_nodes_offsets, cells_to_nodes, faces_to_nodes_offsets,
+      faces_to_nodes, faces_cclockwise_cell, subcells_to_faces_offsets,
+      subcells_to_faces, subcells_to_subcells_offsets, subcells_to_subcells,
+      subcell_face_rnodes, subcell_face_lnodes, subcell_face_r_faces,
+      subcell_face_l_faces, subcell_face_r_face_rnodes,
+      subcell_neighbour_slots);
+  STOP_PROFILING(&compute_profile, __func__);
+}
+
 // NOTE: This is not intended to be a production device, rather used for
 // debugging the code against a well tested description of the subcell mesh.
 void init_subcell_data_structures(Mesh* mesh, HaleData* hale_data,
@@ -693,3 +721,172 @@ void init_subcell_data_structures(Mesh* mesh, HaleData* hale_data,
     }
   }
 }
+
+// Initialises the list of subcells attached to each node
+void init_nodes_to_subcells(const int nnodes, const int* nodes_to_cells_offsets,
+                            const int* nodes_to_cells,
+                            const int* cells_to_nodes_offsets,
+                            const int* cells_to_nodes, int* nodes_to_subcells) {
+
+  const int nblocks_nodes = ceil(nnodes/(double)NTHREADS);
+
+  START_PROFILING(&compute_profile);
+  calc_nodes_to_subcells<<<nblocks_nodes, NTHREADS>>>(
+      nnodes, nodes_to_cells_offsets, nodes_to_cells, cells_to_nodes_offsets,
+      cells_to_nodes, nodes_to_subcells);
+  STOP_PROFILING(&compute_profile, __func__);
+}
+
+// Initialises the subcells of each face node, for both of the face's cells
+void init_faces_nodes_to_subcells(
+    const int nfaces, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_to_cells1, const int* cells_to_nodes_offsets,
+    const int* cells_to_nodes, int* faces_nodes_to_subcells0,
+    int* faces_nodes_to_subcells1) {
+
+  const int nblocks_faces = ceil(nfaces/(double)NTHREADS);
+
+  START_PROFILING(&compute_profile);
+  calc_faces_nodes_to_subcells<<<nblocks_faces, NTHREADS>>>(
+      nfaces, faces_to_nodes_offsets, faces_to_nodes, faces_to_cells0,
+      faces_to_cells1, cells_to_nodes_offsets, cells_to_nodes,
+      faces_nodes_to_subcells0, faces_nodes_to_subcells1);
+  STOP_PROFILING(&compute_profile, __func__);
+}
+
+// Determines whether every cell in the mesh is a hexahedron
+int is_hex_mesh(const int ncells, const int nfaces,
+                const int* cells_to_nodes_offsets,
+                const int* cells_to_faces_offsets,
+                const int* faces_to_nodes_offsets) {
+
+  const int nblocks_offsets = ceil((max(ncells, nfaces) + 1)/(double)NTHREADS);
+
+  int* d_nnon_hex;
+  gpu_check(cudaMalloc((void**)&d_nnon_hex, sizeof(int)));
+  gpu_check(cudaMemset(d_nnon_hex, 0, sizeof(int)));
+
+  START_PROFILING(&compute_profile);
+  count_non_hex<<<nblocks_offsets, NTHREADS>>>(
+      ncells, nfaces, cells_to_nodes_offsets, cells_to_faces_offsets,
+      faces_to_nodes_offsets, d_nnon_hex);
+  STOP_PROFILING(&compute_profile, __func__);
+
+  int nnon_hex;
+  gpu_check(cudaMemcpy(&nnon_hex, d_nnon_hex, sizeof(int),
+                       cudaMemcpyDeviceToHost));
+  gpu_check(cudaFree(d_nnon_hex));
+
+  return nnon_hex == 0;
+}
+
+// Colours the faces so that no two faces of the same colour share a cell
+int init_face_colours(const int nfaces, const int* faces_to_cells0,
+                      const int* faces_to_cells1,
+                      const int* cells_to_faces_offsets,
+                      const int* cells_to_faces, int* face_colours,
+                      int* face_colour_offsets, int* faces_by_colour) {
+
+  int* d_nface_colours;
+  gpu_check(cudaMalloc((void**)&d_nface_colours, sizeof(int)));
+
+  START_PROFILING(&compute_profile);
+  calc_face_colours<<<1, 1>>>(
+      nfaces, faces_to_cells0, faces_to_cells1, cells_to_faces_offsets,
+      cells_to_faces, face_colours, face_colour_offsets, faces_by_colour,
+      d_nface_colours);
+  STOP_PROFILING(&compute_profile, __func__);
+
+  int nface_colours;
+  gpu_check(cudaMemcpy(&nface_colours, d_nface_colours, sizeof(int),
+                       cudaMemcpyDeviceToHost));
+  gpu_check(cudaFree(d_nface_colours));
+  if (nface_colours == -1) {
+    TERMINATE("Unable to colour the faces with %d colours.",
+              MAX_FACE_COLOURS);
+  }
+
+  printf("Coloured %d faces with %d colours.\n", nfaces, nface_colours);
+
+  return nface_colours;
+}
+
+// Determines the unique edges of the mesh, numbering the edge of each face
+// edge, and returns the number of edges
+int init_face_edges_to_edges(const int nfaces,
+                             const int* faces_to_nodes_offsets,
+                             const int* faces_to_nodes,
+                             const int* nodes_to_faces_offsets,
+                             const int* nodes_to_faces,
+                             int* face_edges_to_edges) {
+
+  const int nblocks_faces = ceil(nfaces/(double)NTHREADS);
+
+  int* d_nedges;
+  gpu_check(cudaMalloc((void**)&d_nedges, sizeof(int)));
+
+  START_PROFILING(&compute_profile);
+  calc_first_face_edges<<<nblocks_faces, NTHREADS>>>(
+      nfaces, faces_to_nodes_offsets, faces_to_nodes, nodes_to_faces_offsets,
+      nodes_to_faces, face_edges_to_edges);
+  calc_edge_numbering<<<1, 1>>>(nfaces, faces_to_nodes_offsets,
+                                face_edges_to_edges, d_nedges);
+  STOP_PROFILING(&compute_profile, __func__);
+
+  int nedges;
+  gpu_check(
+      cudaMemcpy(&nedges, d_nedges, sizeof(int), cudaMemcpyDeviceToHost));
+  gpu_check(cudaFree(d_nedges));
+
+  return nedges;
+}
+
+// Initialises the nodes of each edge and the faces holding it, with the face
+// edge of each face
+void init_edges(const int nfaces, const int nedges,
+                const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+                const int* face_edges_to_edges, int* edges_to_nodes,
+                int* edges_to_faces_offsets, int* edges_to_faces,
+                int* edges_to_face_edges) {
+
+  START_PROFILING(&compute_profile);
+  calc_edges<<<1, 1>>>(nfaces, nedges, faces_to_nodes_offsets, faces_to_nodes,
+                       face_edges_to_edges, edges_to_nodes,
+                       edges_to_faces_offsets, edges_to_faces,
+                       edges_to_face_edges);
+  STOP_PROFILING(&compute_profile, __func__);
+}
+
+// Colours the edges so that no two edges of the same colour share a node
+int init_edge_colours(const int nedges, const int* edges_to_nodes,
+                      const int* nodes_to_faces_offsets,
+                      const int* nodes_to_faces,
+                      const int* faces_to_nodes_offsets,
+                      const int* faces_to_nodes,
+                      const int* face_edges_to_edges, int* edge_colours,
+                      int* edge_colour_offsets, int* edges_by_colour) {
+
+  int* d_nedge_colours;
+  gpu_check(cudaMalloc((void**)&d_nedge_colours, sizeof(int)));
+
+  START_PROFILING(&compute_profile);
+  calc_edge_colours<<<1, 1>>>(
+      nedges, edges_to_nodes, nodes_to_faces_offsets, nodes_to_faces,
+      faces_to_nodes_offsets, faces_to_nodes, face_edges_to_edges,
+      edge_colours, edge_colour_offsets, edges_by_colour, d_nedge_colours);
+  STOP_PROFILING(&compute_profile, __func__);
+
+  int nedge_colours;
+  gpu_check(cudaMemcpy(&nedge_colours, d_nedge_colours, sizeof(int),
+                       cudaMemcpyDeviceToHost));
+  gpu_check(cudaFree(d_nedge_colours));
+  if (nedge_colours == -1) {
+    TERMINATE("Unable to colour the edges with %d colours.",
+              MAX_EDGE_COLOURS);
+  }
+
+  printf("Coloured %d edges with %d colours.\n", nedges, nedge_colours);
+
+  return nedge_colours;
+}
@@ -111,7 +111,7 @@ void predictor(Mesh* mesh, UnstructuredMesh* umesh, HaleData* hale_data) {
   gpu_check(cudaDeviceSynchronize());
   STOP_PROFILING(&compute_profile, "move_nodes");
 
-  init_cell_centroids(umesh->ncells, umesh->cells_to_nodes_offsets,
+  init_cell_centroids(umesh->ncells, NULL, umesh->cells_to_nodes_offsets,
                       umesh->cells_to_nodes, umesh->nodes_x1, umesh->nodes_y1,
                       umesh->nodes_z1, umesh->cell_centroids_x,
                       umesh->cell_centroids_y, umesh->cell_centroids_z);
@@ -262,7 +262,7 @@ void corrector(Mesh* mesh, UnstructuredMesh* umesh, HaleData* hale_data) {
   gpu_check(cudaDeviceSynchronize());
   STOP_PROFILING(&compute_profile, "calc_corrected_energy");
 
-  init_cell_centroids(umesh->ncells, umesh->cells_to_nodes_offsets,
+  init_cell_centroids(umesh->ncells, NULL, umesh->cells_to_nodes_offsets,
                       umesh->cells_to_nodes, umesh->nodes_x0, umesh->nodes_y0,
                       umesh->nodes_z0, umesh->cell_centroids_x,
                       umesh->cell_centroids_y, umesh->cell_centroids_z);
@@ -32,7 +32,7 @@ void eulerian_rezone(UnstructuredMesh* umesh, HaleData* hale_data) {
                       umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0);
 
   // Determine the new cell centroids
-  init_cell_centroids(umesh->ncells, umesh->cells_to_nodes_offsets,
+  init_cell_centroids(umesh->ncells, NULL, umesh->cells_to_nodes_offsets,
                       umesh->cells_to_nodes, umesh->nodes_x0, umesh->nodes_y0,
                       umesh->nodes_z0, umesh->cell_centroids_x,
                       umesh->cell_centroids_y, umesh->cell_centroids_z);
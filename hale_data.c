@@ -38,15 +38,113 @@ size_t init_hale_data(HaleData* hale_data, UnstructuredMesh* umesh) {
   allocated += allocate_data(&hale_data->rezoned_nodes_z, umesh->nnodes);
   allocated += allocate_data(&hale_data->cell_volume, umesh->ncells);
 
+  // The face edges are indexed in the same way as the faces_to_nodes list
+  const int nface_edges = umesh->faces_to_nodes_offsets[(umesh->nfaces)];
+  allocated += allocate_data(&hale_data->face_centroids_x, umesh->nfaces);
+  allocated += allocate_data(&hale_data->face_centroids_y, umesh->nfaces);
+  allocated += allocate_data(&hale_data->face_centroids_z, umesh->nfaces);
+  allocated += allocate_data(&hale_data->face_edge_area_x, nface_edges);
+  allocated += allocate_data(&hale_data->face_edge_area_y, nface_edges);
+  allocated += allocate_data(&hale_data->face_edge_area_z, nface_edges);
+  allocated += allocate_data(&hale_data->face_edge_lengths, nface_edges);
+  allocated += allocate_int_data(&hale_data->face_colours, umesh->nfaces);
+  allocated += allocate_int_data(&hale_data->faces_by_colour, umesh->nfaces);
+  allocated += allocate_int_data(&hale_data->face_colour_offsets,
+                                 MAX_FACE_COLOURS + 1);
+
   allocated +=
       allocate_int_data(&hale_data->subcells_to_subcells,
                         hale_data->nsubcells * nsubcell_faces_by_node * 2);
   allocated += allocate_int_data(&hale_data->subcells_to_subcells_offsets,
                                  hale_data->nsubcells + 1);
+
+  // The sweeps of the advection are only needed by the remap
+  if (hale_data->perform_remap) {
+    const int nsweeps = hale_data->nsubcells * nsubcell_faces_by_node * 2;
+    allocated += allocate_int_data(&hale_data->nodes_active, umesh->nnodes);
+    allocated += allocate_int_data(&hale_data->cells_active, umesh->ncells);
+    allocated +=
+        allocate_int_data(&hale_data->cells_reconstructed, umesh->ncells);
+    allocated += allocate_int_data(&hale_data->cells_nsweeps, umesh->ncells);
+    allocated += allocate_int_data(&hale_data->subcells_to_sweeps, nsweeps);
+    allocated += allocate_int_data(&hale_data->sweep_subcells, nsweeps);
+    allocated += allocate_int_data(&hale_data->sweep_slots, nsweeps);
+    allocated += allocate_int_data(&hale_data->sweep_outflux, nsweeps);
+    allocated += allocate_data(&hale_data->sweep_volumes, nsweeps);
+    allocated += allocate_data(&hale_data->sweep_centroids_x, nsweeps);
+    allocated += allocate_data(&hale_data->sweep_centroids_y, nsweeps);
+    allocated += allocate_data(&hale_data->sweep_centroids_z, nsweeps);
+    allocated += allocate_data(&hale_data->sweep_mass_flux, nsweeps);
+    allocated += allocate_data(&hale_data->sweep_ie_flux, nsweeps);
+    allocated += allocate_data(&hale_data->sweep_ke_flux, nsweeps);
+    allocated += allocate_data(&hale_data->sweep_momentum_flux_x, nsweeps);
+    allocated += allocate_data(&hale_data->sweep_momentum_flux_y, nsweeps);
+    allocated += allocate_data(&hale_data->sweep_momentum_flux_z, nsweeps);
+
+    // The limited gradients of each subcell, shared by all of its sweeps, are
+    // only reconstructed by the second order remap
+    const int nsubcells = hale_data->nsubcells;
+    if (hale_data->remap_order == 2) {
+      allocated += allocate_data(&hale_data->subcell_grad_m_x, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_m_y, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_m_z, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_ie_x, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_ie_y, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_ie_z, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_ke_x, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_ke_y, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_ke_z, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_vx_x, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_vx_y, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_vx_z, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_vy_x, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_vy_y, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_vy_z, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_vz_x, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_vz_y, nsubcells);
+      allocated += allocate_data(&hale_data->subcell_grad_vz_z, nsubcells);
+    }
+
+    // The geometry of the rezoned mesh, cached between remaps
+    allocated +=
+        allocate_data(&hale_data->rezoned_cell_centroids_x, umesh->ncells);
+    allocated +=
+        allocate_data(&hale_data->rezoned_cell_centroids_y, umesh->ncells);
+    allocated +=
+        allocate_data(&hale_data->rezoned_cell_centroids_z, umesh->ncells);
+    allocated +=
+        allocate_data(&hale_data->rezoned_face_centroids_x, umesh->nfaces);
+    allocated +=
+        allocate_data(&hale_data->rezoned_face_centroids_y, umesh->nfaces);
+    allocated +=
+        allocate_data(&hale_data->rezoned_face_centroids_z, umesh->nfaces);
+    allocated +=
+        allocate_data(&hale_data->rezoned_face_edge_area_x, nface_edges);
+    allocated +=
+        allocate_data(&hale_data->rezoned_face_edge_area_y, nface_edges);
+    allocated +=
+        allocate_data(&hale_data->rezoned_face_edge_area_z, nface_edges);
+    allocated +=
+        allocate_data(&hale_data->rezoned_face_edge_lengths, nface_edges);
+    allocated += allocate_data(&hale_data->rezoned_subcell_volume, nsubcells);
+    allocated +=
+        allocate_data(&hale_data->rezoned_subcell_centroids_x, nsubcells);
+    allocated +=
+        allocate_data(&hale_data->rezoned_subcell_centroids_y, nsubcells);
+    allocated +=
+        allocate_data(&hale_data->rezoned_subcell_centroids_z, nsubcells);
+  }
   allocated += allocate_int_data(&hale_data->subcells_to_faces,
                                  hale_data->nsubcells * nsubcell_faces_by_node);
   allocated += allocate_int_data(&hale_data->subcells_to_faces_offsets,
                                  hale_data->nsubcells + 1);
+  allocated += allocate_int_data(
+      &hale_data->nodes_to_subcells,
+      umesh->nodes_to_cells_offsets[(umesh->nnodes)]);
+  allocated +=
+      allocate_int_data(&hale_data->faces_nodes_to_subcells0, nface_edges);
+  allocated +=
+      allocate_int_data(&hale_data->faces_nodes_to_subcells1, nface_edges);
 
   allocated +=
       allocate_data(&hale_data->subcell_momentum_x, hale_data->nsubcells);
@@ -84,7 +182,7 @@ size_t init_hale_data(HaleData* hale_data, UnstructuredMesh* umesh) {
   // In hale, the fundamental principle is that the mass at the cell and
   // sub-cell are conserved, so we can initialise them from the mesh
   // and then only the remapping step will ever adjust them
-  init_cell_centroids(umesh->ncells, umesh->cells_to_nodes_offsets,
+  init_cell_centroids(umesh->ncells, NULL, umesh->cells_to_nodes_offsets,
                       umesh->cells_to_nodes, umesh->nodes_x0, umesh->nodes_y0,
                       umesh->nodes_z0, umesh->cell_centroids_x,
                       umesh->cell_centroids_y, umesh->cell_centroids_z);
@@ -110,6 +208,154 @@ size_t init_hale_data(HaleData* hale_data, UnstructuredMesh* umesh) {
       umesh->cells_to_nodes, hale_data->subcells_to_faces,
       hale_data->subcells_to_faces_offsets);
 
+  // Resolves the orientation of the subcell faces once for the advection
+  if (hale_data->perform_remap) {
+    const int nsubcell_faces =
+        hale_data->subcells_to_faces_offsets[(hale_data->nsubcells)];
+    const int nsubcell_neighbours =
+        hale_data->subcells_to_subcells_offsets[(hale_data->nsubcells)];
+    allocated +=
+        allocate_int_data(&hale_data->subcell_face_rnodes, nsubcell_faces);
+    allocated +=
+        allocate_int_data(&hale_data->subcell_face_lnodes, nsubcell_faces);
+    allocated +=
+        allocate_int_data(&hale_data->subcell_face_r_faces, nsubcell_faces);
+    allocated +=
+        allocate_int_data(&hale_data->subcell_face_l_faces, nsubcell_faces);
+    allocated += allocate_int_data(&hale_data->subcell_face_r_face_rnodes,
+                                   nsubcell_faces);
+    allocated += allocate_int_data(&hale_data->subcell_neighbour_slots,
+                                   nsubcell_neighbours);
+    init_subcell_face_orientations(
+        umesh->ncells, umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
+        umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+        umesh->faces_cclockwise_cell, hale_data->subcells_to_faces_offsets,
+        hale_data->subcells_to_faces, hale_data->subcells_to_subcells_offsets,
+        hale_data->subcells_to_subcells, hale_data->subcell_face_rnodes,
+        hale_data->subcell_face_lnodes, hale_data->subcell_face_r_faces,
+        hale_data->subcell_face_l_faces, hale_data->subcell_face_r_face_rnodes,
+        hale_data->subcell_neighbour_slots);
+  }
+
+  // Initialises the list of subcells attached to each node
+  init_nodes_to_subcells(umesh->nnodes, umesh->nodes_to_cells_offsets,
+                         umesh->nodes_to_cells, umesh->cells_to_nodes_offsets,
+                         umesh->cells_to_nodes, hale_data->nodes_to_subcells);
+
+  // Initialises the list of subcells attached to each face node
+  init_faces_nodes_to_subcells(
+      umesh->nfaces, umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+      umesh->faces_to_cells0, umesh->faces_to_cells1,
+      umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
+      hale_data->faces_nodes_to_subcells0, hale_data->faces_nodes_to_subcells1);
+
+  // Hexahedral meshes can use the fixed size kernels
+  hale_data->hex_mesh = is_hex_mesh(
+      umesh->ncells, umesh->nfaces, umesh->cells_to_nodes_offsets,
+      umesh->cells_to_faces_offsets, umesh->faces_to_nodes_offsets);
+
+  // Initialises the unique edges of the mesh, and colours them for the edge
+  // centric kernels
+  hale_data->nedges = 0;
+  hale_data->nedge_colours = 0;
+  hale_data->edge_colour_offsets = NULL;
+  hale_data->edges_by_colour = NULL;
+  if (hale_data->edge_centric_viscosity) {
+    allocated +=
+        allocate_int_data(&hale_data->face_edges_to_edges, nface_edges);
+    hale_data->nedges = init_face_edges_to_edges(
+        umesh->nfaces, umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+        umesh->nodes_to_faces_offsets, umesh->nodes_to_faces,
+        hale_data->face_edges_to_edges);
+    allocated += allocate_int_data(&hale_data->edges_to_nodes,
+                                   hale_data->nedges * 2);
+    allocated += allocate_int_data(&hale_data->edges_to_faces_offsets,
+                                   hale_data->nedges + 1);
+    allocated += allocate_int_data(&hale_data->edges_to_faces, nface_edges);
+    allocated +=
+        allocate_int_data(&hale_data->edges_to_face_edges, nface_edges);
+    allocated +=
+        allocate_int_data(&hale_data->edge_colours, hale_data->nedges);
+    allocated +=
+        allocate_int_data(&hale_data->edges_by_colour, hale_data->nedges);
+    allocated += allocate_int_data(&hale_data->edge_colour_offsets,
+                                   MAX_EDGE_COLOURS + 1);
+    init_edges(umesh->nfaces, hale_data->nedges,
+               umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+               hale_data->face_edges_to_edges, hale_data->edges_to_nodes,
+               hale_data->edges_to_faces_offsets, hale_data->edges_to_faces,
+               hale_data->edges_to_face_edges);
+    hale_data->nedge_colours = init_edge_colours(
+        hale_data->nedges, hale_data->edges_to_nodes,
+        umesh->nodes_to_faces_offsets, umesh->nodes_to_faces,
+        umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+        hale_data->face_edges_to_edges, hale_data->edge_colours,
+        hale_data->edge_colour_offsets, hale_data->edges_by_colour);
+  }
+
+  // Colours the faces for the face centric kernels
+  hale_data->nface_colours = init_face_colours(
+      umesh->nfaces, umesh->faces_to_cells0, umesh->faces_to_cells1,
+      umesh->cells_to_faces_offsets, umesh->cells_to_faces,
+      hale_data->face_colours, hale_data->face_colour_offsets,
+      hale_data->faces_by_colour);
+
+  // The Lagrangian kernels run over the whole mesh unless a frontier is kept
+  hale_data->cells_frontier = NULL;
+  hale_data->nodes_frontier = NULL;
+  hale_data->nfrontier_cells = umesh->ncells;
+  hale_data->frontier_cells = NULL;
+  hale_data->nfrontier_nodes = umesh->nnodes;
+  hale_data->frontier_nodes = NULL;
+  hale_data->nfrontier_halo_nodes = 0;
+  hale_data->frontier_edge_colour_offsets = hale_data->edge_colour_offsets;
+  hale_data->frontier_edges_by_colour = hale_data->edges_by_colour;
+  if (hale_data->frontier) {
+    allocated += allocate_int_data(&hale_data->cells_frontier, umesh->ncells);
+    allocated += allocate_int_data(&hale_data->nodes_frontier, umesh->nnodes);
+    allocated += allocate_int_data(&hale_data->frontier_cells, umesh->ncells);
+    allocated += allocate_int_data(&hale_data->frontier_nodes, umesh->nnodes);
+    allocated +=
+        allocate_int_data(&hale_data->frontier_halo_nodes, umesh->nnodes);
+
+    // The lists cover the whole mesh until the frontier is first seeded
+    for (int cc = 0; cc < umesh->ncells; ++cc) {
+      hale_data->cells_frontier[(cc)] = 1;
+      hale_data->frontier_cells[(cc)] = cc;
+    }
+    for (int nn = 0; nn < umesh->nnodes; ++nn) {
+      hale_data->nodes_frontier[(nn)] = 1;
+      hale_data->frontier_nodes[(nn)] = nn;
+    }
+
+    if (hale_data->edge_centric_viscosity) {
+      allocated += allocate_int_data(&hale_data->frontier_edge_colour_offsets,
+                                     MAX_EDGE_COLOURS + 1);
+      allocated += allocate_int_data(&hale_data->frontier_edges_by_colour,
+                                     hale_data->nedges);
+      for (int colour = 0; colour < hale_data->nedge_colours + 1; ++colour) {
+        hale_data->frontier_edge_colour_offsets[(colour)] =
+            hale_data->edge_colour_offsets[(colour)];
+      }
+      for (int ee = 0; ee < hale_data->nedges; ++ee) {
+        hale_data->frontier_edges_by_colour[(ee)] =
+            hale_data->edges_by_colour[(ee)];
+      }
+    }
+
+    // The start of step state that the dense kernels repeat the step from
+    if (hale_data->frontier_verify) {
+      allocated += allocate_data(&hale_data->verify_nodes_x, umesh->nnodes);
+      allocated += allocate_data(&hale_data->verify_nodes_y, umesh->nnodes);
+      allocated += allocate_data(&hale_data->verify_nodes_z, umesh->nnodes);
+      allocated += allocate_data(&hale_data->verify_velocity_x, umesh->nnodes);
+      allocated += allocate_data(&hale_data->verify_velocity_y, umesh->nnodes);
+      allocated += allocate_data(&hale_data->verify_velocity_z, umesh->nnodes);
+      allocated += allocate_data(&hale_data->verify_energy, umesh->ncells);
+      allocated += allocate_data(&hale_data->verify_density, umesh->ncells);
+    }
+  }
+
   // Initialises the cell mass, sub-cell mass and sub-cell volume
   init_mesh_mass(umesh->ncells, umesh->nnodes, hale_data->nnodes_by_subcell,
                  hale_data->density0, umesh->nodes_x0, umesh->nodes_y0,
@@ -119,14 +365,16 @@ size_t init_hale_data(HaleData* hale_data, UnstructuredMesh* umesh) {
                  umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
                  hale_data->subcells_to_faces_offsets,
                  hale_data->subcells_to_faces, umesh->nodes_to_cells_offsets,
-                 umesh->nodes_to_cells, hale_data->subcell_centroids_x,
-                 hale_data->subcell_centroids_y, hale_data->subcell_centroids_z,
-                 hale_data->subcell_volume, hale_data->cell_volume,
-                 hale_data->nodal_volumes, hale_data->cell_mass);
+                 umesh->nodes_to_cells, hale_data->nodes_to_subcells,
+                 hale_data->subcell_centroids_x, hale_data->subcell_centroids_y,
+                 hale_data->subcell_centroids_z, hale_data->subcell_volume,
+                 hale_data->cell_volume, hale_data->nodal_volumes,
+                 hale_data->cell_mass);
 
   store_rezoned_mesh(umesh->nnodes, umesh->nodes_x0, umesh->nodes_y0,
                      umesh->nodes_z0, hale_data->rezoned_nodes_x,
                      hale_data->rezoned_nodes_y, hale_data->rezoned_nodes_z);
+  hale_data->rezoned_geometry_valid = 0;
 
   return allocated;
 }
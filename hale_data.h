@@ -22,6 +22,24 @@
 #define NSUBCELL_FACES_BY_NODE 3
 #define NNODES_BY_SUBCELL 8
 #define NSUBCELLS_BY_CELL 8
+#define MAX_FACE_COLOURS 32
+#define MAX_EDGE_COLOURS 32
+#define NNODES_BY_HEX_CELL 8
+#define NFACES_BY_HEX_CELL 6
+#define NNODES_BY_HEX_FACE 4
+#define NNODES_BY_PRISM 8
+#define NFACES_BY_PRISM 6
+#define NPRISMS_BY_BATCH 48
+#define ACTIVE_NODE_TOL EPS
+#define FRONTIER_TOL 1.0e-12
+#define FRONTIER_LAYERS 3
+#define FRONTIER_VERIFY_TOL 1.0e-10
+#define NSOLVES_BY_BATCH 8
+#define NSYM_3X3_ENTRIES 6
+#define NGRADIENTS_BY_SUBCELL 6
+#define NFIELDS_BY_LIMITER 8
+#define LSQ_SINGULAR_TOL EPS
+#define LSQ_REGULARISATION 1.0e-8
 
 enum { XYZ, YZX, ZXY };
 
@@ -31,6 +49,12 @@ typedef struct {
   double z;
 } vec_t;
 
+// The time allowed by a timestep constraint, and the cell imposing it
+typedef struct {
+  double time;
+  int cell;
+} time_limit_t;
+
 typedef struct {
   double* energy0;
   double* energy1;
@@ -81,6 +105,32 @@ typedef struct {
   double* rezoned_nodes_y;
   double* rezoned_nodes_z;
 
+  // Geometry of the rezoned mesh, cached until a rezoner changes the rezoned
+  // nodes and clears rezoned_geometry_valid
+  double* rezoned_cell_centroids_x;
+  double* rezoned_cell_centroids_y;
+  double* rezoned_cell_centroids_z;
+  double* rezoned_face_centroids_x;
+  double* rezoned_face_centroids_y;
+  double* rezoned_face_centroids_z;
+  double* rezoned_face_edge_area_x;
+  double* rezoned_face_edge_area_y;
+  double* rezoned_face_edge_area_z;
+  double* rezoned_face_edge_lengths;
+  double* rezoned_subcell_volume;
+  double* rezoned_subcell_centroids_x;
+  double* rezoned_subcell_centroids_y;
+  double* rezoned_subcell_centroids_z;
+
+  // Face geometry for the current mesh state, shared by the Lagrangian kernels
+  double* face_centroids_x;
+  double* face_centroids_y;
+  double* face_centroids_z;
+  double* face_edge_area_x;
+  double* face_edge_area_y;
+  double* face_edge_area_z;
+  double* face_edge_lengths;
+
   int nsubcells;
   int nsubcell_nodes;
   int nsubcells_by_cell;
@@ -89,8 +139,131 @@ typedef struct {
   double visc_coeff1;
   double visc_coeff2;
 
+  // Bounds on the timestep, where zero leaves them unbounded
+  double max_dt_growth;
+  double max_volume_change;
+
   int perform_remap;
+  int rezoned_geometry_valid;
   int visit_dump;
+  int face_centric_forces;
+  int fused_predictor;
+  int fused_corrector;
+  int edge_centric_viscosity;
+  int predictor_timestep;
+  int frontier;
+  int frontier_verify;
+  int remap_order;
+
+  // Set when every cell is a hexahedron, selecting the fixed size kernels
+  int hex_mesh;
+
+  // Faces grouped so that no two faces of a colour share a cell
+  int nface_colours;
+  int* face_colours;
+  int* face_colour_offsets;
+  int* faces_by_colour;
+
+  // The unique edges of the mesh, with the faces holding each edge and the
+  // matching face edge, indexed like faces_to_nodes, of each face
+  int nedges;
+  int* edges_to_nodes;
+  int* edges_to_faces_offsets;
+  int* edges_to_faces;
+  int* edges_to_face_edges;
+  int* face_edges_to_edges;
+
+  // Edges grouped so that no two edges of a colour share a node
+  int nedge_colours;
+  int* edge_colours;
+  int* edge_colour_offsets;
+  int* edges_by_colour;
+
+  // The cells within FRONTIER_LAYERS of any motion or pressure jump, and the
+  // nodes whose cells are all in the frontier. The Lagrangian cell and node
+  // kernels run over these lists, which are NULL when the frontier is off
+  int* cells_frontier;
+  int* nodes_frontier;
+  int nfrontier_cells;
+  int* frontier_cells;
+  int nfrontier_nodes;
+  int* frontier_nodes;
+
+  // The frontier nodes next to a node outside the frontier, which must stay
+  // at rest for the frontier to be wide enough
+  int nfrontier_halo_nodes;
+  int* frontier_halo_nodes;
+
+  // The edges on a face of a frontier cell, grouped by colour, which the edge
+  // centric viscosity runs over. These are the edge colours when the frontier
+  // is off
+  int* frontier_edge_colour_offsets;
+  int* frontier_edges_by_colour;
+
+  // The state at the start of the step, kept when verifying the frontier so
+  // that the step can be repeated by the dense kernels
+  double verify_dt;
+  double* verify_nodes_x;
+  double* verify_nodes_y;
+  double* verify_nodes_z;
+  double* verify_velocity_x;
+  double* verify_velocity_y;
+  double* verify_velocity_z;
+  double* verify_energy;
+  double* verify_density;
+
+  // The nodes displaced from the rezoned mesh by more than ACTIVE_NODE_TOL,
+  // and the cells with any such node. Only the faces of active cells sweep a
+  // region, so the remap skips the quiescent parts of the mesh
+  int* nodes_active;
+  int* cells_active;
+
+  // The cells within two faces of an active cell, whose subcells the
+  // advection reconstructs from, so the gather only fits gradients in them
+  int* cells_reconstructed;
+
+  // The non-empty swept edge regions of the subcell faces, found by the
+  // geometric stage of the advection for the flux stage. Each face is swept
+  // once, by the lower indexed of its two subcells, and the sweeps of each
+  // cell are packed from its first subcells_to_subcells slot
+  int* cells_nsweeps;
+  int* subcells_to_sweeps;
+  int* sweep_subcells;
+  int* sweep_slots;
+  int* sweep_outflux;
+  double* sweep_volumes;
+  double* sweep_centroids_x;
+  double* sweep_centroids_y;
+  double* sweep_centroids_z;
+
+  // The fluxes through each sweep, out of the subcell that owns the sweep
+  double* sweep_mass_flux;
+  double* sweep_ie_flux;
+  double* sweep_ke_flux;
+  double* sweep_momentum_flux_x;
+  double* sweep_momentum_flux_y;
+  double* sweep_momentum_flux_z;
+
+  // The limited gradients of mass, internal energy, kinetic energy and
+  // velocity in each subcell, calculated once per remap for the flux stage
+  double* subcell_grad_m_x;
+  double* subcell_grad_m_y;
+  double* subcell_grad_m_z;
+  double* subcell_grad_ie_x;
+  double* subcell_grad_ie_y;
+  double* subcell_grad_ie_z;
+  double* subcell_grad_ke_x;
+  double* subcell_grad_ke_y;
+  double* subcell_grad_ke_z;
+  double* subcell_grad_vx_x;
+  double* subcell_grad_vx_y;
+  double* subcell_grad_vx_z;
+  double* subcell_grad_vy_x;
+  double* subcell_grad_vy_y;
+  double* subcell_grad_vy_z;
+  double* subcell_grad_vz_x;
+  double* subcell_grad_vz_y;
+  double* subcell_grad_vz_z;
 
   int* subcells_to_nodes;
   int* subcells_to_subcells_offsets;
@@ -98,6 +271,25 @@ typedef struct {
   int* subcells_to_faces;
   int* subcells_to_faces_offsets;
 
+  // The orientation of each subcell face about the subcell's node, indexed as
+  // subcells_to_faces, and the slot of each subcell neighbour that refers back
+  // to the subcell, indexed as subcells_to_subcells. The connectivity is fixed
+  // so these are resolved once for the advection
+  int* subcell_face_rnodes;
+  int* subcell_face_lnodes;
+  int* subcell_face_r_faces;
+  int* subcell_face_l_faces;
+  int* subcell_face_r_face_rnodes;
+  int* subcell_neighbour_slots;
+
+  // The subcell of each node in each cell, using the nodes_to_cells offsets
+  int* nodes_to_subcells;
+
+  // The subcell of each face node in faces_to_cells0 and faces_to_cells1,
+  // using the faces_to_nodes offsets
+  int* faces_nodes_to_subcells0;
+  int* faces_nodes_to_subcells1;
+
   // Only intended for testing purposes
   double* subcell_nodes_x;
   double* subcell_nodes_y;
@@ -125,17 +317,17 @@ void init_mesh_mass(const int ncells, const int nnodes,
                     int* cells_offsets, int* cells_to_nodes,
                     int* subcells_to_faces_offsets, int* subcells_to_faces,
                     int* nodes_offsets, int* nodes_to_cells,
-                    double* subcell_centroids_x, double* subcell_centroids_y,
-                    double* subcell_centroids_z, double* subcell_volume,
-                    double* cell_volume, double* nodal_volumes,
-                    double* cell_mass);
+                    int* nodes_to_subcells, double* subcell_centroids_x,
+                    double* subcell_centroids_y, double* subcell_centroids_z,
+                    double* subcell_volume, double* cell_volume,
+                    double* nodal_volumes, double* cell_mass);
 
 // Initialises the centroids for each cell
-void init_cell_centroids(const int ncells, const int* cells_offsets,
-                         const int* cells_to_nodes, const double* nodes_x0,
-                         const double* nodes_y0, const double* nodes_z0,
-                         double* cell_centroids_x, double* cell_centroids_y,
-                         double* cell_centroids_z);
+void init_cell_centroids(const int ncells, const int* cell_list,
+                         const int* cells_offsets, const int* cells_to_nodes,
+                         const double* nodes_x0, const double* nodes_y0,
+                         const double* nodes_z0, double* cell_centroids_x,
+                         double* cell_centroids_y, double* cell_centroids_z);
 
 // Initialises the list of neighbours to a subcell
 void init_subcells_to_subcells(
@@ -148,6 +340,18 @@ void init_subcells_to_subcells(
     int* cells_to_nodes, int* subcells_to_faces,
     int* subcells_to_faces_offsets);
 
+// Initialises the orientation of each subcell face about the subcell's node,
+// and the slot of each subcell neighbour that refers back to the subcell
+void init_subcell_face_orientations(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* cells_to_nodes, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_cclockwise_cell,
+    const int* subcells_to_faces_offsets, const int* subcells_to_faces,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    int* subcell_face_rnodes, int* subcell_face_lnodes,
+    int* subcell_face_r_faces, int* subcell_face_l_faces,
+    int* subcell_face_r_face_rnodes, int* subcell_neighbour_slots);
+
 void init_subcells_to_faces(
     const int ncells, const int nsubcells, const int* cells_offsets,
     const int* nodes_to_faces_offsets, const int* cells_to_nodes,
@@ -157,6 +361,59 @@ void init_subcells_to_faces(
     int* subcells_to_faces, const double* nodes_x, const double* nodes_y,
     const double* nodes_z, int* subcells_to_faces_offsets);
 
+// Initialises the list of subcells attached to each node
+void init_nodes_to_subcells(const int nnodes, const int* nodes_to_cells_offsets,
+                            const int* nodes_to_cells,
+                            const int* cells_to_nodes_offsets,
+                            const int* cells_to_nodes, int* nodes_to_subcells);
+
+// Initialises the subcells of each face node, for both of the face's cells
+void init_faces_nodes_to_subcells(
+    const int nfaces, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_to_cells1, const int* cells_to_nodes_offsets,
+    const int* cells_to_nodes, int* faces_nodes_to_subcells0,
+    int* faces_nodes_to_subcells1);
+
+// Determines whether every cell in the mesh is a hexahedron
+int is_hex_mesh(const int ncells, const int nfaces,
+                const int* cells_to_nodes_offsets,
+                const int* cells_to_faces_offsets,
+                const int* faces_to_nodes_offsets);
+
+// Colours the faces so that no two faces of the same colour share a cell
+int init_face_colours(const int nfaces, const int* faces_to_cells0,
+                      const int* faces_to_cells1,
+                      const int* cells_to_faces_offsets,
+                      const int* cells_to_faces, int* face_colours,
+                      int* face_colour_offsets, int* faces_by_colour);
+
+// Determines the unique edges of the mesh, numbering the edge of each face
+// edge, and returns the number of edges
+int init_face_edges_to_edges(const int nfaces,
+                             const int* faces_to_nodes_offsets,
+                             const int* faces_to_nodes,
+                             const int* nodes_to_faces_offsets,
+                             const int* nodes_to_faces,
+                             int* face_edges_to_edges);
+
+// Initialises the nodes of each edge and the faces holding it, with the face
+// edge of each face
+void init_edges(const int nfaces, const int nedges,
+                const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+                const int* face_edges_to_edges, int* edges_to_nodes,
+                int* edges_to_faces_offsets, int* edges_to_faces,
+                int* edges_to_face_edges);
+
+// Colours the edges so that no two edges of the same colour share a node
+int init_edge_colours(const int nedges, const int* edges_to_nodes,
+                      const int* nodes_to_faces_offsets,
+                      const int* nodes_to_faces,
+                      const int* faces_to_nodes_offsets,
+                      const int* faces_to_nodes,
+                      const int* face_edges_to_edges, int* edge_colours,
+                      int* edge_colour_offsets, int* edges_by_colour);
+
 // Stores the rezoned grid specification, in case we aren't going to use a
 // rezoning strategy and want to perform an Eulerian remap
 void store_rezoned_mesh(const int nnodes, const double* nodes_x,
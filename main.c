@@ -67,8 +67,30 @@ int main(int argc, char** argv) {
   // Initialise the hale-specific data arrays
   hale_data.visc_coeff1 = get_double_parameter("visc_coeff1", hale_params);
   hale_data.visc_coeff2 = get_double_parameter("visc_coeff2", hale_params);
+  hale_data.max_dt_growth =
+      get_double_parameter("max_dt_growth", hale_params);
+  hale_data.max_volume_change =
+      get_double_parameter("max_volume_change", hale_params);
   hale_data.perform_remap = get_int_parameter("perform_remap", hale_params);
   hale_data.visit_dump = get_int_parameter("visit_dump", hale_params);
+  hale_data.face_centric_forces =
+      get_int_parameter("face_centric_forces", hale_params);
+  hale_data.fused_predictor =
+      get_int_parameter("fused_predictor", hale_params);
+  hale_data.fused_corrector =
+      get_int_parameter("fused_corrector", hale_params);
+  hale_data.edge_centric_viscosity =
+      get_int_parameter("edge_centric_viscosity", hale_params);
+  hale_data.predictor_timestep =
+      get_int_parameter("predictor_timestep", hale_params);
+  hale_data.frontier = get_int_parameter("frontier", hale_params);
+  hale_data.frontier_verify =
+      get_int_parameter("frontier_verify", hale_params);
+  hale_data.remap_order = get_int_parameter("remap_order", hale_params);
+  if (hale_data.remap_order != 1 && hale_data.remap_order != 2) {
+    TERMINATE("The remap_order must be 1 or 2, not %d.\n",
+              hale_data.remap_order);
+  }
   allocated += init_hale_data(&hale_data, &umesh);
 
   printf("Initialisation time %.4lfs\n", omp_get_wtime() - i0);
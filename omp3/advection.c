@@ -7,44 +7,190 @@
 // Performs a remap and some scattering of the subcell values
 void advection_phase(UnstructuredMesh* umesh, HaleData* hale_data) {
 
-  // Advects mass and energy through the subcell faces using swept edge approx
-  perform_advection(
-      umesh->ncells, umesh->cells_to_nodes_offsets, umesh->nodes_x0,
-      umesh->nodes_y0, umesh->nodes_z0, hale_data->rezoned_nodes_x,
-      hale_data->rezoned_nodes_y, hale_data->rezoned_nodes_z,
-      umesh->cells_to_nodes, umesh->faces_to_nodes_offsets,
-      umesh->faces_to_nodes, umesh->faces_cclockwise_cell,
+  // The rezoned geometry is only calculated when the rezoned mesh changes,
+  // and the active cells were flagged by the gather
+  update_rezoned_geometry(umesh, hale_data);
+
+  // Determines the swept edge regions of all subcell faces
+  START_PROFILING(&compute_profile);
+  calc_sweep_geometry(
+      umesh->ncells, umesh->cells_to_nodes_offsets, hale_data->cells_active,
+      umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0,
+      hale_data->rezoned_nodes_x, hale_data->rezoned_nodes_y,
+      hale_data->rezoned_nodes_z, hale_data->rezoned_cell_centroids_x,
+      hale_data->rezoned_cell_centroids_y, hale_data->rezoned_cell_centroids_z,
+      hale_data->rezoned_face_centroids_x, hale_data->rezoned_face_centroids_y,
+      hale_data->rezoned_face_centroids_z, umesh->cells_to_nodes,
+      umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
       hale_data->subcells_to_faces_offsets, hale_data->subcells_to_faces,
       hale_data->subcells_to_subcells_offsets, hale_data->subcells_to_subcells,
-      hale_data->subcell_centroids_x, hale_data->subcell_centroids_y,
-      hale_data->subcell_centroids_z, umesh->faces_to_cells0,
-      umesh->faces_to_cells1, hale_data->subcell_volume,
+      hale_data->subcell_face_rnodes, hale_data->subcell_face_lnodes,
+      hale_data->subcell_face_r_faces, hale_data->subcell_face_l_faces,
+      hale_data->subcell_face_r_face_rnodes, hale_data->subcell_centroids_x,
+      hale_data->subcell_centroids_y, hale_data->subcell_centroids_z,
+      hale_data->cells_nsweeps, hale_data->subcells_to_sweeps,
+      hale_data->sweep_subcells, hale_data->sweep_slots,
+      hale_data->sweep_outflux, hale_data->sweep_volumes,
+      hale_data->sweep_centroids_x, hale_data->sweep_centroids_y,
+      hale_data->sweep_centroids_z);
+  STOP_PROFILING(&compute_profile, "calc_sweep_geometry");
+
+  // The first order remap has no reconstruction, so has no gradients
+  if (hale_data->remap_order == 2) {
+    // Calculates the limited gradients of each subcell once for all its sweeps
+    START_PROFILING(&compute_profile);
+    calc_subcell_gradients(
+        umesh->ncells, umesh->cells_to_nodes_offsets, umesh->nodes_x0,
+        umesh->nodes_y0, umesh->nodes_z0, umesh->cells_to_nodes,
+        umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+        umesh->cells_to_faces_offsets, umesh->cells_to_faces,
+        umesh->faces_to_cells0, umesh->faces_to_cells1,
+        hale_data->subcells_to_faces_offsets, hale_data->subcells_to_faces,
+        hale_data->subcells_to_subcells_offsets,
+        hale_data->subcells_to_subcells, hale_data->subcell_face_rnodes,
+        hale_data->cells_active,
+        hale_data->cells_nsweeps, hale_data->sweep_subcells,
+        hale_data->sweep_slots, hale_data->sweep_outflux,
+        hale_data->subcell_centroids_x, hale_data->subcell_centroids_y,
+        hale_data->subcell_centroids_z, hale_data->subcell_volume,
+        hale_data->subcell_mass, hale_data->subcell_ie_mass,
+        hale_data->subcell_ke_mass, hale_data->subcell_momentum_x,
+        hale_data->subcell_momentum_y, hale_data->subcell_momentum_z,
+        hale_data->subcell_grad_m_x, hale_data->subcell_grad_m_y,
+        hale_data->subcell_grad_m_z, hale_data->subcell_grad_ie_x,
+        hale_data->subcell_grad_ie_y, hale_data->subcell_grad_ie_z,
+        hale_data->subcell_grad_ke_x, hale_data->subcell_grad_ke_y,
+        hale_data->subcell_grad_ke_z, hale_data->subcell_grad_vx_x,
+        hale_data->subcell_grad_vx_y, hale_data->subcell_grad_vx_z,
+        hale_data->subcell_grad_vy_x, hale_data->subcell_grad_vy_y,
+        hale_data->subcell_grad_vy_z, hale_data->subcell_grad_vz_x,
+        hale_data->subcell_grad_vz_y, hale_data->subcell_grad_vz_z);
+    STOP_PROFILING(&compute_profile, "calc_subcell_gradients");
+  }
+
+  // The first order remap fluxes the donor subcell's mean densities
+  if (hale_data->remap_order == 1) {
+    START_PROFILING(&compute_profile);
+    calc_donor_sweep_fluxes(
+        umesh->ncells, umesh->cells_to_nodes_offsets,
+        hale_data->subcells_to_subcells_offsets,
+        hale_data->subcells_to_subcells, hale_data->cells_nsweeps,
+        hale_data->sweep_subcells, hale_data->sweep_slots,
+        hale_data->sweep_outflux, hale_data->sweep_volumes,
+        hale_data->subcell_volume, hale_data->subcell_momentum_x,
+        hale_data->subcell_momentum_y, hale_data->subcell_momentum_z,
+        hale_data->subcell_mass, hale_data->subcell_ie_mass,
+        hale_data->subcell_ke_mass, hale_data->sweep_mass_flux,
+        hale_data->sweep_ie_flux, hale_data->sweep_ke_flux,
+        hale_data->sweep_momentum_flux_x, hale_data->sweep_momentum_flux_y,
+        hale_data->sweep_momentum_flux_z);
+    STOP_PROFILING(&compute_profile, "calc_donor_sweep_fluxes");
+  } else {
+    // Calculates the flux through each of the non-empty sweeps
+    START_PROFILING(&compute_profile);
+    calc_sweep_fluxes(
+        umesh->ncells, umesh->cells_to_nodes_offsets,
+        hale_data->subcells_to_subcells_offsets,
+        hale_data->subcells_to_subcells, hale_data->subcell_centroids_x,
+        hale_data->subcell_centroids_y, hale_data->subcell_centroids_z,
+        hale_data->cells_nsweeps, hale_data->sweep_subcells,
+        hale_data->sweep_slots, hale_data->sweep_outflux,
+        hale_data->sweep_volumes, hale_data->sweep_centroids_x,
+        hale_data->sweep_centroids_y, hale_data->sweep_centroids_z,
+        hale_data->subcell_volume, hale_data->subcell_momentum_x,
+        hale_data->subcell_momentum_y, hale_data->subcell_momentum_z,
+        hale_data->subcell_mass, hale_data->subcell_ie_mass,
+        hale_data->subcell_ke_mass, hale_data->subcell_grad_m_x,
+        hale_data->subcell_grad_m_y, hale_data->subcell_grad_m_z,
+        hale_data->subcell_grad_ie_x, hale_data->subcell_grad_ie_y,
+        hale_data->subcell_grad_ie_z, hale_data->subcell_grad_ke_x,
+        hale_data->subcell_grad_ke_y, hale_data->subcell_grad_ke_z,
+        hale_data->subcell_grad_vx_x, hale_data->subcell_grad_vx_y,
+        hale_data->subcell_grad_vx_z, hale_data->subcell_grad_vy_x,
+        hale_data->subcell_grad_vy_y, hale_data->subcell_grad_vy_z,
+        hale_data->subcell_grad_vz_x, hale_data->subcell_grad_vz_y,
+        hale_data->subcell_grad_vz_z, hale_data->sweep_mass_flux,
+        hale_data->sweep_ie_flux, hale_data->sweep_ke_flux,
+        hale_data->sweep_momentum_flux_x, hale_data->sweep_momentum_flux_y,
+        hale_data->sweep_momentum_flux_z);
+    STOP_PROFILING(&compute_profile, "calc_sweep_fluxes");
+  }
+
+  // Advects mass, energy and momentum between the subcells sharing each face
+  START_PROFILING(&compute_profile);
+  accumulate_subcell_fluxes(
+      umesh->ncells, umesh->cells_to_nodes_offsets,
+      hale_data->subcells_to_subcells_offsets, hale_data->subcells_to_subcells,
+      hale_data->subcell_neighbour_slots, hale_data->cells_active,
+      hale_data->subcells_to_sweeps, hale_data->sweep_mass_flux,
+      hale_data->sweep_ie_flux, hale_data->sweep_ke_flux,
+      hale_data->sweep_momentum_flux_x, hale_data->sweep_momentum_flux_y,
+      hale_data->sweep_momentum_flux_z, hale_data->subcell_mass_flux,
+      hale_data->subcell_ie_mass_flux, hale_data->subcell_ke_mass_flux,
       hale_data->subcell_momentum_flux_x, hale_data->subcell_momentum_flux_y,
-      hale_data->subcell_momentum_flux_z, hale_data->subcell_momentum_x,
-      hale_data->subcell_momentum_y, hale_data->subcell_momentum_z,
-      hale_data->subcell_mass, hale_data->subcell_mass_flux,
-      hale_data->subcell_ie_mass, hale_data->subcell_ie_mass_flux,
-      hale_data->subcell_ke_mass, hale_data->subcell_ke_mass_flux);
+      hale_data->subcell_momentum_flux_z);
+  STOP_PROFILING(&compute_profile, "accumulate_subcell_fluxes");
 }
 
-// Advects mass and energy through the subcell faces using swept edge approx
-void perform_advection(
-    const int ncells, const int* cells_to_nodes_offsets, const double* nodes_x,
-    const double* nodes_y, const double* nodes_z, const double* rezoned_nodes_x,
+// Flags the nodes displaced from the rezoned mesh by more than ACTIVE_NODE_TOL,
+// and the cells that have any such node
+void calc_active_cells(const int nnodes, const int ncells,
+                       const int* cells_to_nodes_offsets,
+                       const int* cells_to_nodes, const double* nodes_x,
+                       const double* nodes_y, const double* nodes_z,
+                       const double* rezoned_nodes_x,
+                       const double* rezoned_nodes_y,
+                       const double* rezoned_nodes_z, int* nodes_active,
+                       int* cells_active) {
+
+#pragma omp parallel for simd
+  for (int nn = 0; nn < nnodes; ++nn) {
+    const double dx = nodes_x[(nn)] - rezoned_nodes_x[(nn)];
+    const double dy = nodes_y[(nn)] - rezoned_nodes_y[(nn)];
+    const double dz = nodes_z[(nn)] - rezoned_nodes_z[(nn)];
+    nodes_active[(nn)] =
+        (dx * dx + dy * dy + dz * dz > ACTIVE_NODE_TOL * ACTIVE_NODE_TOL);
+  }
+
+#pragma omp parallel for
+  for (int cc = 0; cc < ncells; ++cc) {
+    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+    const int nnodes_by_cell =
+        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
+
+    int is_active = 0;
+    for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+      is_active |= nodes_active[(cells_to_nodes[(cell_to_nodes_off + nn)])];
+    }
+    cells_active[(cc)] = is_active;
+  }
+}
+
+// Determines the volume and centroid of the region swept by each subcell face
+// and whether it leaves the subcell. The non-empty sweeps of each cell are
+// packed from the cell's first subcells_to_subcells slot, in slot order
+void calc_sweep_geometry(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* cells_active, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, const double* rezoned_nodes_x,
     const double* rezoned_nodes_y, const double* rezoned_nodes_z,
-    const int* cells_to_nodes, const int* faces_to_nodes_offsets,
-    const int* faces_to_nodes, const int* faces_cclockwise_cell,
+    const double* rezoned_cell_centroids_x,
+    const double* rezoned_cell_centroids_y,
+    const double* rezoned_cell_centroids_z,
+    const double* rezoned_face_centroids_x,
+    const double* rezoned_face_centroids_y,
+    const double* rezoned_face_centroids_z, const int* cells_to_nodes,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
     const int* subcells_to_faces_offsets, const int* subcells_to_faces,
     const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
-    const double* subcell_centroids_x, const double* subcell_centroids_y,
-    const double* subcell_centroids_z, const int* faces_to_cells0,
-    const int* faces_to_cells1, double* subcell_volume,
-    double* subcell_momentum_flux_x, double* subcell_momentum_flux_y,
-    double* subcell_momentum_flux_z, const double* subcell_momentum_x,
-    const double* subcell_momentum_y, const double* subcell_momentum_z,
-    const double* subcell_mass, double* subcell_mass_flux,
-    const double* subcell_ie_mass, double* subcell_ie_mass_flux,
-    const double* subcell_ke_mass, double* subcell_ke_mass_flux) {
+    const int* subcell_face_rnodes, const int* subcell_face_lnodes,
+    const int* subcell_face_r_faces, const int* subcell_face_l_faces,
+    const int* subcell_face_r_face_rnodes, const double* subcell_centroids_x,
+    const double* subcell_centroids_y, const double* subcell_centroids_z,
+    int* cells_nsweeps, int* subcells_to_sweeps, int* sweep_subcells,
+    int* sweep_slots, int* sweep_outflux, double* sweep_volumes,
+    double* sweep_centroids_x, double* sweep_centroids_y,
+    double* sweep_centroids_z) {
 
 #pragma omp parallel for
   for (int cc = 0; cc < ncells; ++cc) {
@@ -52,14 +198,41 @@ void perform_advection(
     const int nnodes_by_cell =
         cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
 
+    // The sweeps of the cell are packed from its first subcell's slots
+    const int cell_sweeps_off =
+        subcells_to_subcells_offsets[(cell_to_nodes_off)];
+    int nsweeps = 0;
+
+    // The slots of the cell's subcells are empty until a sweep is stored
+    const int cell_sweeps_end =
+        subcells_to_subcells_offsets[(cell_to_nodes_off + nnodes_by_cell)];
+    for (int ss = cell_sweeps_off; ss < cell_sweeps_end; ++ss) {
+      subcells_to_sweeps[(ss)] = -1;
+    }
+
+    // Every prism of a cell is built from the cell's own nodes, so none of
+    // them sweep a region unless one of the nodes has moved
+    if (!cells_active[(cc)]) {
+      cells_nsweeps[(cc)] = 0;
+      continue;
+    }
+
     vec_t cell_c = {0.0, 0.0, 0.0};
     calc_centroid(nnodes_by_cell, nodes_x, nodes_y, nodes_z, cells_to_nodes,
                   cell_to_nodes_off, &cell_c);
 
-    vec_t rz_cell_c = {0.0, 0.0, 0.0};
-    calc_centroid(nnodes_by_cell, rezoned_nodes_x, rezoned_nodes_y,
-                  rezoned_nodes_z, cells_to_nodes, cell_to_nodes_off,
-                  &rz_cell_c);
+    const vec_t rz_cell_c = {rezoned_cell_centroids_x[(cc)],
+                             rezoned_cell_centroids_y[(cc)],
+                             rezoned_cell_centroids_z[(cc)]};
+
+    // The prisms swept by the cell's subcell faces are gathered into batches,
+    // with node nn of prism pp at nn * NPRISMS_BY_BATCH + pp
+    double prism_nodes_x[NNODES_BY_PRISM * NPRISMS_BY_BATCH];
+    double prism_nodes_y[NNODES_BY_PRISM * NPRISMS_BY_BATCH];
+    double prism_nodes_z[NNODES_BY_PRISM * NPRISMS_BY_BATCH];
+    int prism_subcells[NPRISMS_BY_BATCH];
+    int prism_slots[NPRISMS_BY_BATCH];
+    int nprisms = 0;
 
     // Looping over corner subcells here
     for (int nn = 0; nn < nnodes_by_cell; ++nn) {
@@ -69,147 +242,116 @@ void perform_advection(
           subcells_to_faces_offsets[(subcell_index)];
       const int nfaces_by_subcell =
           subcells_to_faces_offsets[(subcell_index + 1)] - subcell_to_faces_off;
-
-      vec_t subcell_c = {subcell_centroids_x[(subcell_index)],
-                         subcell_centroids_y[(subcell_index)],
-                         subcell_centroids_z[(subcell_index)]};
+      const int subcell_to_subcells_off =
+          subcells_to_subcells_offsets[(subcell_index)];
 
       // Consider all faces attached to node
       for (int ff = 0; ff < nfaces_by_subcell; ++ff) {
-        const int face_index = subcells_to_faces[(subcell_to_faces_off + ff)];
-        const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
-        const int nnodes_by_face =
-            faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
-        const int neighbour_cc = (faces_to_cells0[(face_index)] == cc)
-                                     ? faces_to_cells1[(face_index)]
-                                     : faces_to_cells0[(face_index)];
-
-        // The face centroid is the same for all nodes on the face
-        vec_t face_c = {0.0, 0.0, 0.0};
-        calc_centroid(nnodes_by_face, nodes_x, nodes_y, nodes_z, faces_to_nodes,
-                      face_to_nodes_off, &face_c);
-        vec_t rz_face_c = {0.0, 0.0, 0.0};
-        calc_centroid(nnodes_by_face, rezoned_nodes_x, rezoned_nodes_y,
-                      rezoned_nodes_z, faces_to_nodes, face_to_nodes_off,
-                      &rz_face_c);
-
-        // Determine the position of the node in the face list of nodes
-        int nn2;
-        for (nn2 = 0; nn2 < nnodes_by_face; ++nn2) {
-          if (faces_to_nodes[(face_to_nodes_off + nn2)] == node_index) {
-            break;
-          }
-        }
-
-        const int face_clockwise = (faces_cclockwise_cell[(face_index)] != cc);
-        const int next_node = (nn2 == nnodes_by_face - 1) ? 0 : nn2 + 1;
-        const int prev_node = (nn2 == 0) ? nnodes_by_face - 1 : nn2 - 1;
-        const int rnode_off = (face_clockwise ? prev_node : next_node);
-        const int lnode_off = (face_clockwise ? next_node : prev_node);
-        const int rnode_index = faces_to_nodes[(face_to_nodes_off + rnode_off)];
-        const int lnode_index = faces_to_nodes[(face_to_nodes_off + lnode_off)];
-        const int swept_edge_to_faces[] = {0, 1, 2, 3, 4, 5};
-        const int swept_edge_faces_to_nodes[] = {0, 1, 2, 3, 4, 5, 6, 7,
-                                                 0, 3, 7, 4, 7, 6, 2, 3,
-                                                 1, 5, 6, 2, 0, 4, 5, 1};
-        const int swept_edge_faces_to_nodes_offsets[] = {0,  4,  8, 12,
-                                                         16, 20, 24};
+        const int subcell_face_index = subcell_to_faces_off + ff;
+        const int face_index = subcells_to_faces[(subcell_face_index)];
 
         /* INTERNAL FACE */
 
-        const int r_face_off = (ff == nfaces_by_subcell - 1) ? 0 : ff + 1;
-        const int lface_off = (ff == 0) ? nfaces_by_subcell - 1 : ff - 1;
-        const int r_face_index =
-            subcells_to_faces[(subcell_to_faces_off + r_face_off)];
-        const int lface_index =
-            subcells_to_faces[(subcell_to_faces_off + lface_off)];
-        const int r_face_to_nodes_off = faces_to_nodes_offsets[(r_face_index)];
-        const int lface_to_nodes_off = faces_to_nodes_offsets[(lface_index)];
-        const int nnodes_by_r_face =
-            faces_to_nodes_offsets[(r_face_index + 1)] - r_face_to_nodes_off;
-        const int nnodes_by_lface =
-            faces_to_nodes_offsets[(lface_index + 1)] - lface_to_nodes_off;
-
-        vec_t r_iface_c = {0.0, 0.0, 0.0};
-        calc_centroid(nnodes_by_r_face, nodes_x, nodes_y, nodes_z,
-                      faces_to_nodes, r_face_to_nodes_off, &r_iface_c);
-
-        const int r_face_clockwise =
-            (faces_cclockwise_cell[(r_face_index)] != cc);
-
-        // Determine the position of the node in the face list of nodes
-        for (nn2 = 0; nn2 < nnodes_by_r_face; ++nn2) {
-          if (faces_to_nodes[(r_face_to_nodes_off + nn2)] == node_index) {
-            break;
+        // Each subcell face is only swept by the subcell that owns it
+        if (is_sweep_owner(subcell_index, 2 * ff, subcells_to_subcells_offsets,
+                           subcells_to_subcells)) {
+          const int r_face_index = subcell_face_r_faces[(subcell_face_index)];
+          const int lface_index = subcell_face_l_faces[(subcell_face_index)];
+          const int r_face_rnode_index =
+              subcell_face_r_face_rnodes[(subcell_face_index)];
+          const int r_face_to_nodes_off =
+              faces_to_nodes_offsets[(r_face_index)];
+          const int lface_to_nodes_off = faces_to_nodes_offsets[(lface_index)];
+          const int nnodes_by_r_face =
+              faces_to_nodes_offsets[(r_face_index + 1)] - r_face_to_nodes_off;
+          const int nnodes_by_lface =
+              faces_to_nodes_offsets[(lface_index + 1)] - lface_to_nodes_off;
+
+          vec_t r_iface_c = {0.0, 0.0, 0.0};
+          calc_centroid(nnodes_by_r_face, nodes_x, nodes_y, nodes_z,
+                        faces_to_nodes, r_face_to_nodes_off, &r_iface_c);
+
+          vec_t l_iface_c = {0.0, 0.0, 0.0};
+          calc_centroid(nnodes_by_lface, nodes_x, nodes_y, nodes_z,
+                        faces_to_nodes, lface_to_nodes_off, &l_iface_c);
+          const vec_t rz_r_iface_c = {rezoned_face_centroids_x[(r_face_index)],
+                                      rezoned_face_centroids_y[(r_face_index)],
+                                      rezoned_face_centroids_z[(r_face_index)]};
+          const vec_t rz_l_iface_c = {rezoned_face_centroids_x[(lface_index)],
+                                      rezoned_face_centroids_y[(lface_index)],
+                                      rezoned_face_centroids_z[(lface_index)]};
+
+          double inodes_x[2 * NNODES_BY_SUBCELL_FACE] = {
+              0.5 * (nodes_x[(node_index)] + nodes_x[(r_face_rnode_index)]),
+              r_iface_c.x, cell_c.x, l_iface_c.x,
+              0.5 * (rezoned_nodes_x[(node_index)] +
+                     rezoned_nodes_x[(r_face_rnode_index)]),
+              rz_r_iface_c.x, rz_cell_c.x, rz_l_iface_c.x};
+          double inodes_y[2 * NNODES_BY_SUBCELL_FACE] = {
+              0.5 * (nodes_y[(node_index)] + nodes_y[(r_face_rnode_index)]),
+              r_iface_c.y, cell_c.y, l_iface_c.y,
+              0.5 * (rezoned_nodes_y[(node_index)] +
+                     rezoned_nodes_y[(r_face_rnode_index)]),
+              rz_r_iface_c.y, rz_cell_c.y, rz_l_iface_c.y};
+          double inodes_z[2 * NNODES_BY_SUBCELL_FACE] = {
+              0.5 * (nodes_z[(node_index)] + nodes_z[(r_face_rnode_index)]),
+              r_iface_c.z, cell_c.z, l_iface_c.z,
+              0.5 * (rezoned_nodes_z[(node_index)] +
+                     rezoned_nodes_z[(r_face_rnode_index)]),
+              rz_r_iface_c.z, rz_cell_c.z, rz_l_iface_c.z};
+
+          // Gathers the internal face's prism into the batch
+          if (nprisms == NPRISMS_BY_BATCH) {
+            nsweeps += calc_batch_sweeps(
+                cc, nprisms, prism_nodes_x, prism_nodes_y, prism_nodes_z,
+                prism_subcells, prism_slots, subcell_centroids_x,
+                subcell_centroids_y, subcell_centroids_z,
+                subcells_to_subcells_offsets, subcells_to_subcells,
+                cell_sweeps_off + nsweeps, subcells_to_sweeps, sweep_subcells,
+                sweep_slots, sweep_outflux, sweep_volumes, sweep_centroids_x,
+                sweep_centroids_y, sweep_centroids_z);
+            nprisms = 0;
+          }
+          for (int pn = 0; pn < NNODES_BY_PRISM; ++pn) {
+            prism_nodes_x[(pn * NPRISMS_BY_BATCH + nprisms)] = inodes_x[(pn)];
+            prism_nodes_y[(pn * NPRISMS_BY_BATCH + nprisms)] = inodes_y[(pn)];
+            prism_nodes_z[(pn * NPRISMS_BY_BATCH + nprisms)] = inodes_z[(pn)];
           }
+          prism_subcells[(nprisms)] = subcell_index;
+          prism_slots[(nprisms++)] = 2 * ff;
         }
 
-        const int r_face_next_node =
-            (nn2 == nnodes_by_r_face - 1) ? 0 : nn2 + 1;
-        const int r_face_prev_node =
-            (nn2 == 0) ? nnodes_by_r_face - 1 : nn2 - 1;
-        const int r_face_rnode_off =
-            (r_face_clockwise ? r_face_prev_node : r_face_next_node);
-        const int r_face_rnode_index =
-            faces_to_nodes[(r_face_to_nodes_off + r_face_rnode_off)];
-
-        vec_t l_iface_c = {0.0, 0.0, 0.0};
-        calc_centroid(nnodes_by_lface, nodes_x, nodes_y, nodes_z,
-                      faces_to_nodes, lface_to_nodes_off, &l_iface_c);
-        vec_t rz_r_iface_c = {0.0, 0.0, 0.0};
-        calc_centroid(nnodes_by_r_face, rezoned_nodes_x, rezoned_nodes_y,
-                      rezoned_nodes_z, faces_to_nodes, r_face_to_nodes_off,
-                      &rz_r_iface_c);
-        vec_t rz_l_iface_c = {0.0, 0.0, 0.0};
-        calc_centroid(nnodes_by_lface, rezoned_nodes_x, rezoned_nodes_y,
-                      rezoned_nodes_z, faces_to_nodes, lface_to_nodes_off,
-                      &rz_l_iface_c);
-
-        double inodes_x[2 * NNODES_BY_SUBCELL_FACE] = {
-            0.5 * (nodes_x[(node_index)] + nodes_x[(r_face_rnode_index)]),
-            r_iface_c.x, cell_c.x, l_iface_c.x,
-            0.5 * (rezoned_nodes_x[(node_index)] +
-                   rezoned_nodes_x[(r_face_rnode_index)]),
-            rz_r_iface_c.x, rz_cell_c.x, rz_l_iface_c.x};
-        double inodes_y[2 * NNODES_BY_SUBCELL_FACE] = {
-            0.5 * (nodes_y[(node_index)] + nodes_y[(r_face_rnode_index)]),
-            r_iface_c.y, cell_c.y, l_iface_c.y,
-            0.5 * (rezoned_nodes_y[(node_index)] +
-                   rezoned_nodes_y[(r_face_rnode_index)]),
-            rz_r_iface_c.y, rz_cell_c.y, rz_l_iface_c.y};
-        double inodes_z[2 * NNODES_BY_SUBCELL_FACE] = {
-            0.5 * (nodes_z[(node_index)] + nodes_z[(r_face_rnode_index)]),
-            r_iface_c.z, cell_c.z, l_iface_c.z,
-            0.5 * (rezoned_nodes_z[(node_index)] +
-                   rezoned_nodes_z[(r_face_rnode_index)]),
-            rz_r_iface_c.z, rz_cell_c.z, rz_l_iface_c.z};
-
-        // Contributes the local mass, energy and momentum flux for a given
-        // subcell face
-        flux_mass_energy_momentum(
-            cc, neighbour_cc, ff, subcell_index, &subcell_c, &cell_c, inodes_x,
-            inodes_y, inodes_z, subcell_mass, subcell_mass_flux,
-            subcell_ie_mass, subcell_ie_mass_flux, subcell_ke_mass,
-            subcell_ke_mass_flux, subcell_volume, subcell_momentum_x,
-            subcell_momentum_y, subcell_momentum_z, subcell_momentum_flux_x,
-            subcell_momentum_flux_y, subcell_momentum_flux_z,
-            swept_edge_faces_to_nodes, subcell_centroids_x, subcell_centroids_y,
-            subcell_centroids_z, swept_edge_to_faces,
-            swept_edge_faces_to_nodes_offsets, subcells_to_subcells_offsets,
-            subcells_to_subcells, subcells_to_faces_offsets, subcells_to_faces,
-            faces_to_nodes_offsets, faces_to_nodes, cells_to_nodes_offsets,
-            cells_to_nodes, faces_cclockwise_cell, nodes_x, nodes_y, nodes_z,
-            1);
-
         /* EXTERNAL FACE */
 
         // We explicitly disallow flux on the boundary, this could be disable
         // for testing purposes in order to ensure that no flux is inadvertently
         // accumulating on the boundaries
-        if (neighbour_cc == -1) {
+        if (subcells_to_subcells[(subcell_to_subcells_off + 2 * ff + 1)] ==
+            -1) {
           continue;
         }
 
+        // Otherwise the neighbouring cell's subcell sweeps the face
+        if (!is_sweep_owner(subcell_index, 2 * ff + 1,
+                            subcells_to_subcells_offsets,
+                            subcells_to_subcells)) {
+          continue;
+        }
+
+        const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
+        const int nnodes_by_face =
+            faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
+        const int rnode_index = subcell_face_rnodes[(subcell_face_index)];
+        const int lnode_index = subcell_face_lnodes[(subcell_face_index)];
+
+        // The face centroid is the same for all nodes on the face
+        vec_t face_c = {0.0, 0.0, 0.0};
+        calc_centroid(nnodes_by_face, nodes_x, nodes_y, nodes_z, faces_to_nodes,
+                      face_to_nodes_off, &face_c);
+        const vec_t rz_face_c = {rezoned_face_centroids_x[(face_index)],
+                                 rezoned_face_centroids_y[(face_index)],
+                                 rezoned_face_centroids_z[(face_index)]};
+
         double enodes_x[2 * NNODES_BY_SUBCELL_FACE] = {
             nodes_x[(node_index)],
             0.5 * (nodes_x[(node_index)] + nodes_x[(rnode_index)]), face_c.x,
@@ -238,107 +380,485 @@ void perform_advection(
             rz_face_c.z, 0.5 * (rezoned_nodes_z[(node_index)] +
                                 rezoned_nodes_z[(lnode_index)])};
 
-        // Contributes the local mass, energy and momentum flux for a given
-        // subcell face
-        flux_mass_energy_momentum(
-            cc, neighbour_cc, ff, subcell_index, &subcell_c, &cell_c, enodes_x,
-            enodes_y, enodes_z, subcell_mass, subcell_mass_flux,
-            subcell_ie_mass, subcell_ie_mass_flux, subcell_ke_mass,
-            subcell_ke_mass_flux, subcell_volume, subcell_momentum_x,
-            subcell_momentum_y, subcell_momentum_z, subcell_momentum_flux_x,
-            subcell_momentum_flux_y, subcell_momentum_flux_z,
-            swept_edge_faces_to_nodes, subcell_centroids_x, subcell_centroids_y,
-            subcell_centroids_z, swept_edge_to_faces,
-            swept_edge_faces_to_nodes_offsets, subcells_to_subcells_offsets,
-            subcells_to_subcells, subcells_to_faces_offsets, subcells_to_faces,
-            faces_to_nodes_offsets, faces_to_nodes, cells_to_nodes_offsets,
-            cells_to_nodes, faces_cclockwise_cell, nodes_x, nodes_y, nodes_z,
-            0);
+        // Gathers the external face's prism into the batch
+        if (nprisms == NPRISMS_BY_BATCH) {
+          nsweeps += calc_batch_sweeps(
+              cc, nprisms, prism_nodes_x, prism_nodes_y, prism_nodes_z,
+              prism_subcells, prism_slots, subcell_centroids_x,
+              subcell_centroids_y, subcell_centroids_z,
+              subcells_to_subcells_offsets, subcells_to_subcells,
+              cell_sweeps_off + nsweeps, subcells_to_sweeps, sweep_subcells,
+              sweep_slots, sweep_outflux, sweep_volumes, sweep_centroids_x,
+              sweep_centroids_y, sweep_centroids_z);
+          nprisms = 0;
+        }
+        for (int pn = 0; pn < NNODES_BY_PRISM; ++pn) {
+          prism_nodes_x[(pn * NPRISMS_BY_BATCH + nprisms)] = enodes_x[(pn)];
+          prism_nodes_y[(pn * NPRISMS_BY_BATCH + nprisms)] = enodes_y[(pn)];
+          prism_nodes_z[(pn * NPRISMS_BY_BATCH + nprisms)] = enodes_z[(pn)];
+        }
+        prism_subcells[(nprisms)] = subcell_index;
+        prism_slots[(nprisms++)] = 2 * ff + 1;
       }
     }
+
+    // Evaluates the remaining prisms of the cell
+    nsweeps += calc_batch_sweeps(
+        cc, nprisms, prism_nodes_x, prism_nodes_y, prism_nodes_z,
+        prism_subcells, prism_slots, subcell_centroids_x, subcell_centroids_y,
+        subcell_centroids_z, subcells_to_subcells_offsets, subcells_to_subcells,
+        cell_sweeps_off + nsweeps, subcells_to_sweeps, sweep_subcells,
+        sweep_slots, sweep_outflux, sweep_volumes, sweep_centroids_x,
+        sweep_centroids_y, sweep_centroids_z);
+
+    cells_nsweeps[(cc)] = nsweeps;
   }
 }
 
-// Contributes the local mass, energy and momentum flux for a given subcell face
-void flux_mass_energy_momentum(
-    const int cc, const int neighbour_cc, const int ff, const int subcell_index,
-    vec_t* subcell_c, vec_t* cell_c, const double* se_nodes_x,
-    const double* se_nodes_y, const double* se_nodes_z,
-    const double* subcell_mass, double* subcell_mass_flux,
-    const double* subcell_ie_mass, double* subcell_ie_mass_flux,
-    const double* subcell_ke_mass, double* subcell_ke_mass_flux,
-    const double* subcell_volume, const double* subcell_momentum_x,
-    const double* subcell_momentum_y, const double* subcell_momentum_z,
-    double* subcell_momentum_flux_x, double* subcell_momentum_flux_y,
-    double* subcell_momentum_flux_z, const int* swept_edge_faces_to_nodes,
+// Evaluates a batch of a cell's swept edge prisms, with node nn of prism pp at
+// nn * NPRISMS_BY_BATCH + pp, and stores the non-empty sweeps in batch order
+// from sweep_off, returning the number of sweeps stored
+int calc_batch_sweeps(
+    const int cc, const int nprisms, const double* prism_nodes_x,
+    const double* prism_nodes_y, const double* prism_nodes_z,
+    const int* prism_subcells, const int* prism_slots,
     const double* subcell_centroids_x, const double* subcell_centroids_y,
-    const double* subcell_centroids_z, const int* swept_edge_to_faces,
-    const int* swept_edge_faces_to_nodes_offsets,
-    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
-    const int* subcells_to_faces_offsets, const int* subcells_to_faces,
-    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
-    const int* cells_to_nodes_offsets, const int* cells_to_nodes,
-    const int* faces_cclockwise_cell, const double* nodes_x,
-    const double* nodes_y, const double* nodes_z, const int internal) {
+    const double* subcell_centroids_z, const int* subcells_to_subcells_offsets,
+    const int* subcells_to_subcells, const int sweep_off,
+    int* subcells_to_sweeps, int* sweep_subcells, int* sweep_slots,
+    int* sweep_outflux, double* sweep_volumes, double* sweep_centroids_x,
+    double* sweep_centroids_y, double* sweep_centroids_z) {
+
+  double prism_volumes[NPRISMS_BY_BATCH];
+  double prism_centroids_x[NPRISMS_BY_BATCH];
+  double prism_centroids_y[NPRISMS_BY_BATCH];
+  double prism_centroids_z[NPRISMS_BY_BATCH];
+  int prism_outflux[NPRISMS_BY_BATCH];
+
+  // The prisms are independent, so their geometry is evaluated across lanes
+  calc_prism_volumes_centroids(nprisms, NPRISMS_BY_BATCH, prism_nodes_x,
+                               prism_nodes_y, prism_nodes_z, prism_volumes,
+                               prism_centroids_x, prism_centroids_y,
+                               prism_centroids_z);
+  calc_prism_outflux(nprisms, NPRISMS_BY_BATCH, prism_nodes_x, prism_nodes_y,
+                     prism_nodes_z, prism_subcells, subcell_centroids_x,
+                     subcell_centroids_y, subcell_centroids_z, prism_outflux);
+
+  int nsweeps = 0;
+  for (int pp = 0; pp < nprisms; ++pp) {
+
+    // Ignore the special case of an empty swept edge region
+    if (prism_volumes[(pp)] < EPS) {
+      if (prism_volumes[(pp)] < -EPS) {
+        printf("Negative swept edge volume %d %.12f\n", cc,
+               prism_volumes[(pp)]);
+      }
+      continue;
+    }
 
-  // Get the centroids for the swept edge prism and faces
-  vec_t face_c = {0.0, 0.0, 0.0};
-  vec_t rz_face_c = {0.0, 0.0, 0.0};
-  vec_t swept_edge_c = {0.0, 0.0, 0.0};
-  calc_centroid(NNODES_BY_SUBCELL_FACE, se_nodes_x, se_nodes_y, se_nodes_z,
-                swept_edge_faces_to_nodes, 0, &face_c);
-  calc_centroid(NNODES_BY_SUBCELL_FACE, se_nodes_x, se_nodes_y, se_nodes_z,
-                swept_edge_faces_to_nodes,
-                swept_edge_faces_to_nodes_offsets[(1)], &rz_face_c);
-  calc_centroid(2 * NNODES_BY_SUBCELL_FACE, se_nodes_x, se_nodes_y, se_nodes_z,
-                swept_edge_faces_to_nodes, 0, &swept_edge_c);
-
-  // Calculate the volume of the swept edge prism
-  double swept_edge_vol = 0.0;
-  calc_volume(0, 2 + NNODES_BY_SUBCELL_FACE, swept_edge_to_faces,
-              swept_edge_faces_to_nodes, swept_edge_faces_to_nodes_offsets,
-              se_nodes_x, se_nodes_y, se_nodes_z, &swept_edge_c,
-              &swept_edge_vol);
-
-  // Ignore the special case of an empty swept edge region
-  if (swept_edge_vol < EPS) {
-    if (swept_edge_vol < -EPS) {
-      printf("Negative swept edge volume %d %.12f\n", cc, swept_edge_vol);
+    check_sweep_neighbour(prism_subcells[(pp)], prism_slots[(pp)],
+                          subcells_to_subcells_offsets, subcells_to_subcells,
+                          prism_volumes[(pp)]);
+
+    const int sweep_index = sweep_off + nsweeps++;
+    subcells_to_sweeps[(subcells_to_subcells_offsets[(prism_subcells[(pp)])] +
+                        prism_slots[(pp)])] = sweep_index;
+    sweep_subcells[(sweep_index)] = prism_subcells[(pp)];
+    sweep_slots[(sweep_index)] = prism_slots[(pp)];
+    sweep_outflux[(sweep_index)] = prism_outflux[(pp)];
+    sweep_volumes[(sweep_index)] = prism_volumes[(pp)];
+    sweep_centroids_x[(sweep_index)] = prism_centroids_x[(pp)];
+    sweep_centroids_y[(sweep_index)] = prism_centroids_y[(pp)];
+    sweep_centroids_z[(sweep_index)] = prism_centroids_z[(pp)];
+  }
+
+  return nsweeps;
+}
+
+// Determines whether each prism of a batch leaves its subcell, by comparing
+// the movement of the face against the direction to the subcell centroid
+void calc_prism_outflux(const int nprisms, const int stride,
+                        const double* prism_nodes_x,
+                        const double* prism_nodes_y,
+                        const double* prism_nodes_z, const int* prism_subcells,
+                        const double* subcell_centroids_x,
+                        const double* subcell_centroids_y,
+                        const double* subcell_centroids_z,
+                        int* prism_outflux) {
+
+#pragma omp simd
+  for (int pp = 0; pp < nprisms; ++pp) {
+
+    // The original face is the first four nodes, and the rezoned face the last
+    vec_t face_c = {0.0, 0.0, 0.0};
+    vec_t rz_face_c = {0.0, 0.0, 0.0};
+    for (int nn = 0; nn < NNODES_BY_SUBCELL_FACE; ++nn) {
+      const int node_off = nn * stride + pp;
+      const int rz_node_off = (nn + NNODES_BY_SUBCELL_FACE) * stride + pp;
+      face_c.x += prism_nodes_x[(node_off)] / NNODES_BY_SUBCELL_FACE;
+      face_c.y += prism_nodes_y[(node_off)] / NNODES_BY_SUBCELL_FACE;
+      face_c.z += prism_nodes_z[(node_off)] / NNODES_BY_SUBCELL_FACE;
+      rz_face_c.x += prism_nodes_x[(rz_node_off)] / NNODES_BY_SUBCELL_FACE;
+      rz_face_c.y += prism_nodes_y[(rz_node_off)] / NNODES_BY_SUBCELL_FACE;
+      rz_face_c.z += prism_nodes_z[(rz_node_off)] / NNODES_BY_SUBCELL_FACE;
     }
-    return;
+
+    const int subcell_index = prism_subcells[(pp)];
+    vec_t ab = {rz_face_c.x - face_c.x, rz_face_c.y - face_c.y,
+                rz_face_c.z - face_c.z};
+    vec_t ac = {subcell_centroids_x[(subcell_index)] - face_c.x,
+                subcell_centroids_y[(subcell_index)] - face_c.y,
+                subcell_centroids_z[(subcell_index)] - face_c.z};
+    prism_outflux[(pp)] = (ab.x * ac.x + ab.y * ac.y + ab.z * ac.z > 0.0);
   }
+}
 
-  // current sub cell
-  vec_t ab = {rz_face_c.x - face_c.x, rz_face_c.y - face_c.y,
-              rz_face_c.z - face_c.z};
-  vec_t ac = {subcell_c->x - face_c.x, subcell_c->y - face_c.y,
-              subcell_c->z - face_c.z};
-  const int is_outflux = (ab.x * ac.x + ab.y * ac.y + ab.z * ac.z > 0.0);
+// Calculates the volumes and centroids of a batch of swept edge prisms, whose
+// nodes are the subcell face on the original mesh followed by the same face on
+// the rezoned mesh, with node nn of prism pp at nn * stride + pp. The faces of
+// the prisms are fixed, so each face is evaluated across the prisms in turn
+void calc_prism_volumes_centroids(const int nprisms, const int stride,
+                                  const double* prism_nodes_x,
+                                  const double* prism_nodes_y,
+                                  const double* prism_nodes_z,
+                                  double* prism_volumes,
+                                  double* prism_centroids_x,
+                                  double* prism_centroids_y,
+                                  double* prism_centroids_z) {
+
+  const int prism_faces_to_nodes[] = {0, 1, 2, 3, 4, 5, 6, 7, 0, 3, 7, 4,
+                                      7, 6, 2, 3, 1, 5, 6, 2, 0, 4, 5, 1};
+
+#pragma omp simd
+  for (int pp = 0; pp < nprisms; ++pp) {
+    vec_t prism_c = {0.0, 0.0, 0.0};
+    for (int nn = 0; nn < NNODES_BY_PRISM; ++nn) {
+      prism_c.x += prism_nodes_x[(nn * stride + pp)] / NNODES_BY_PRISM;
+      prism_c.y += prism_nodes_y[(nn * stride + pp)] / NNODES_BY_PRISM;
+      prism_c.z += prism_nodes_z[(nn * stride + pp)] / NNODES_BY_PRISM;
+    }
+    prism_volumes[(pp)] = 0.0;
+    prism_centroids_x[(pp)] = prism_c.x;
+    prism_centroids_y[(pp)] = prism_c.y;
+    prism_centroids_z[(pp)] = prism_c.z;
+  }
 
-  // Depending upon which subcell we are sweeping into, choose the
-  // subcell index with which to reconstruct the density
-  const int subcell_to_subcells_off =
-      subcells_to_subcells_offsets[(subcell_index)];
-  const int internal_offset = (internal ? 0 : 1);
-  const int subcell_neighbour_index = subcells_to_subcells[(
-      subcell_to_subcells_off + 2 * ff + internal_offset)];
+  // Sums the tetrahedra between the prism centroid, each face centroid and
+  // each half of the face edges, as contribute_face_volume does
+  for (int ff = 0; ff < NFACES_BY_PRISM; ++ff) {
+    const int* face_to_nodes =
+        &prism_faces_to_nodes[(ff * NNODES_BY_SUBCELL_FACE)];
+
+#pragma omp simd
+    for (int pp = 0; pp < nprisms; ++pp) {
+      vec_t face_c = {0.0, 0.0, 0.0};
+      for (int nn = 0; nn < NNODES_BY_SUBCELL_FACE; ++nn) {
+        const int node_off = face_to_nodes[(nn)] * stride + pp;
+        face_c.x += prism_nodes_x[(node_off)] / NNODES_BY_SUBCELL_FACE;
+        face_c.y += prism_nodes_y[(node_off)] / NNODES_BY_SUBCELL_FACE;
+        face_c.z += prism_nodes_z[(node_off)] / NNODES_BY_SUBCELL_FACE;
+      }
+
+      for (int nn = 0; nn < NNODES_BY_SUBCELL_FACE; ++nn) {
+        const int node_off = face_to_nodes[(nn)] * stride + pp;
+        const int next_node_off =
+            face_to_nodes[((nn + 1) % NNODES_BY_SUBCELL_FACE)] * stride + pp;
+
+        // Get the halfway point on the right edge
+        vec_t half_edge = {
+            0.5 * (prism_nodes_x[(node_off)] + prism_nodes_x[(next_node_off)]),
+            0.5 * (prism_nodes_y[(node_off)] + prism_nodes_y[(next_node_off)]),
+            0.5 * (prism_nodes_z[(node_off)] + prism_nodes_z[(next_node_off)])};
+
+        // Setup basis on plane of tetrahedron
+        vec_t a = {(half_edge.x - face_c.x), (half_edge.y - face_c.y),
+                   (half_edge.z - face_c.z)};
+        vec_t b = {(prism_centroids_x[(pp)] - face_c.x),
+                   (prism_centroids_y[(pp)] - face_c.y),
+                   (prism_centroids_z[(pp)] - face_c.z)};
+        vec_t ab = {(half_edge.x - prism_nodes_x[(node_off)]),
+                    (half_edge.y - prism_nodes_y[(node_off)]),
+                    (half_edge.z - prism_nodes_z[(node_off)])};
+
+        // Calculate the area vector S using cross product
+        vec_t S = {0.5 * (a.y * b.z - a.z * b.y),
+                   -0.5 * (a.x * b.z - a.z * b.x),
+                   0.5 * (a.x * b.y - a.y * b.x)};
+
+        prism_volumes[(pp)] +=
+            2.0 * fabs(ab.x * S.x + ab.y * S.y + ab.z * S.z) / 3.0;
+      }
+    }
+  }
+
+  // A degenerate prism is treated as empty
+#pragma omp simd
+  for (int pp = 0; pp < nprisms; ++pp) {
+    if (isnan(prism_volumes[(pp)])) {
+      prism_volumes[(pp)] = 0.0;
+    }
+  }
+}
+
+// Determines whether a subcell owns the sweep of the face at the given slot,
+// which is the lower indexed of the two subcells sharing the face
+int is_sweep_owner(const int subcell_index, const int slot,
+                   const int* subcells_to_subcells_offsets,
+                   const int* subcells_to_subcells) {
+
+  const int neighbour_index = subcells_to_subcells[(
+      subcells_to_subcells_offsets[(subcell_index)] + slot)];
+  return (neighbour_index == -1 || neighbour_index > subcell_index);
+}
+
+// Determines whether a cell, or any cell across one of its faces, is active
+int is_near_active_cell(const int cc, const int* cells_to_faces_offsets,
+                        const int* cells_to_faces, const int* faces_to_cells0,
+                        const int* faces_to_cells1, const int* cells_active) {
+
+  if (cells_active[(cc)]) {
+    return 1;
+  }
+
+  const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
+  const int nfaces_by_cell =
+      cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
+  for (int ff = 0; ff < nfaces_by_cell; ++ff) {
+    const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
+    const int neighbour_cc = (faces_to_cells0[(face_index)] == cc)
+                                 ? faces_to_cells1[(face_index)]
+                                 : faces_to_cells0[(face_index)];
+    if (neighbour_cc != -1 && cells_active[(neighbour_cc)]) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Flags the cells within two faces of an active cell. The sweeps of the active
+// cells are reconstructed from the cells across their faces, whose gradients
+// are fitted to the subcells of the cells across their own faces
+void calc_reconstructed_cells(const int ncells,
+                              const int* cells_to_faces_offsets,
+                              const int* cells_to_faces,
+                              const int* faces_to_cells0,
+                              const int* faces_to_cells1,
+                              const int* cells_active,
+                              int* cells_reconstructed) {
+
+#pragma omp parallel for
+  for (int cc = 0; cc < ncells; ++cc) {
+    int is_reconstructed =
+        is_near_active_cell(cc, cells_to_faces_offsets, cells_to_faces,
+                            faces_to_cells0, faces_to_cells1, cells_active);
+
+    const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
+    const int nfaces_by_cell =
+        cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
+    for (int ff = 0; ff < nfaces_by_cell && !is_reconstructed; ++ff) {
+      const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
+      const int neighbour_cc = (faces_to_cells0[(face_index)] == cc)
+                                   ? faces_to_cells1[(face_index)]
+                                   : faces_to_cells0[(face_index)];
+      is_reconstructed =
+          (neighbour_cc != -1 &&
+           is_near_active_cell(neighbour_cc, cells_to_faces_offsets,
+                               cells_to_faces, faces_to_cells0,
+                               faces_to_cells1, cells_active));
+    }
+    cells_reconstructed[(cc)] = is_reconstructed;
+  }
+}
+
+// Checks that a non-empty sweep has a subcell on the other side of its face
+void check_sweep_neighbour(const int subcell_index, const int slot,
+                           const int* subcells_to_subcells_offsets,
+                           const int* subcells_to_subcells,
+                           const double swept_edge_vol) {
 
   // Only perform the sweep on the external face if it isn't a
   // boundary
-  if (subcell_neighbour_index == -1) {
+  if (subcells_to_subcells[(subcells_to_subcells_offsets[(subcell_index)] +
+                            slot)] == -1) {
     TERMINATE(
         "We should not be attempting to flux from boundary. Volume: %.12f.",
         swept_edge_vol);
   }
+}
+
+// Calculates the limited gradients of mass, energy and velocity in each
+// subcell, ahead of the flux stage
+void calc_subcell_gradients(
+    const int ncells, const int* cells_to_nodes_offsets, const double* nodes_x,
+    const double* nodes_y, const double* nodes_z, const int* cells_to_nodes,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+    const int* cells_to_faces_offsets, const int* cells_to_faces,
+    const int* faces_to_cells0, const int* faces_to_cells1,
+    const int* subcells_to_faces_offsets, const int* subcells_to_faces,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    const int* subcell_face_rnodes, const int* cells_active,
+    const int* cells_nsweeps, const int* sweep_subcells, const int* sweep_slots,
+    const int* sweep_outflux, const double* subcell_centroids_x,
+    const double* subcell_centroids_y, const double* subcell_centroids_z,
+    const double* subcell_volume, const double* subcell_mass,
+    const double* subcell_ie_mass, const double* subcell_ke_mass,
+    const double* subcell_momentum_x, const double* subcell_momentum_y,
+    const double* subcell_momentum_z, double* subcell_grad_m_x,
+    double* subcell_grad_m_y, double* subcell_grad_m_z,
+    double* subcell_grad_ie_x, double* subcell_grad_ie_y,
+    double* subcell_grad_ie_z, double* subcell_grad_ke_x,
+    double* subcell_grad_ke_y, double* subcell_grad_ke_z,
+    double* subcell_grad_vx_x, double* subcell_grad_vx_y,
+    double* subcell_grad_vx_z, double* subcell_grad_vy_x,
+    double* subcell_grad_vy_y, double* subcell_grad_vy_z,
+    double* subcell_grad_vz_x, double* subcell_grad_vz_y,
+    double* subcell_grad_vz_z) {
+
+#pragma omp parallel for
+  for (int cc = 0; cc < ncells; ++cc) {
+    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+    const int nnodes_by_cell =
+        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
+
+    // Only the active cells have sweeps to reconstruct
+    if (!is_near_active_cell(cc, cells_to_faces_offsets, cells_to_faces,
+                             faces_to_cells0, faces_to_cells1, cells_active)) {
+      continue;
+    }
+
+    const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
+    const int nfaces_by_cell =
+        cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
+
+    vec_t cell_c = {0.0, 0.0, 0.0};
+    calc_centroid(nnodes_by_cell, nodes_x, nodes_y, nodes_z, cells_to_nodes,
+                  cell_to_nodes_off, &cell_c);
+
+    // The least squares systems of the source subcells are solved in batches,
+    // with entry kk of system ss at kk * NSOLVES_BY_BATCH + ss
+    double batch_coeff[NSYM_3X3_ENTRIES * NSOLVES_BY_BATCH];
+    double batch_rhs[NGRADIENTS_BY_SUBCELL * 3 * NSOLVES_BY_BATCH];
+    double batch_gmax[NGRADIENTS_BY_SUBCELL * NSOLVES_BY_BATCH];
+    double batch_gmin[NGRADIENTS_BY_SUBCELL * NSOLVES_BY_BATCH];
+    int batch_subcells[NSOLVES_BY_BATCH];
+    int nsolves = 0;
+
+    for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+      const int subcell_index = cell_to_nodes_off + nn;
+
+      // Only the subcells that reconstruct a sweep need gradients, and those
+      // sweeps belong to this cell or a cell across one of its faces
+      int is_source = is_sweep_source(
+          cc, subcell_index, cells_to_nodes_offsets,
+          subcells_to_subcells_offsets, subcells_to_subcells, cells_nsweeps,
+          sweep_subcells, sweep_slots, sweep_outflux);
+      for (int ff = 0; ff < nfaces_by_cell && !is_source; ++ff) {
+        const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
+        const int neighbour_cc = (faces_to_cells0[(face_index)] == cc)
+                                     ? faces_to_cells1[(face_index)]
+                                     : faces_to_cells0[(face_index)];
+        if (neighbour_cc != -1) {
+          is_source = is_sweep_source(
+              neighbour_cc, subcell_index, cells_to_nodes_offsets,
+              subcells_to_subcells_offsets, subcells_to_subcells,
+              cells_nsweeps, sweep_subcells, sweep_slots, sweep_outflux);
+        }
+      }
+
+      if (!is_source) {
+        continue;
+      }
+
+      if (nsolves == NSOLVES_BY_BATCH) {
+        limit_batch_gradients(
+            nsolves, batch_subcells, &cell_c, nodes_x, nodes_y, nodes_z,
+            cells_to_nodes, faces_to_nodes_offsets, faces_to_nodes,
+            subcells_to_faces_offsets, subcells_to_faces, subcell_face_rnodes,
+            subcell_centroids_x, subcell_centroids_y, subcell_centroids_z,
+            subcell_volume, subcell_mass, subcell_ie_mass, subcell_ke_mass,
+            subcell_momentum_x, subcell_momentum_y, subcell_momentum_z,
+            batch_coeff, batch_rhs, batch_gmax, batch_gmin, subcell_grad_m_x,
+            subcell_grad_m_y, subcell_grad_m_z, subcell_grad_ie_x,
+            subcell_grad_ie_y, subcell_grad_ie_z, subcell_grad_ke_x,
+            subcell_grad_ke_y, subcell_grad_ke_z, subcell_grad_vx_x,
+            subcell_grad_vx_y, subcell_grad_vx_z, subcell_grad_vy_x,
+            subcell_grad_vy_y, subcell_grad_vy_z, subcell_grad_vz_x,
+            subcell_grad_vz_y, subcell_grad_vz_z);
+        nsolves = 0;
+      }
+
+      calc_gradient_system(
+          subcell_index, nsolves, NSOLVES_BY_BATCH,
+          subcells_to_subcells_offsets, subcells_to_subcells,
+          subcell_centroids_x, subcell_centroids_y, subcell_centroids_z,
+          subcell_volume, subcell_mass, subcell_ie_mass, subcell_ke_mass,
+          subcell_momentum_x, subcell_momentum_y, subcell_momentum_z,
+          batch_coeff, batch_rhs, batch_gmax, batch_gmin);
+      batch_subcells[(nsolves++)] = subcell_index;
+    }
+
+    limit_batch_gradients(
+        nsolves, batch_subcells, &cell_c, nodes_x, nodes_y, nodes_z,
+        cells_to_nodes, faces_to_nodes_offsets, faces_to_nodes,
+        subcells_to_faces_offsets, subcells_to_faces, subcell_face_rnodes,
+        subcell_centroids_x, subcell_centroids_y, subcell_centroids_z,
+        subcell_volume, subcell_mass, subcell_ie_mass, subcell_ke_mass,
+        subcell_momentum_x, subcell_momentum_y, subcell_momentum_z,
+        batch_coeff, batch_rhs, batch_gmax, batch_gmin, subcell_grad_m_x,
+        subcell_grad_m_y, subcell_grad_m_z, subcell_grad_ie_x,
+        subcell_grad_ie_y, subcell_grad_ie_z, subcell_grad_ke_x,
+        subcell_grad_ke_y, subcell_grad_ke_z, subcell_grad_vx_x,
+        subcell_grad_vx_y, subcell_grad_vx_z, subcell_grad_vy_x,
+        subcell_grad_vy_y, subcell_grad_vy_z, subcell_grad_vz_x,
+        subcell_grad_vz_y, subcell_grad_vz_z);
+  }
+}
+
+// Determines whether any of the sweeps of a cell are reconstructed from the
+// given subcell
+int is_sweep_source(const int cc, const int subcell_index,
+                    const int* cells_to_nodes_offsets,
+                    const int* subcells_to_subcells_offsets,
+                    const int* subcells_to_subcells, const int* cells_nsweeps,
+                    const int* sweep_subcells, const int* sweep_slots,
+                    const int* sweep_outflux) {
+
+  const int cell_sweeps_off =
+      subcells_to_subcells_offsets[(cells_to_nodes_offsets[(cc)])];
+  const int nsweeps = cells_nsweeps[(cc)];
+
+  for (int ss = 0; ss < nsweeps; ++ss) {
+    const int sweep_index = cell_sweeps_off + ss;
+    int source_index = sweep_subcells[(sweep_index)];
+
+    // Inflowing sweeps are reconstructed from the subcell across the face
+    if (!sweep_outflux[(sweep_index)]) {
+      source_index = subcells_to_subcells[(
+          subcells_to_subcells_offsets[(source_index)] +
+          sweep_slots[(sweep_index)])];
+    }
+
+    if (source_index == subcell_index) {
+      return 1;
+    }
+  }
 
-  // The sweep subcell index is where we will reconstruct the value of the
-  // swept edge region from
-  const int sweep_subcell_index =
-      (is_outflux ? subcell_index : subcell_neighbour_index);
+  return 0;
+}
 
-  /* CALCULATE THE SWEEP SUBCELL GRADIENTS FOR MASS AND ENERGY */
+// Assembles the least squares system for the gradients of a subcell over its
+// neighbours into a slot of a batch, with the bounds of its neighbourhood
+void calc_gradient_system(
+    const int subcell_index, const int slot, const int stride,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    const double* subcell_centroids_x, const double* subcell_centroids_y,
+    const double* subcell_centroids_z, const double* subcell_volume,
+    const double* subcell_mass, const double* subcell_ie_mass,
+    const double* subcell_ke_mass, const double* subcell_momentum_x,
+    const double* subcell_momentum_y, const double* subcell_momentum_z,
+    double* batch_coeff, double* batch_rhs, double* batch_gmax,
+    double* batch_gmin) {
 
-  vec_t inv[3] = {{0.0, 0.0, 0.0}};
   vec_t coeff[3] = {{0.0, 0.0, 0.0}};
   vec_t m_rhs = {0.0, 0.0, 0.0};
   vec_t ie_rhs = {0.0, 0.0, 0.0};
@@ -360,45 +880,40 @@ void flux_mass_energy_momentum(
   double gmax_vz = -DBL_MAX;
   double gmin_vz = DBL_MAX;
 
-  vec_t sweep_subcell_c = {subcell_centroids_x[(sweep_subcell_index)],
-                           subcell_centroids_y[(sweep_subcell_index)],
-                           subcell_centroids_z[(sweep_subcell_index)]};
-
-  const double sweep_subcell_vol = subcell_volume[(sweep_subcell_index)];
-  const double sweep_subcell_density =
-      subcell_mass[(sweep_subcell_index)] / sweep_subcell_vol;
-  const double sweep_subcell_ie_density =
-      subcell_ie_mass[(sweep_subcell_index)] / sweep_subcell_vol;
-  const double sweep_subcell_ke_density =
-      subcell_ke_mass[(sweep_subcell_index)] / sweep_subcell_vol;
-  vec_t subcell_v = {
-      subcell_momentum_x[(sweep_subcell_index)] / sweep_subcell_vol,
-      subcell_momentum_y[(sweep_subcell_index)] / sweep_subcell_vol,
-      subcell_momentum_z[(sweep_subcell_index)] / sweep_subcell_vol};
-
-  const int sweep_subcell_to_subcells_off =
-      subcells_to_subcells_offsets[(sweep_subcell_index)];
+  vec_t subcell_c = {subcell_centroids_x[(subcell_index)],
+                     subcell_centroids_y[(subcell_index)],
+                     subcell_centroids_z[(subcell_index)]};
+
+  const double subcell_vol = subcell_volume[(subcell_index)];
+  const double subcell_density = subcell_mass[(subcell_index)] / subcell_vol;
+  const double subcell_ie_density =
+      subcell_ie_mass[(subcell_index)] / subcell_vol;
+  const double subcell_ke_density =
+      subcell_ke_mass[(subcell_index)] / subcell_vol;
+  vec_t subcell_v = {subcell_momentum_x[(subcell_index)] / subcell_vol,
+                     subcell_momentum_y[(subcell_index)] / subcell_vol,
+                     subcell_momentum_z[(subcell_index)] / subcell_vol};
+
+  const int subcell_to_subcells_off =
+      subcells_to_subcells_offsets[(subcell_index)];
   const int nsubcell_neighbours =
-      subcells_to_subcells_offsets[(sweep_subcell_index + 1)] -
-      sweep_subcell_to_subcells_off;
+      subcells_to_subcells_offsets[(subcell_index + 1)] -
+      subcell_to_subcells_off;
 
   for (int ss = 0; ss < nsubcell_neighbours; ++ss) {
-    const int sweep_neighbour_index =
-        subcells_to_subcells[(sweep_subcell_to_subcells_off + ss)];
+    const int neighbour_index =
+        subcells_to_subcells[(subcell_to_subcells_off + ss)];
 
     // Ignore boundary neighbours
-    if (sweep_neighbour_index == -1) {
+    if (neighbour_index == -1) {
       continue;
     }
 
-    const double neighbour_vol = subcell_volume[(sweep_neighbour_index)];
+    const double neighbour_vol = subcell_volume[(neighbour_index)];
     vec_t i = {
-        (subcell_centroids_x[(sweep_neighbour_index)] - sweep_subcell_c.x) *
-            neighbour_vol,
-        (subcell_centroids_y[(sweep_neighbour_index)] - sweep_subcell_c.y) *
-            neighbour_vol,
-        (subcell_centroids_z[(sweep_neighbour_index)] - sweep_subcell_c.z) *
-            neighbour_vol};
+        (subcell_centroids_x[(neighbour_index)] - subcell_c.x) * neighbour_vol,
+        (subcell_centroids_y[(neighbour_index)] - subcell_c.y) * neighbour_vol,
+        (subcell_centroids_z[(neighbour_index)] - subcell_c.z) * neighbour_vol};
 
     // Store the neighbouring cell's contribution to the coefficients
     coeff[0].x += 2.0 * (i.x * i.x) / (neighbour_vol * neighbour_vol);
@@ -413,23 +928,23 @@ void flux_mass_energy_momentum(
 
     // Get subcell quantities of neighbouring subcell
     const double neighbour_m_density =
-        subcell_mass[(sweep_neighbour_index)] / neighbour_vol;
+        subcell_mass[(neighbour_index)] / neighbour_vol;
     const double neighbour_ie_density =
-        subcell_ie_mass[(sweep_neighbour_index)] / neighbour_vol;
+        subcell_ie_mass[(neighbour_index)] / neighbour_vol;
     const double neighbour_ke_density =
-        subcell_ke_mass[(sweep_neighbour_index)] / neighbour_vol;
+        subcell_ke_mass[(neighbour_index)] / neighbour_vol;
     vec_t neighbour_v = {
-        subcell_momentum_x[(sweep_neighbour_index)] / neighbour_vol,
-        subcell_momentum_y[(sweep_neighbour_index)] / neighbour_vol,
-        subcell_momentum_z[(sweep_neighbour_index)] / neighbour_vol};
+        subcell_momentum_x[(neighbour_index)] / neighbour_vol,
+        subcell_momentum_y[(neighbour_index)] / neighbour_vol,
+        subcell_momentum_z[(neighbour_index)] / neighbour_vol};
 
     // Determine differentials for subcell quantities
     const double dneighbour_m_density =
-        neighbour_m_density - sweep_subcell_density;
+        neighbour_m_density - subcell_density;
     const double dneighbour_ie_density =
-        neighbour_ie_density - sweep_subcell_ie_density;
+        neighbour_ie_density - subcell_ie_density;
     const double dneighbour_ke_density =
-        neighbour_ke_density - sweep_subcell_ke_density;
+        neighbour_ke_density - subcell_ke_density;
     const double dneighbour_vx = (neighbour_v.x - subcell_v.x);
     const double dneighbour_vy = (neighbour_v.y - subcell_v.y);
     const double dneighbour_vz = (neighbour_v.z - subcell_v.z);
@@ -469,195 +984,436 @@ void flux_mass_energy_momentum(
     gmin_vz = min(gmin_vz, neighbour_v.z);
   }
 
-  calc_3x3_inverse(&coeff, &inv);
-
-  // Calculate the gradients
-  vec_t grad_m = {inv[0].x * m_rhs.x + inv[0].y * m_rhs.y + inv[0].z * m_rhs.z,
-                  inv[1].x * m_rhs.x + inv[1].y * m_rhs.y + inv[1].z * m_rhs.z,
-                  inv[2].x * m_rhs.x + inv[2].y * m_rhs.y + inv[2].z * m_rhs.z};
-  vec_t grad_ie = {
-      inv[0].x * ie_rhs.x + inv[0].y * ie_rhs.y + inv[0].z * ie_rhs.z,
-      inv[1].x * ie_rhs.x + inv[1].y * ie_rhs.y + inv[1].z * ie_rhs.z,
-      inv[2].x * ie_rhs.x + inv[2].y * ie_rhs.y + inv[2].z * ie_rhs.z};
-  vec_t grad_ke = {
-      inv[0].x * ke_rhs.x + inv[0].y * ke_rhs.y + inv[0].z * ke_rhs.z,
-      inv[1].x * ke_rhs.x + inv[1].y * ke_rhs.y + inv[1].z * ke_rhs.z,
-      inv[2].x * ke_rhs.x + inv[2].y * ke_rhs.y + inv[2].z * ke_rhs.z};
-  vec_t grad_vx = {
-      inv[0].x * vx_rhs.x + inv[0].y * vx_rhs.y + inv[0].z * vx_rhs.z,
-      inv[1].x * vx_rhs.x + inv[1].y * vx_rhs.y + inv[1].z * vx_rhs.z,
-      inv[2].x * vx_rhs.x + inv[2].y * vx_rhs.y + inv[2].z * vx_rhs.z};
-  vec_t grad_vy = {
-      inv[0].x * vy_rhs.x + inv[0].y * vy_rhs.y + inv[0].z * vy_rhs.z,
-      inv[1].x * vy_rhs.x + inv[1].y * vy_rhs.y + inv[1].z * vy_rhs.z,
-      inv[2].x * vy_rhs.x + inv[2].y * vy_rhs.y + inv[2].z * vy_rhs.z};
-  vec_t grad_vz = {
-      inv[0].x * vz_rhs.x + inv[0].y * vz_rhs.y + inv[0].z * vz_rhs.z,
-      inv[1].x * vz_rhs.x + inv[1].y * vz_rhs.y + inv[1].z * vz_rhs.z,
-      inv[2].x * vz_rhs.x + inv[2].y * vz_rhs.y + inv[2].z * vz_rhs.z};
+  store_sym_3x3_system(slot, stride, coeff, batch_coeff);
+  store_3x3_rhs(slot, stride, 0, &m_rhs, batch_rhs);
+  store_3x3_rhs(slot, stride, 1, &ie_rhs, batch_rhs);
+  store_3x3_rhs(slot, stride, 2, &ke_rhs, batch_rhs);
+  store_3x3_rhs(slot, stride, 3, &vx_rhs, batch_rhs);
+  store_3x3_rhs(slot, stride, 4, &vy_rhs, batch_rhs);
+  store_3x3_rhs(slot, stride, 5, &vz_rhs, batch_rhs);
+
+  batch_gmax[(0 * stride + slot)] = gmax_m;
+  batch_gmin[(0 * stride + slot)] = gmin_m;
+  batch_gmax[(1 * stride + slot)] = gmax_ie;
+  batch_gmin[(1 * stride + slot)] = gmin_ie;
+  batch_gmax[(2 * stride + slot)] = gmax_ke;
+  batch_gmin[(2 * stride + slot)] = gmin_ke;
+  batch_gmax[(3 * stride + slot)] = gmax_vx;
+  batch_gmin[(3 * stride + slot)] = gmin_vx;
+  batch_gmax[(4 * stride + slot)] = gmax_vy;
+  batch_gmin[(4 * stride + slot)] = gmin_vy;
+  batch_gmax[(5 * stride + slot)] = gmax_vz;
+  batch_gmin[(5 * stride + slot)] = gmin_vz;
+}
 
-  /* LIMIT THE GRADIENT */
+// Solves a batch of subcell gradient systems, and limits each of the gradients
+// at the subcell's node, cell centre, face centres and half edges
+void limit_batch_gradients(
+    const int nsolves, const int* batch_subcells, const vec_t* cell_c,
+    const double* nodes_x, const double* nodes_y, const double* nodes_z,
+    const int* cells_to_nodes, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* subcells_to_faces_offsets,
+    const int* subcells_to_faces, const int* subcell_face_rnodes,
+    const double* subcell_centroids_x, const double* subcell_centroids_y,
+    const double* subcell_centroids_z, const double* subcell_volume,
+    const double* subcell_mass, const double* subcell_ie_mass,
+    const double* subcell_ke_mass, const double* subcell_momentum_x,
+    const double* subcell_momentum_y, const double* subcell_momentum_z,
+    const double* batch_coeff, double* batch_rhs, const double* batch_gmax,
+    const double* batch_gmin, double* subcell_grad_m_x,
+    double* subcell_grad_m_y, double* subcell_grad_m_z,
+    double* subcell_grad_ie_x, double* subcell_grad_ie_y,
+    double* subcell_grad_ie_z, double* subcell_grad_ke_x,
+    double* subcell_grad_ke_y, double* subcell_grad_ke_z,
+    double* subcell_grad_vx_x, double* subcell_grad_vx_y,
+    double* subcell_grad_vx_z, double* subcell_grad_vy_x,
+    double* subcell_grad_vy_y, double* subcell_grad_vy_z,
+    double* subcell_grad_vz_x, double* subcell_grad_vz_y,
+    double* subcell_grad_vz_z) {
+
+  solve_sym_3x3_batch(nsolves, NSOLVES_BY_BATCH, NGRADIENTS_BY_SUBCELL,
+                      batch_coeff, batch_rhs);
+
+  for (int ss = 0; ss < nsolves; ++ss) {
+    limit_subcell_gradients(
+        batch_subcells[(ss)], ss, NSOLVES_BY_BATCH, cell_c, nodes_x, nodes_y,
+        nodes_z, cells_to_nodes, faces_to_nodes_offsets, faces_to_nodes,
+        subcells_to_faces_offsets, subcells_to_faces, subcell_face_rnodes,
+        subcell_centroids_x, subcell_centroids_y, subcell_centroids_z,
+        subcell_volume, subcell_mass, subcell_ie_mass, subcell_ke_mass,
+        subcell_momentum_x, subcell_momentum_y, subcell_momentum_z, batch_rhs,
+        batch_gmax, batch_gmin, subcell_grad_m_x, subcell_grad_m_y,
+        subcell_grad_m_z, subcell_grad_ie_x, subcell_grad_ie_y,
+        subcell_grad_ie_z, subcell_grad_ke_x, subcell_grad_ke_y,
+        subcell_grad_ke_z, subcell_grad_vx_x, subcell_grad_vx_y,
+        subcell_grad_vx_z, subcell_grad_vy_x, subcell_grad_vy_y,
+        subcell_grad_vy_z, subcell_grad_vz_x, subcell_grad_vz_y,
+        subcell_grad_vz_z);
+  }
+}
 
-  // Performing the limiting actually requires the sweep subcell's nodes
-  double m_limiter = 1.0;
-  double ie_limiter = 1.0;
-  double ke_limiter = 1.0;
-  double vx_limiter = 1.0;
-  double vy_limiter = 1.0;
-  double vz_limiter = 1.0;
+// Limits the solved gradients of the subcell in a slot of a batch at the
+// subcell's node, cell centre, face centres and half edges
+void limit_subcell_gradients(
+    const int subcell_index, const int slot, const int stride,
+    const vec_t* cell_c, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, const int* cells_to_nodes,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+    const int* subcells_to_faces_offsets, const int* subcells_to_faces,
+    const int* subcell_face_rnodes, const double* subcell_centroids_x,
+    const double* subcell_centroids_y, const double* subcell_centroids_z,
+    const double* subcell_volume, const double* subcell_mass,
+    const double* subcell_ie_mass, const double* subcell_ke_mass,
+    const double* subcell_momentum_x, const double* subcell_momentum_y,
+    const double* subcell_momentum_z, const double* batch_solution,
+    const double* batch_gmax, const double* batch_gmin,
+    double* subcell_grad_m_x, double* subcell_grad_m_y,
+    double* subcell_grad_m_z, double* subcell_grad_ie_x,
+    double* subcell_grad_ie_y, double* subcell_grad_ie_z,
+    double* subcell_grad_ke_x, double* subcell_grad_ke_y,
+    double* subcell_grad_ke_z, double* subcell_grad_vx_x,
+    double* subcell_grad_vx_y, double* subcell_grad_vx_z,
+    double* subcell_grad_vy_x, double* subcell_grad_vy_y,
+    double* subcell_grad_vy_z, double* subcell_grad_vz_x,
+    double* subcell_grad_vz_y, double* subcell_grad_vz_z) {
+
+  vec_t subcell_c = {subcell_centroids_x[(subcell_index)],
+                     subcell_centroids_y[(subcell_index)],
+                     subcell_centroids_z[(subcell_index)]};
+
+  // The mass, energies and velocities occupy the lanes of the limiter in the
+  // order of their right hand sides, and the padding lanes are left at rest
+  const double subcell_vol = subcell_volume[(subcell_index)];
+  double phi[NFIELDS_BY_LIMITER] = {
+      subcell_mass[(subcell_index)] / subcell_vol,
+      subcell_ie_mass[(subcell_index)] / subcell_vol,
+      subcell_ke_mass[(subcell_index)] / subcell_vol,
+      subcell_momentum_x[(subcell_index)] / subcell_vol,
+      subcell_momentum_y[(subcell_index)] / subcell_vol,
+      subcell_momentum_z[(subcell_index)] / subcell_vol};
+
+  double gmax[NFIELDS_BY_LIMITER] = {0.0};
+  double gmin[NFIELDS_BY_LIMITER] = {0.0};
+  double grad_x[NFIELDS_BY_LIMITER] = {0.0};
+  double grad_y[NFIELDS_BY_LIMITER] = {0.0};
+  double grad_z[NFIELDS_BY_LIMITER] = {0.0};
+  double limiters[NFIELDS_BY_LIMITER];
+  for (int ff = 0; ff < NFIELDS_BY_LIMITER; ++ff) {
+    limiters[(ff)] = 1.0;
+  }
+  for (int ff = 0; ff < NGRADIENTS_BY_SUBCELL; ++ff) {
+    vec_t grad = load_3x3_solution(slot, stride, ff, batch_solution);
+    grad_x[(ff)] = grad.x;
+    grad_y[(ff)] = grad.y;
+    grad_z[(ff)] = grad.z;
+    gmax[(ff)] = batch_gmax[(ff * stride + slot)];
+    gmin[(ff)] = batch_gmin[(ff * stride + slot)];
+  }
+
+  /* LIMIT THE GRADIENT */
 
-  const int sweep_subcell_to_faces_off =
-      subcells_to_faces_offsets[(sweep_subcell_index)];
-  const int nfaces_by_sweep_subcell =
-      subcells_to_faces_offsets[(sweep_subcell_index + 1)] -
-      sweep_subcell_to_faces_off;
+  // Performing the limiting actually requires the subcell's nodes
+  const int subcell_to_faces_off = subcells_to_faces_offsets[(subcell_index)];
+  const int nfaces_by_subcell =
+      subcells_to_faces_offsets[(subcell_index + 1)] - subcell_to_faces_off;
 
   // Limit at node
-  const int sweep_node_index = cells_to_nodes[(sweep_subcell_index)];
-  vec_t sweep_node = {nodes_x[(sweep_node_index)], nodes_y[(sweep_node_index)],
-                      nodes_z[(sweep_node_index)]};
-
-  limit_mass_gradients(
-      sweep_node, &sweep_subcell_c, sweep_subcell_density,
-      sweep_subcell_ie_density, sweep_subcell_ke_density, subcell_v.x,
-      subcell_v.y, subcell_v.z, gmax_m, gmin_m, gmax_ie, gmin_ie, gmax_ke,
-      gmin_ke, gmax_vx, gmin_vx, gmax_vy, gmin_vy, gmax_vz, gmin_vz, &grad_m,
-      &grad_ie, &grad_ke, &grad_vx, &grad_vy, &grad_vz, &m_limiter, &ie_limiter,
-      &ke_limiter, &vx_limiter, &vy_limiter, &vz_limiter);
-
-  vec_t sweep_cell_c;
-  if (internal || is_outflux) {
-    sweep_cell_c = *cell_c;
-  } else {
-    // Faster or slower than accessing cell_centroids_... ?
-    const int cell_to_nodes_off = cells_to_nodes_offsets[(neighbour_cc)];
-    const int nnodes_by_cell =
-        cells_to_nodes_offsets[(neighbour_cc + 1)] - cell_to_nodes_off;
-    calc_centroid(nnodes_by_cell, nodes_x, nodes_y, nodes_z, cells_to_nodes,
-                  cell_to_nodes_off, &sweep_cell_c);
-  }
+  const int node_index = cells_to_nodes[(subcell_index)];
+  vec_t node = {nodes_x[(node_index)], nodes_y[(node_index)],
+                nodes_z[(node_index)]};
+  limit_field_gradients(&node, &subcell_c, phi, gmax, gmin, grad_x, grad_y,
+                        grad_z, limiters);
 
   // Limit at cell center
-  limit_mass_gradients(
-      sweep_cell_c, &sweep_subcell_c, sweep_subcell_density,
-      sweep_subcell_ie_density, sweep_subcell_ke_density, subcell_v.x,
-      subcell_v.y, subcell_v.z, gmax_m, gmin_m, gmax_ie, gmin_ie, gmax_ke,
-      gmin_ke, gmax_vx, gmin_vx, gmax_vy, gmin_vy, gmax_vz, gmin_vz, &grad_m,
-      &grad_ie, &grad_ke, &grad_vx, &grad_vy, &grad_vz, &m_limiter, &ie_limiter,
-      &ke_limiter, &vx_limiter, &vy_limiter, &vz_limiter);
+  limit_field_gradients(cell_c, &subcell_c, phi, gmax, gmin, grad_x, grad_y,
+                        grad_z, limiters);
 
   // Limit at half edges and face centers
-  for (int ff2 = 0; ff2 < nfaces_by_sweep_subcell; ++ff2) {
-    const int sweep_face_index =
-        subcells_to_faces[(sweep_subcell_to_faces_off + ff)];
-    const int sweep_face_to_nodes_off =
-        faces_to_nodes_offsets[(sweep_face_index)];
-    const int nnodes_by_sweep_face =
-        faces_to_nodes_offsets[(sweep_face_index + 1)] -
-        sweep_face_to_nodes_off;
+  for (int ff2 = 0; ff2 < nfaces_by_subcell; ++ff2) {
+    const int face_index = subcells_to_faces[(subcell_to_faces_off + ff2)];
+    const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
+    const int nnodes_by_face =
+        faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
 
     // The face centroid is the same for all nodes on the face
-    vec_t sweep_face_c = {0.0, 0.0, 0.0};
-    calc_centroid(nnodes_by_sweep_face, nodes_x, nodes_y, nodes_z,
-                  faces_to_nodes, sweep_face_to_nodes_off, &sweep_face_c);
-
-    limit_mass_gradients(
-        sweep_face_c, &sweep_subcell_c, sweep_subcell_density,
-        sweep_subcell_ie_density, sweep_subcell_ke_density, subcell_v.x,
-        subcell_v.y, subcell_v.z, gmax_m, gmin_m, gmax_ie, gmin_ie, gmax_ke,
-        gmin_ke, gmax_vx, gmin_vx, gmax_vy, gmin_vy, gmax_vz, gmin_vz, &grad_m,
-        &grad_ie, &grad_ke, &grad_vx, &grad_vy, &grad_vz, &m_limiter,
-        &ie_limiter, &ke_limiter, &vx_limiter, &vy_limiter, &vz_limiter);
-
-    // Determine the position of the node in the face list of nodes
-    int nn2;
-    for (nn2 = 0; nn2 < nnodes_by_sweep_face; ++nn2) {
-      if (faces_to_nodes[(sweep_face_to_nodes_off + nn2)] == sweep_node_index) {
-        break;
-      }
-    }
+    vec_t face_c = {0.0, 0.0, 0.0};
+    calc_centroid(nnodes_by_face, nodes_x, nodes_y, nodes_z, faces_to_nodes,
+                  face_to_nodes_off, &face_c);
+    limit_field_gradients(&face_c, &subcell_c, phi, gmax, gmin, grad_x, grad_y,
+                          grad_z, limiters);
 
-    const int next_node = (nn2 == nnodes_by_sweep_face - 1) ? 0 : nn2 + 1;
-    const int prev_node = (nn2 == 0) ? nnodes_by_sweep_face - 1 : nn2 - 1;
-    const int face_clockwise =
-        (faces_cclockwise_cell[(sweep_face_index)] != cc);
-    const int rnode_off = (face_clockwise ? prev_node : next_node);
-    const int rnode_index =
-        faces_to_nodes[(sweep_face_to_nodes_off + rnode_off)];
+    const int rnode_index = subcell_face_rnodes[(subcell_to_faces_off + ff2)];
 
     // Get the halfway point on the right edge
-    vec_t half_edge = {0.5 * (sweep_node.x + nodes_x[(rnode_index)]),
-                       0.5 * (sweep_node.y + nodes_y[(rnode_index)]),
-                       0.5 * (sweep_node.z + nodes_z[(rnode_index)])};
-
-    // Limit at cell center
-    limit_mass_gradients(
-        half_edge, &sweep_subcell_c, sweep_subcell_density,
-        sweep_subcell_ie_density, sweep_subcell_ke_density, subcell_v.x,
-        subcell_v.y, subcell_v.z, gmax_m, gmin_m, gmax_ie, gmin_ie, gmax_ke,
-        gmin_ke, gmax_vx, gmin_vx, gmax_vy, gmin_vy, gmax_vz, gmin_vz, &grad_m,
-        &grad_ie, &grad_ke, &grad_vx, &grad_vy, &grad_vz, &m_limiter,
-        &ie_limiter, &ke_limiter, &vx_limiter, &vy_limiter, &vz_limiter);
-  }
-
-  grad_m.x *= m_limiter;
-  grad_m.y *= m_limiter;
-  grad_m.z *= m_limiter;
-  grad_ie.x *= ie_limiter;
-  grad_ie.y *= ie_limiter;
-  grad_ie.z *= ie_limiter;
-  grad_ke.x *= ke_limiter;
-  grad_ke.y *= ke_limiter;
-  grad_ke.z *= ke_limiter;
-  grad_vx.x *= vx_limiter;
-  grad_vx.y *= vx_limiter;
-  grad_vx.z *= vx_limiter;
-  grad_vy.x *= vy_limiter;
-  grad_vy.y *= vy_limiter;
-  grad_vy.z *= vy_limiter;
-  grad_vz.x *= vz_limiter;
-  grad_vz.y *= vz_limiter;
-  grad_vz.z *= vz_limiter;
-
-  const double dx = swept_edge_c.x - sweep_subcell_c.x;
-  const double dy = swept_edge_c.y - sweep_subcell_c.y;
-  const double dz = swept_edge_c.z - sweep_subcell_c.z;
-
-  // Calculate the fluxes for the different quantities
-  const double local_mass_flux =
-      swept_edge_vol *
-      (sweep_subcell_density + grad_m.x * dx + grad_m.y * dy + grad_m.z * dz);
-  const double local_ie_flux =
-      swept_edge_vol * (sweep_subcell_ie_density + grad_ie.x * dx +
-                        grad_ie.y * dy + grad_ie.z * dz);
-  const double local_ke_flux =
-      swept_edge_vol * (sweep_subcell_ke_density + grad_ke.x * dx +
-                        grad_ke.y * dy + grad_ke.z * dz);
-  const double local_x_momentum_flux =
-      swept_edge_vol *
-      (subcell_v.x + grad_vx.x * dx + grad_vx.y * dy + grad_vx.z * dz);
-  const double local_y_momentum_flux =
-      swept_edge_vol *
-      (subcell_v.y + grad_vy.x * dx + grad_vy.y * dy + grad_vy.z * dz);
-  const double local_z_momentum_flux =
-      swept_edge_vol *
-      (subcell_v.z + grad_vz.x * dx + grad_vz.y * dy + grad_vz.z * dz);
-
-  // Mass and energy are either flowing into or out of the subcell
-  if (is_outflux) {
-    subcell_mass_flux[(subcell_index)] += local_mass_flux;
-    subcell_ie_mass_flux[(subcell_index)] += local_ie_flux;
-    subcell_ke_mass_flux[(subcell_index)] += local_ke_flux;
-    subcell_momentum_flux_x[(subcell_index)] += local_x_momentum_flux;
-    subcell_momentum_flux_y[(subcell_index)] += local_y_momentum_flux;
-    subcell_momentum_flux_z[(subcell_index)] += local_z_momentum_flux;
-  } else {
-    subcell_mass_flux[(subcell_index)] -= local_mass_flux;
-    subcell_ie_mass_flux[(subcell_index)] -= local_ie_flux;
-    subcell_ke_mass_flux[(subcell_index)] -= local_ke_flux;
-    subcell_momentum_flux_x[(subcell_index)] -= local_x_momentum_flux;
-    subcell_momentum_flux_y[(subcell_index)] -= local_y_momentum_flux;
-    subcell_momentum_flux_z[(subcell_index)] -= local_z_momentum_flux;
+    vec_t half_edge = {0.5 * (node.x + nodes_x[(rnode_index)]),
+                       0.5 * (node.y + nodes_y[(rnode_index)]),
+                       0.5 * (node.z + nodes_z[(rnode_index)])};
+    limit_field_gradients(&half_edge, &subcell_c, phi, gmax, gmin, grad_x,
+                          grad_y, grad_z, limiters);
+  }
+
+  // Store the limited gradients
+  subcell_grad_m_x[(subcell_index)] = grad_x[(0)] * limiters[(0)];
+  subcell_grad_m_y[(subcell_index)] = grad_y[(0)] * limiters[(0)];
+  subcell_grad_m_z[(subcell_index)] = grad_z[(0)] * limiters[(0)];
+  subcell_grad_ie_x[(subcell_index)] = grad_x[(1)] * limiters[(1)];
+  subcell_grad_ie_y[(subcell_index)] = grad_y[(1)] * limiters[(1)];
+  subcell_grad_ie_z[(subcell_index)] = grad_z[(1)] * limiters[(1)];
+  subcell_grad_ke_x[(subcell_index)] = grad_x[(2)] * limiters[(2)];
+  subcell_grad_ke_y[(subcell_index)] = grad_y[(2)] * limiters[(2)];
+  subcell_grad_ke_z[(subcell_index)] = grad_z[(2)] * limiters[(2)];
+  subcell_grad_vx_x[(subcell_index)] = grad_x[(3)] * limiters[(3)];
+  subcell_grad_vx_y[(subcell_index)] = grad_y[(3)] * limiters[(3)];
+  subcell_grad_vx_z[(subcell_index)] = grad_z[(3)] * limiters[(3)];
+  subcell_grad_vy_x[(subcell_index)] = grad_x[(4)] * limiters[(4)];
+  subcell_grad_vy_y[(subcell_index)] = grad_y[(4)] * limiters[(4)];
+  subcell_grad_vy_z[(subcell_index)] = grad_z[(4)] * limiters[(4)];
+  subcell_grad_vz_x[(subcell_index)] = grad_x[(5)] * limiters[(5)];
+  subcell_grad_vz_y[(subcell_index)] = grad_y[(5)] * limiters[(5)];
+  subcell_grad_vz_z[(subcell_index)] = grad_z[(5)] * limiters[(5)];
+}
+
+// Calculates the mass, energy and momentum fluxes through the non-empty sweeps
+// of each cell, out of the subcell that owns each sweep
+void calc_sweep_fluxes(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    const double* subcell_centroids_x, const double* subcell_centroids_y,
+    const double* subcell_centroids_z, const int* cells_nsweeps,
+    const int* sweep_subcells, const int* sweep_slots, const int* sweep_outflux,
+    const double* sweep_volumes, const double* sweep_centroids_x,
+    const double* sweep_centroids_y, const double* sweep_centroids_z,
+    const double* subcell_volume, const double* subcell_momentum_x,
+    const double* subcell_momentum_y, const double* subcell_momentum_z,
+    const double* subcell_mass, const double* subcell_ie_mass,
+    const double* subcell_ke_mass, const double* subcell_grad_m_x,
+    const double* subcell_grad_m_y, const double* subcell_grad_m_z,
+    const double* subcell_grad_ie_x, const double* subcell_grad_ie_y,
+    const double* subcell_grad_ie_z, const double* subcell_grad_ke_x,
+    const double* subcell_grad_ke_y, const double* subcell_grad_ke_z,
+    const double* subcell_grad_vx_x, const double* subcell_grad_vx_y,
+    const double* subcell_grad_vx_z, const double* subcell_grad_vy_x,
+    const double* subcell_grad_vy_y, const double* subcell_grad_vy_z,
+    const double* subcell_grad_vz_x, const double* subcell_grad_vz_y,
+    const double* subcell_grad_vz_z, double* sweep_mass_flux,
+    double* sweep_ie_flux, double* sweep_ke_flux,
+    double* sweep_momentum_flux_x, double* sweep_momentum_flux_y,
+    double* sweep_momentum_flux_z) {
+
+#pragma omp parallel for
+  for (int cc = 0; cc < ncells; ++cc) {
+    const int cell_sweeps_off =
+        subcells_to_subcells_offsets[(cells_to_nodes_offsets[(cc)])];
+    const int nsweeps = cells_nsweeps[(cc)];
+
+    // The reconstructions of the sweeps are independent, so they are
+    // evaluated across lanes
+#pragma omp simd
+    for (int ss = 0; ss < nsweeps; ++ss) {
+      const int sweep_index = cell_sweeps_off + ss;
+      const int subcell_index = sweep_subcells[(sweep_index)];
+
+      // Depending upon which subcell we are sweeping into, choose the
+      // subcell index with which to reconstruct the density
+      const int subcell_neighbour_index =
+          subcells_to_subcells[(subcells_to_subcells_offsets[(subcell_index)] +
+                                sweep_slots[(sweep_index)])];
+
+      // The sweep subcell index is where we will reconstruct the value of
+      // the swept edge region from
+      const int is_outflux = sweep_outflux[(sweep_index)];
+      const int sweep_subcell_index =
+          (is_outflux ? subcell_index : subcell_neighbour_index);
+
+      // The flux leaves the owning subcell when the sweep is an outflux
+      const double swept_edge_vol =
+          (is_outflux ? 1.0 : -1.0) * sweep_volumes[(sweep_index)];
+      const double sweep_subcell_vol = subcell_volume[(sweep_subcell_index)];
+      const double sweep_subcell_density =
+          subcell_mass[(sweep_subcell_index)] / sweep_subcell_vol;
+      const double sweep_subcell_ie_density =
+          subcell_ie_mass[(sweep_subcell_index)] / sweep_subcell_vol;
+      const double sweep_subcell_ke_density =
+          subcell_ke_mass[(sweep_subcell_index)] / sweep_subcell_vol;
+      vec_t subcell_v = {
+          subcell_momentum_x[(sweep_subcell_index)] / sweep_subcell_vol,
+          subcell_momentum_y[(sweep_subcell_index)] / sweep_subcell_vol,
+          subcell_momentum_z[(sweep_subcell_index)] / sweep_subcell_vol};
+
+      const double dx = sweep_centroids_x[(sweep_index)] -
+                        subcell_centroids_x[(sweep_subcell_index)];
+      const double dy = sweep_centroids_y[(sweep_index)] -
+                        subcell_centroids_y[(sweep_subcell_index)];
+      const double dz = sweep_centroids_z[(sweep_index)] -
+                        subcell_centroids_z[(sweep_subcell_index)];
+
+      // Calculate the fluxes for the different quantities
+      sweep_mass_flux[(sweep_index)] =
+          swept_edge_vol * (sweep_subcell_density +
+                            subcell_grad_m_x[(sweep_subcell_index)] * dx +
+                            subcell_grad_m_y[(sweep_subcell_index)] * dy +
+                            subcell_grad_m_z[(sweep_subcell_index)] * dz);
+      sweep_ie_flux[(sweep_index)] =
+          swept_edge_vol * (sweep_subcell_ie_density +
+                            subcell_grad_ie_x[(sweep_subcell_index)] * dx +
+                            subcell_grad_ie_y[(sweep_subcell_index)] * dy +
+                            subcell_grad_ie_z[(sweep_subcell_index)] * dz);
+      sweep_ke_flux[(sweep_index)] =
+          swept_edge_vol * (sweep_subcell_ke_density +
+                            subcell_grad_ke_x[(sweep_subcell_index)] * dx +
+                            subcell_grad_ke_y[(sweep_subcell_index)] * dy +
+                            subcell_grad_ke_z[(sweep_subcell_index)] * dz);
+      sweep_momentum_flux_x[(sweep_index)] =
+          swept_edge_vol * (subcell_v.x +
+                            subcell_grad_vx_x[(sweep_subcell_index)] * dx +
+                            subcell_grad_vx_y[(sweep_subcell_index)] * dy +
+                            subcell_grad_vx_z[(sweep_subcell_index)] * dz);
+      sweep_momentum_flux_y[(sweep_index)] =
+          swept_edge_vol * (subcell_v.y +
+                            subcell_grad_vy_x[(sweep_subcell_index)] * dx +
+                            subcell_grad_vy_y[(sweep_subcell_index)] * dy +
+                            subcell_grad_vy_z[(sweep_subcell_index)] * dz);
+      sweep_momentum_flux_z[(sweep_index)] =
+          swept_edge_vol * (subcell_v.z +
+                            subcell_grad_vz_x[(sweep_subcell_index)] * dx +
+                            subcell_grad_vz_y[(sweep_subcell_index)] * dy +
+                            subcell_grad_vz_z[(sweep_subcell_index)] * dz);
+    }
+  }
+}
+
+// Calculates the first order mass, energy and momentum fluxes through the
+// non-empty sweeps of each cell, at the mean densities of the donor subcell
+void calc_donor_sweep_fluxes(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    const int* cells_nsweeps, const int* sweep_subcells,
+    const int* sweep_slots, const int* sweep_outflux,
+    const double* sweep_volumes, const double* subcell_volume,
+    const double* subcell_momentum_x, const double* subcell_momentum_y,
+    const double* subcell_momentum_z, const double* subcell_mass,
+    const double* subcell_ie_mass, const double* subcell_ke_mass,
+    double* sweep_mass_flux, double* sweep_ie_flux, double* sweep_ke_flux,
+    double* sweep_momentum_flux_x, double* sweep_momentum_flux_y,
+    double* sweep_momentum_flux_z) {
+
+#pragma omp parallel for
+  for (int cc = 0; cc < ncells; ++cc) {
+    const int cell_sweeps_off =
+        subcells_to_subcells_offsets[(cells_to_nodes_offsets[(cc)])];
+    const int nsweeps = cells_nsweeps[(cc)];
+
+#pragma omp simd
+    for (int ss = 0; ss < nsweeps; ++ss) {
+      const int sweep_index = cell_sweeps_off + ss;
+      const int subcell_index = sweep_subcells[(sweep_index)];
+
+      // The donor is the owner for an outflux, and the owner's neighbour
+      // across the face otherwise
+      const int is_outflux = sweep_outflux[(sweep_index)];
+      const int donor_index =
+          (is_outflux ? subcell_index
+                      : subcells_to_subcells[(
+                            subcells_to_subcells_offsets[(subcell_index)] +
+                            sweep_slots[(sweep_index)])]);
+
+      // The swept volume carries the donor's mean densities
+      const double swept_fraction = (is_outflux ? 1.0 : -1.0) *
+                                    sweep_volumes[(sweep_index)] /
+                                    subcell_volume[(donor_index)];
+      sweep_mass_flux[(sweep_index)] =
+          swept_fraction * subcell_mass[(donor_index)];
+      sweep_ie_flux[(sweep_index)] =
+          swept_fraction * subcell_ie_mass[(donor_index)];
+      sweep_ke_flux[(sweep_index)] =
+          swept_fraction * subcell_ke_mass[(donor_index)];
+      sweep_momentum_flux_x[(sweep_index)] =
+          swept_fraction * subcell_momentum_x[(donor_index)];
+      sweep_momentum_flux_y[(sweep_index)] =
+          swept_fraction * subcell_momentum_y[(donor_index)];
+      sweep_momentum_flux_z[(sweep_index)] =
+          swept_fraction * subcell_momentum_z[(donor_index)];
+    }
+  }
+}
+
+// Accumulates the fluxes of the sweeps into the subcells, with each sweep
+// adding to the subcell that owns it and subtracting from the other subcell
+// sharing the face. Each subcell only gathers its own fluxes, so there are no
+// races, and the mass, energy and momentum are conserved by construction
+void accumulate_subcell_fluxes(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    const int* subcell_neighbour_slots, const int* cells_active,
+    const int* subcells_to_sweeps, const double* sweep_mass_flux,
+    const double* sweep_ie_flux, const double* sweep_ke_flux,
+    const double* sweep_momentum_flux_x, const double* sweep_momentum_flux_y,
+    const double* sweep_momentum_flux_z, double* subcell_mass_flux,
+    double* subcell_ie_mass_flux, double* subcell_ke_mass_flux,
+    double* subcell_momentum_flux_x, double* subcell_momentum_flux_y,
+    double* subcell_momentum_flux_z) {
+
+#pragma omp parallel for
+  for (int cc = 0; cc < ncells; ++cc) {
+    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+    const int nnodes_by_cell =
+        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
+
+    // The faces of an inactive cell are all at rest, so none were swept
+    if (!cells_active[(cc)]) {
+      continue;
+    }
+
+    for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+      const int subcell_index = cell_to_nodes_off + nn;
+      const int subcell_to_subcells_off =
+          subcells_to_subcells_offsets[(subcell_index)];
+      const int nsubcell_neighbours =
+          subcells_to_subcells_offsets[(subcell_index + 1)] -
+          subcell_to_subcells_off;
+
+      for (int ss = 0; ss < nsubcell_neighbours; ++ss) {
+        if (is_sweep_owner(subcell_index, ss, subcells_to_subcells_offsets,
+                           subcells_to_subcells)) {
+          const int sweep_index =
+              subcells_to_sweeps[(subcell_to_subcells_off + ss)];
+          if (sweep_index == -1) {
+            continue;
+          }
+
+          subcell_mass_flux[(subcell_index)] += sweep_mass_flux[(sweep_index)];
+          subcell_ie_mass_flux[(subcell_index)] += sweep_ie_flux[(sweep_index)];
+          subcell_ke_mass_flux[(subcell_index)] += sweep_ke_flux[(sweep_index)];
+          subcell_momentum_flux_x[(subcell_index)] +=
+              sweep_momentum_flux_x[(sweep_index)];
+          subcell_momentum_flux_y[(subcell_index)] +=
+              sweep_momentum_flux_y[(sweep_index)];
+          subcell_momentum_flux_z[(subcell_index)] +=
+              sweep_momentum_flux_z[(sweep_index)];
+          continue;
+        }
+
+        // The face was swept by the neighbour, from its slot for the face
+        const int neighbour_index =
+            subcells_to_subcells[(subcell_to_subcells_off + ss)];
+        const int sweep_index = subcells_to_sweeps[(
+            subcells_to_subcells_offsets[(neighbour_index)] +
+            subcell_neighbour_slots[(subcell_to_subcells_off + ss)])];
+        if (sweep_index == -1) {
+          continue;
+        }
+
+        subcell_mass_flux[(subcell_index)] -= sweep_mass_flux[(sweep_index)];
+        subcell_ie_mass_flux[(subcell_index)] -= sweep_ie_flux[(sweep_index)];
+        subcell_ke_mass_flux[(subcell_index)] -= sweep_ke_flux[(sweep_index)];
+        subcell_momentum_flux_x[(subcell_index)] -=
+            sweep_momentum_flux_x[(sweep_index)];
+        subcell_momentum_flux_y[(subcell_index)] -=
+            sweep_momentum_flux_y[(sweep_index)];
+        subcell_momentum_flux_z[(subcell_index)] -=
+            sweep_momentum_flux_z[(sweep_index)];
+      }
+    }
   }
 }
 
@@ -804,74 +1560,87 @@ void calc_centroid(const int nnodes, const double* nodes_x,
   }
 }
 
-// Calculates the inverse of a 3x3 matrix, out-of-place
-void calc_3x3_inverse(vec_t (*a)[3], vec_t (*inv)[3]) {
-  // Calculate the determinant of the 3x3
-  const double det =
-      (*a)[0].x * ((*a)[1].y * (*a)[2].z - (*a)[1].z * (*a)[2].y) -
-      (*a)[0].y * ((*a)[1].x * (*a)[2].z - (*a)[1].z * (*a)[2].x) +
-      (*a)[0].z * ((*a)[1].x * (*a)[2].y - (*a)[1].y * (*a)[2].x);
-
-  // Check if the matrix is singular
-  if (det == 0.0) {
-    TERMINATE("singular coefficient matrix");
-  } else {
-    // Perform the simple and fast 3x3 matrix inverstion
-    (*inv)[0].x = ((*a)[1].y * (*a)[2].z - (*a)[1].z * (*a)[2].y) / det;
-    (*inv)[0].y = ((*a)[0].z * (*a)[2].y - (*a)[0].y * (*a)[2].z) / det;
-    (*inv)[0].z = ((*a)[0].y * (*a)[1].z - (*a)[0].z * (*a)[1].y) / det;
-
-    (*inv)[1].x = ((*a)[1].z * (*a)[2].x - (*a)[1].x * (*a)[2].z) / det;
-    (*inv)[1].y = ((*a)[0].x * (*a)[2].z - (*a)[0].z * (*a)[2].x) / det;
-    (*inv)[1].z = ((*a)[0].z * (*a)[1].x - (*a)[0].x * (*a)[1].z) / det;
-
-    (*inv)[2].x = ((*a)[1].x * (*a)[2].y - (*a)[1].y * (*a)[2].x) / det;
-    (*inv)[2].y = ((*a)[0].y * (*a)[2].x - (*a)[0].x * (*a)[2].y) / det;
-    (*inv)[2].z = ((*a)[0].x * (*a)[1].y - (*a)[0].y * (*a)[1].x) / det;
+// Solves a batch of symmetric positive semi-definite 3x3 systems in place, with
+// the unique entries xx, xy, xz, yy, yz and zz of system ss at kk * stride + ss
+// and component dd of right hand side rr at (rr * 3 + dd) * stride + ss. A
+// system that is singular relative to its trace is regularised by shifting its
+// diagonal, and a system with no neighbours to fit has a zero solution
+void solve_sym_3x3_batch(const int nsystems, const int stride, const int nrhs,
+                         const double* coeff, double* rhs) {
+
+#pragma omp simd
+  for (int ss = 0; ss < nsystems; ++ss) {
+    const double a_xx = coeff[(0 * stride + ss)];
+    const double a_xy = coeff[(1 * stride + ss)];
+    const double a_xz = coeff[(2 * stride + ss)];
+    const double a_yy = coeff[(3 * stride + ss)];
+    const double a_yz = coeff[(4 * stride + ss)];
+    const double a_zz = coeff[(5 * stride + ss)];
+
+    const double trace = a_xx + a_yy + a_zz;
+    const double a_det = a_xx * (a_yy * a_zz - a_yz * a_yz) -
+                         a_xy * (a_xy * a_zz - a_yz * a_xz) +
+                         a_xz * (a_xy * a_yz - a_yy * a_xz);
+    const double shift =
+        (fabs(a_det) > LSQ_SINGULAR_TOL * trace * trace * trace)
+            ? 0.0
+            : LSQ_REGULARISATION * trace;
+
+    const double xx = a_xx + shift;
+    const double yy = a_yy + shift;
+    const double zz = a_zz + shift;
+    const double det = xx * (yy * zz - a_yz * a_yz) -
+                       a_xy * (a_xy * zz - a_yz * a_xz) +
+                       a_xz * (a_xy * a_yz - yy * a_xz);
+    const int solvable = (det != 0.0);
+    const double safe_det = solvable ? det : 1.0;
+
+    // The inverse is symmetric, so only its unique entries are formed
+    const double inv_xx = solvable ? (yy * zz - a_yz * a_yz) / safe_det : 0.0;
+    const double inv_xy = solvable ? (a_xz * a_yz - a_xy * zz) / safe_det : 0.0;
+    const double inv_xz = solvable ? (a_xy * a_yz - a_xz * yy) / safe_det : 0.0;
+    const double inv_yy = solvable ? (xx * zz - a_xz * a_xz) / safe_det : 0.0;
+    const double inv_yz = solvable ? (a_xz * a_xy - xx * a_yz) / safe_det : 0.0;
+    const double inv_zz = solvable ? (xx * yy - a_xy * a_xy) / safe_det : 0.0;
+
+    for (int rr = 0; rr < nrhs; ++rr) {
+      const int rhs_off = rr * 3 * stride + ss;
+      const double b_x = rhs[(rhs_off)];
+      const double b_y = rhs[(rhs_off + stride)];
+      const double b_z = rhs[(rhs_off + 2 * stride)];
+      rhs[(rhs_off)] = inv_xx * b_x + inv_xy * b_y + inv_xz * b_z;
+      rhs[(rhs_off + stride)] = inv_xy * b_x + inv_yy * b_y + inv_yz * b_z;
+      rhs[(rhs_off + 2 * stride)] = inv_xz * b_x + inv_yz * b_y + inv_zz * b_z;
+    }
   }
 }
 
-// Calculates the local limiter for a cell
-double calc_cell_limiter(const double rho, const double gmax, const double gmin,
-                         vec_t* grad, const double node_x, const double node_y,
-                         const double node_z, const vec_t* cell_c) {
-
-  double g_unlimited = rho + grad->x * (node_x - cell_c->x) +
-                       grad->y * (node_y - cell_c->y) +
-                       grad->z * (node_z - cell_c->z);
+// Stores the unique entries of a symmetric 3x3 system in a slot of a batch
+void store_sym_3x3_system(const int slot, const int stride, const vec_t* a,
+                          double* coeff) {
+  coeff[(0 * stride + slot)] = a[0].x;
+  coeff[(1 * stride + slot)] = a[0].y;
+  coeff[(2 * stride + slot)] = a[0].z;
+  coeff[(3 * stride + slot)] = a[1].y;
+  coeff[(4 * stride + slot)] = a[1].z;
+  coeff[(5 * stride + slot)] = a[2].z;
+}
 
-  double limiter = 1.0;
-  if (g_unlimited - rho > 0.0) {
-    limiter = min(limiter, (gmax - rho) / (g_unlimited - rho));
-  } else if (g_unlimited - rho < 0.0) {
-    limiter = min(limiter, (gmin - rho) / (g_unlimited - rho));
-  }
-  return max(limiter, 0.0);
+// Stores right hand side rr of a slot of a batch of 3x3 systems
+void store_3x3_rhs(const int slot, const int stride, const int rr,
+                   const vec_t* b, double* rhs) {
+  rhs[((rr * 3 + 0) * stride + slot)] = b->x;
+  rhs[((rr * 3 + 1) * stride + slot)] = b->y;
+  rhs[((rr * 3 + 2) * stride + slot)] = b->z;
 }
 
-// Calculates the limiter for the provided gradient
-double apply_cell_limiter(const int nnodes_by_cell, const int cell_to_nodes_off,
-                          const int* cells_to_nodes, vec_t* grad,
-                          const vec_t* cell_c, const double* nodes_x,
-                          const double* nodes_y, const double* nodes_z,
-                          const double rho, const double gmax,
-                          const double gmin) {
-
-  // Calculate the limiter for the gradient
-  double limiter = 1.0;
-  for (int nn = 0; nn < nnodes_by_cell; ++nn) {
-    const int node_index = cells_to_nodes[(cell_to_nodes_off + nn)];
-    limiter = min(limiter, calc_cell_limiter(rho, gmax, gmin, grad,
-                                             nodes_x[(node_index)],
-                                             nodes_y[(node_index)],
-                                             nodes_z[(node_index)], cell_c));
-  }
-
-  grad->x *= limiter;
-  grad->y *= limiter;
-  grad->z *= limiter;
-
-  return limiter;
+// Loads solution rr of a slot of a batch of solved 3x3 systems
+vec_t load_3x3_solution(const int slot, const int stride, const int rr,
+                        const double* rhs) {
+  vec_t x = {rhs[((rr * 3 + 0) * stride + slot)],
+             rhs[((rr * 3 + 1) * stride + slot)],
+             rhs[((rr * 3 + 2) * stride + slot)]};
+  return x;
 }
 
 // Applies the mesh rezoning strategy. This is a pure Eulerian strategy.
@@ -889,39 +1658,27 @@ void apply_mesh_rezoning(const int nnodes, const double* rezoned_nodes_x,
   }
 }
 
-// Limits all of the gradients during flux determination
-void limit_mass_gradients(
-    vec_t nodes, vec_t* sweep_subcell_c, const double sweep_subcell_density,
-    const double sweep_subcell_ie_density,
-    const double sweep_subcell_ke_density, const double subcell_vx,
-    const double subcell_vy, const double subcell_vz, const double gmax_m,
-    const double gmin_m, const double gmax_ie, const double gmin_ie,
-    const double gmax_ke, const double gmin_ke, const double gmax_vx,
-    const double gmin_vx, const double gmax_vy, const double gmin_vy,
-    const double gmax_vz, const double gmin_vz, vec_t* grad_m, vec_t* grad_ie,
-    vec_t* grad_ke, vec_t* grad_vx, vec_t* grad_vy, vec_t* grad_vz,
-    double* m_limiter, double* ie_limiter, double* ke_limiter,
-    double* vx_limiter, double* vy_limiter, double* vz_limiter) {
-
-  *m_limiter =
-      min(*m_limiter,
-          calc_cell_limiter(sweep_subcell_density, gmax_m, gmin_m, grad_m,
-                            nodes.x, nodes.y, nodes.z, sweep_subcell_c));
-  *ie_limiter =
-      min(*ie_limiter,
-          calc_cell_limiter(sweep_subcell_ie_density, gmax_ie, gmin_ie, grad_ie,
-                            nodes.x, nodes.y, nodes.z, sweep_subcell_c));
-  *ke_limiter =
-      min(*ke_limiter,
-          calc_cell_limiter(sweep_subcell_ke_density, gmax_ke, gmin_ke, grad_ke,
-                            nodes.x, nodes.y, nodes.z, sweep_subcell_c));
-  *vx_limiter = min(*vx_limiter, calc_cell_limiter(subcell_vx, gmax_vx, gmin_vx,
-                                                   grad_vx, nodes.x, nodes.y,
-                                                   nodes.z, sweep_subcell_c));
-  *vy_limiter = min(*vy_limiter, calc_cell_limiter(subcell_vy, gmax_vy, gmin_vy,
-                                                   grad_vy, nodes.x, nodes.y,
-                                                   nodes.z, sweep_subcell_c));
-  *vz_limiter = min(*vz_limiter, calc_cell_limiter(subcell_vz, gmax_vz, gmin_vz,
-                                                   grad_vz, nodes.x, nodes.y,
-                                                   nodes.z, sweep_subcell_c));
+// Limits the gradients of a set of fields reconstructed about the centre c by
+// the bounds of each field at the point p, with one field in each lane
+void limit_field_gradients(const vec_t* p, const vec_t* c, const double* phi,
+                           const double* gmax, const double* gmin,
+                           const double* grad_x, const double* grad_y,
+                           const double* grad_z, double* limiters) {
+
+  const double dx = p->x - c->x;
+  const double dy = p->y - c->y;
+  const double dz = p->z - c->z;
+
+#pragma omp simd
+  for (int ff = 0; ff < NFIELDS_BY_LIMITER; ++ff) {
+    const double dphi = (phi[(ff)] + grad_x[(ff)] * dx + grad_y[(ff)] * dy +
+                         grad_z[(ff)] * dz) -
+                        phi[(ff)];
+
+    // Lanes without a change, including the padding, are not limited
+    const double bound = (dphi > 0.0) ? gmax[(ff)] : gmin[(ff)];
+    const double ratio = (bound - phi[(ff)]) / ((dphi != 0.0) ? dphi : 1.0);
+    const double limiter = (dphi != 0.0) ? min(1.0, ratio) : 1.0;
+    limiters[(ff)] = min(limiters[(ff)], max(limiter, 0.0));
+  }
 }
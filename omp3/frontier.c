@@ -0,0 +1,479 @@
+#include "../../shared.h"
+#include "hale.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+
+// Updates the frontier of cells and nodes that the Lagrangian kernels run over
+void update_frontier(UnstructuredMesh* umesh, HaleData* hale_data) {
+
+  // Seeds the frontier afresh with the cells that have a moving node, or a jump
+  // in pressure or energy with a neighbour, so it follows the flow rather than
+  // accumulating every cell that was ever active
+  seed_frontier(umesh->ncells, umesh->cells_to_nodes_offsets,
+                umesh->cells_to_nodes, umesh->cells_to_faces_offsets,
+                umesh->cells_to_faces, umesh->faces_to_cells0,
+                umesh->faces_to_cells1, hale_data->velocity_x0,
+                hale_data->velocity_y0, hale_data->velocity_z0,
+                hale_data->energy0, hale_data->density0,
+                hale_data->cells_frontier);
+
+  // Widens the frontier so that the motion within a timestep cannot leave it
+  for (int ll = 0; ll < FRONTIER_LAYERS; ++ll) {
+    dilate_frontier(umesh->nnodes, umesh->ncells, umesh->nodes_to_cells_offsets,
+                    umesh->nodes_to_cells, umesh->cells_to_nodes_offsets,
+                    umesh->cells_to_nodes, hale_data->cells_frontier,
+                    hale_data->nodes_frontier);
+  }
+
+  compact_frontier(
+      umesh->nnodes, umesh->ncells, umesh->nodes_to_cells_offsets,
+      umesh->nodes_to_cells, umesh->nodes_to_nodes_offsets,
+      umesh->nodes_to_nodes, hale_data->cells_frontier,
+      hale_data->nodes_frontier, &hale_data->nfrontier_cells,
+      hale_data->frontier_cells, &hale_data->nfrontier_nodes,
+      hale_data->frontier_nodes, &hale_data->nfrontier_halo_nodes,
+      hale_data->frontier_halo_nodes);
+
+  if (hale_data->edge_centric_viscosity) {
+    compact_frontier_edges(
+        hale_data->nedge_colours, hale_data->edge_colour_offsets,
+        hale_data->edges_by_colour, hale_data->edges_to_faces_offsets,
+        hale_data->edges_to_faces, umesh->faces_to_cells0,
+        umesh->faces_to_cells1, hale_data->cells_frontier,
+        hale_data->frontier_edge_colour_offsets,
+        hale_data->frontier_edges_by_colour);
+  }
+
+  // The state outside of the frontier is held at the current time level
+  hold_outside_frontier(
+      umesh->nnodes, umesh->ncells, hale_data->cells_frontier,
+      hale_data->nodes_frontier, umesh->nodes_x0, umesh->nodes_y0,
+      umesh->nodes_z0, hale_data->velocity_x0, hale_data->velocity_y0,
+      hale_data->velocity_z0, hale_data->energy0, hale_data->density0,
+      umesh->nodes_x1, umesh->nodes_y1, umesh->nodes_z1,
+      hale_data->velocity_x1, hale_data->velocity_y1, hale_data->velocity_z1,
+      hale_data->energy1, hale_data->density1, hale_data->pressure0,
+      hale_data->pressure1);
+}
+
+// Seeds the frontier with only the cells that have a moving node, or a jump
+// in pressure or energy with a neighbour
+void seed_frontier(const int ncells, const int* cells_to_nodes_offsets,
+                   const int* cells_to_nodes, const int* cells_to_faces_offsets,
+                   const int* cells_to_faces, const int* faces_to_cells0,
+                   const int* faces_to_cells1, const double* velocity_x,
+                   const double* velocity_y, const double* velocity_z,
+                   const double* energy, const double* density,
+                   int* cells_frontier) {
+
+#pragma omp parallel for
+  for (int cc = 0; cc < ncells; ++cc) {
+    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+    const int nnodes_by_cell =
+        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
+
+    int in_frontier = 0;
+    for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+      const int node_index = cells_to_nodes[(cell_to_nodes_off + nn)];
+      in_frontier |= (calc_node_speed(node_index, velocity_x, velocity_y,
+                                      velocity_z) > FRONTIER_TOL);
+    }
+
+    const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
+    const int nfaces_by_cell =
+        cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
+    const double p = (GAM - 1.0) * energy[(cc)] * density[(cc)];
+
+    for (int ff = 0; ff < nfaces_by_cell; ++ff) {
+      const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
+      const int neighbour_index = (faces_to_cells0[(face_index)] == cc)
+                                      ? faces_to_cells1[(face_index)]
+                                      : faces_to_cells0[(face_index)];
+      if (neighbour_index == -1) {
+        continue;
+      }
+
+      const double neighbour_p = (GAM - 1.0) * energy[(neighbour_index)] *
+                                 density[(neighbour_index)];
+      in_frontier |=
+          (fabs(neighbour_p - p) > FRONTIER_TOL * (neighbour_p + p));
+      in_frontier |=
+          (fabs(energy[(neighbour_index)] - energy[(cc)]) >
+           FRONTIER_TOL * (energy[(neighbour_index)] + energy[(cc)]));
+    }
+
+    cells_frontier[(cc)] = in_frontier;
+  }
+}
+
+// Widens the frontier by the cells sharing a node with a frontier cell
+void dilate_frontier(const int nnodes, const int ncells,
+                     const int* nodes_to_cells_offsets,
+                     const int* nodes_to_cells,
+                     const int* cells_to_nodes_offsets,
+                     const int* cells_to_nodes, int* cells_frontier,
+                     int* nodes_frontier) {
+
+#pragma omp parallel for
+  for (int nn = 0; nn < nnodes; ++nn) {
+    const int node_to_cells_off = nodes_to_cells_offsets[(nn)];
+    const int ncells_by_node =
+        nodes_to_cells_offsets[(nn + 1)] - node_to_cells_off;
+
+    int in_frontier = 0;
+    for (int cc = 0; cc < ncells_by_node; ++cc) {
+      in_frontier |= cells_frontier[(nodes_to_cells[(node_to_cells_off + cc)])];
+    }
+    nodes_frontier[(nn)] = in_frontier;
+  }
+
+#pragma omp parallel for
+  for (int cc = 0; cc < ncells; ++cc) {
+    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+    const int nnodes_by_cell =
+        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
+
+    for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+      cells_frontier[(cc)] |=
+          nodes_frontier[(cells_to_nodes[(cell_to_nodes_off + nn)])];
+    }
+  }
+}
+
+// Lists the frontier cells, the nodes whose cells are all in the frontier,
+// and those of the nodes that neighbour a node outside of the frontier
+void compact_frontier(const int nnodes, const int ncells,
+                      const int* nodes_to_cells_offsets,
+                      const int* nodes_to_cells,
+                      const int* nodes_to_nodes_offsets,
+                      const int* nodes_to_nodes, const int* cells_frontier,
+                      int* nodes_frontier, int* nfrontier_cells,
+                      int* frontier_cells, int* nfrontier_nodes,
+                      int* frontier_nodes, int* nfrontier_halo_nodes,
+                      int* frontier_halo_nodes) {
+
+  int ncells_in = 0;
+  for (int cc = 0; cc < ncells; ++cc) {
+    if (cells_frontier[(cc)]) {
+      frontier_cells[(ncells_in++)] = cc;
+    }
+  }
+  *nfrontier_cells = ncells_in;
+
+#pragma omp parallel for
+  for (int nn = 0; nn < nnodes; ++nn) {
+    const int node_to_cells_off = nodes_to_cells_offsets[(nn)];
+    const int ncells_by_node =
+        nodes_to_cells_offsets[(nn + 1)] - node_to_cells_off;
+
+    int in_frontier = 1;
+    for (int cc = 0; cc < ncells_by_node; ++cc) {
+      in_frontier &= cells_frontier[(nodes_to_cells[(node_to_cells_off + cc)])];
+    }
+    nodes_frontier[(nn)] = in_frontier;
+  }
+
+  int nnodes_in = 0;
+  int nhalo_nodes = 0;
+  for (int nn = 0; nn < nnodes; ++nn) {
+    if (!nodes_frontier[(nn)]) {
+      continue;
+    }
+
+    frontier_nodes[(nnodes_in++)] = nn;
+
+    const int node_to_nodes_off = nodes_to_nodes_offsets[(nn)];
+    const int nnodes_by_node =
+        nodes_to_nodes_offsets[(nn + 1)] - node_to_nodes_off;
+    for (int nn2 = 0; nn2 < nnodes_by_node; ++nn2) {
+      const int neighbour_index = nodes_to_nodes[(node_to_nodes_off + nn2)];
+      if (neighbour_index != -1 && !nodes_frontier[(neighbour_index)]) {
+        frontier_halo_nodes[(nhalo_nodes++)] = nn;
+        break;
+      }
+    }
+  }
+  *nfrontier_nodes = nnodes_in;
+  *nfrontier_halo_nodes = nhalo_nodes;
+}
+
+// Lists the edges on a face of a frontier cell, keeping them grouped by colour
+void compact_frontier_edges(const int nedge_colours,
+                            const int* edge_colour_offsets,
+                            const int* edges_by_colour,
+                            const int* edges_to_faces_offsets,
+                            const int* edges_to_faces,
+                            const int* faces_to_cells0,
+                            const int* faces_to_cells1,
+                            const int* cells_frontier,
+                            int* frontier_edge_colour_offsets,
+                            int* frontier_edges_by_colour) {
+
+  int nedges_in = 0;
+  for (int colour = 0; colour < nedge_colours; ++colour) {
+    frontier_edge_colour_offsets[(colour)] = nedges_in;
+    for (int ee = edge_colour_offsets[(colour)];
+         ee < edge_colour_offsets[(colour + 1)]; ++ee) {
+      const int edge_index = edges_by_colour[(ee)];
+      const int edge_to_faces_off = edges_to_faces_offsets[(edge_index)];
+      const int nfaces_by_edge =
+          edges_to_faces_offsets[(edge_index + 1)] - edge_to_faces_off;
+
+      int in_frontier = 0;
+      for (int ff = 0; ff < nfaces_by_edge; ++ff) {
+        const int face_index = edges_to_faces[(edge_to_faces_off + ff)];
+        const int cells[2] = {faces_to_cells0[(face_index)],
+                              faces_to_cells1[(face_index)]};
+        for (int cc = 0; cc < 2; ++cc) {
+          in_frontier |= (cells[(cc)] != -1 && cells_frontier[(cells[(cc)])]);
+        }
+      }
+
+      if (in_frontier) {
+        frontier_edges_by_colour[(nedges_in++)] = edge_index;
+      }
+    }
+  }
+  frontier_edge_colour_offsets[(nedge_colours)] = nedges_in;
+}
+
+// Holds the nodes and cells outside of the frontier at the current time level,
+// as the dense kernels read both time levels of the whole mesh
+void hold_outside_frontier(
+    const int nnodes, const int ncells, const int* cells_frontier,
+    const int* nodes_frontier, const double* nodes_x0, const double* nodes_y0,
+    const double* nodes_z0, const double* velocity_x0,
+    const double* velocity_y0, const double* velocity_z0,
+    const double* energy0, const double* density0, double* nodes_x1,
+    double* nodes_y1, double* nodes_z1, double* velocity_x1,
+    double* velocity_y1, double* velocity_z1, double* energy1,
+    double* density1, double* pressure0, double* pressure1) {
+
+#pragma omp parallel for
+  for (int nn = 0; nn < nnodes; ++nn) {
+    if (nodes_frontier[(nn)]) {
+      continue;
+    }
+    nodes_x1[(nn)] = nodes_x0[(nn)];
+    nodes_y1[(nn)] = nodes_y0[(nn)];
+    nodes_z1[(nn)] = nodes_z0[(nn)];
+    velocity_x1[(nn)] = velocity_x0[(nn)];
+    velocity_y1[(nn)] = velocity_y0[(nn)];
+    velocity_z1[(nn)] = velocity_z0[(nn)];
+  }
+
+#pragma omp parallel for
+  for (int cc = 0; cc < ncells; ++cc) {
+    if (cells_frontier[(cc)]) {
+      continue;
+    }
+    pressure0[(cc)] = (GAM - 1.0) * energy0[(cc)] * density0[(cc)];
+    pressure1[(cc)] = pressure0[(cc)];
+    energy1[(cc)] = energy0[(cc)];
+    density1[(cc)] = density0[(cc)];
+  }
+}
+
+// Checks that the nodes at the edge of the frontier remained at rest
+void check_frontier(const int nfrontier_halo_nodes,
+                    const int* frontier_halo_nodes, const double* velocity_x,
+                    const double* velocity_y, const double* velocity_z) {
+
+  int moved = 0;
+
+#pragma omp parallel for reduction(| : moved)
+  for (int ii = 0; ii < nfrontier_halo_nodes; ++ii) {
+    moved |= (calc_node_speed(frontier_halo_nodes[(ii)], velocity_x, velocity_y,
+                              velocity_z) > FRONTIER_TOL);
+  }
+
+  // The state held outside of the frontier is wrong once its edge has moved
+  if (moved) {
+    TERMINATE("The frontier needs more than %d layers.\n", FRONTIER_LAYERS);
+  }
+}
+
+// Keeps the state at the start of the step, so that the dense kernels can
+// repeat the step to verify the frontier
+void store_frontier_state(Mesh* mesh, UnstructuredMesh* umesh,
+                          HaleData* hale_data) {
+
+  hale_data->verify_dt = mesh->dt;
+  swap_frontier_state(
+      umesh->nnodes, umesh->ncells, umesh->nodes_x0, umesh->nodes_y0,
+      umesh->nodes_z0, hale_data->velocity_x0, hale_data->velocity_y0,
+      hale_data->velocity_z0, hale_data->energy0, hale_data->density0,
+      hale_data->verify_nodes_x, hale_data->verify_nodes_y,
+      hale_data->verify_nodes_z, hale_data->verify_velocity_x,
+      hale_data->verify_velocity_y, hale_data->verify_velocity_z,
+      hale_data->verify_energy, hale_data->verify_density, 0);
+}
+
+// Repeats the step with the dense kernels from the stored state, and checks
+// that the frontier step agrees with it to within FRONTIER_VERIFY_TOL. The
+// run continues from the dense step
+void verify_frontier(Mesh* mesh, UnstructuredMesh* umesh,
+                     HaleData* hale_data) {
+
+  // Exchanges the frontier step for the state at the start of the step
+  const double frontier_dt = mesh->dt;
+  mesh->dt = hale_data->verify_dt;
+  swap_frontier_state(
+      umesh->nnodes, umesh->ncells, umesh->nodes_x0, umesh->nodes_y0,
+      umesh->nodes_z0, hale_data->velocity_x0, hale_data->velocity_y0,
+      hale_data->velocity_z0, hale_data->energy0, hale_data->density0,
+      hale_data->verify_nodes_x, hale_data->verify_nodes_y,
+      hale_data->verify_nodes_z, hale_data->verify_velocity_x,
+      hale_data->verify_velocity_y, hale_data->verify_velocity_z,
+      hale_data->verify_energy, hale_data->verify_density, 1);
+
+  int* cells_frontier = hale_data->cells_frontier;
+  int* frontier_cells = hale_data->frontier_cells;
+  int* frontier_nodes = hale_data->frontier_nodes;
+  int* frontier_edge_colour_offsets = hale_data->frontier_edge_colour_offsets;
+  int* frontier_edges_by_colour = hale_data->frontier_edges_by_colour;
+  const int nfrontier_cells = hale_data->nfrontier_cells;
+  const int nfrontier_nodes = hale_data->nfrontier_nodes;
+  hale_data->cells_frontier = NULL;
+  hale_data->frontier_cells = NULL;
+  hale_data->frontier_nodes = NULL;
+  hale_data->frontier_edge_colour_offsets = hale_data->edge_colour_offsets;
+  hale_data->frontier_edges_by_colour = hale_data->edges_by_colour;
+  hale_data->nfrontier_cells = umesh->ncells;
+  hale_data->nfrontier_nodes = umesh->nnodes;
+
+  // The frontier step left the geometry of its own mesh, so the geometry at
+  // the start of the step is rebuilt before repeating it
+  update_cell_centroids(umesh, hale_data, umesh->nodes_x0, umesh->nodes_y0,
+                        umesh->nodes_z0);
+  update_face_geometry(umesh, hale_data, umesh->nodes_x0, umesh->nodes_y0,
+                       umesh->nodes_z0, NULL, NULL, NULL, NULL);
+  update_subcell_geometry(umesh, hale_data, umesh->nodes_x0, umesh->nodes_y0,
+                          umesh->nodes_z0);
+  lagrangian_phase(mesh, umesh, hale_data);
+
+  hale_data->cells_frontier = cells_frontier;
+  hale_data->frontier_cells = frontier_cells;
+  hale_data->frontier_nodes = frontier_nodes;
+  hale_data->frontier_edge_colour_offsets = frontier_edge_colour_offsets;
+  hale_data->frontier_edges_by_colour = frontier_edges_by_colour;
+  hale_data->nfrontier_cells = nfrontier_cells;
+  hale_data->nfrontier_nodes = nfrontier_nodes;
+
+  // The components of the positions and velocities are compared at the scale
+  // of the largest component, as a component at rest is only round off
+  const double* nodes[] = {umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0};
+  const double* verify_nodes[] = {hale_data->verify_nodes_x,
+                                  hale_data->verify_nodes_y,
+                                  hale_data->verify_nodes_z};
+  const double* velocity[] = {hale_data->velocity_x0, hale_data->velocity_y0,
+                              hale_data->velocity_z0};
+  const double* verify_velocity[] = {hale_data->verify_velocity_x,
+                                     hale_data->verify_velocity_y,
+                                     hale_data->verify_velocity_z};
+  double nodes_scale = 0.0;
+  double nodes_difference = 0.0;
+  double velocity_scale = 0.0;
+  double velocity_difference = 0.0;
+  for (int dd = 0; dd < 3; ++dd) {
+    const double nodes_magnitude =
+        calc_max_magnitude(umesh->nnodes, nodes[(dd)]);
+    const double velocity_magnitude =
+        calc_max_magnitude(umesh->nnodes, velocity[(dd)]);
+    const double nodes_dd_difference =
+        calc_max_difference(umesh->nnodes, nodes[(dd)], verify_nodes[(dd)]);
+    const double velocity_dd_difference = calc_max_difference(
+        umesh->nnodes, velocity[(dd)], verify_velocity[(dd)]);
+    nodes_scale = max(nodes_scale, nodes_magnitude);
+    velocity_scale = max(velocity_scale, velocity_magnitude);
+    nodes_difference = max(nodes_difference, nodes_dd_difference);
+    velocity_difference = max(velocity_difference, velocity_dd_difference);
+  }
+
+  const double energy_scale =
+      calc_max_magnitude(umesh->ncells, hale_data->energy0);
+  const double density_scale =
+      calc_max_magnitude(umesh->ncells, hale_data->density0);
+  const double errors[] = {
+      fabs(frontier_dt - mesh->dt) / mesh->dt,
+      nodes_difference / max(nodes_scale, DBL_MIN),
+      velocity_difference / max(velocity_scale, DBL_MIN),
+      calc_max_difference(umesh->ncells, hale_data->energy0,
+                          hale_data->verify_energy) /
+          max(energy_scale, DBL_MIN),
+      calc_max_difference(umesh->ncells, hale_data->density0,
+                          hale_data->verify_density) /
+          max(density_scale, DBL_MIN)};
+  double error = 0.0;
+  for (int ee = 0; ee < (int)(sizeof(errors) / sizeof(errors[0])); ++ee) {
+    error = max(error, errors[(ee)]);
+  }
+
+  printf("Frontier differs from the dense step by %.4e\n", error);
+  if (error > FRONTIER_VERIFY_TOL) {
+    TERMINATE("The frontier step differs from the dense step by %.4e.\n",
+              error);
+  }
+}
+
+// Copies the state into the stored state, or exchanges the two when swap is
+// set
+void swap_frontier_state(
+    const int nnodes, const int ncells, double* nodes_x, double* nodes_y,
+    double* nodes_z, double* velocity_x, double* velocity_y,
+    double* velocity_z, double* energy, double* density,
+    double* stored_nodes_x, double* stored_nodes_y, double* stored_nodes_z,
+    double* stored_velocity_x, double* stored_velocity_y,
+    double* stored_velocity_z, double* stored_energy, double* stored_density,
+    const int swap) {
+
+  double* fields[] = {nodes_x,    nodes_y,    nodes_z, velocity_x,
+                      velocity_y, velocity_z, energy,  density};
+  double* stored_fields[] = {stored_nodes_x,    stored_nodes_y,
+                             stored_nodes_z,    stored_velocity_x,
+                             stored_velocity_y, stored_velocity_z,
+                             stored_energy,     stored_density};
+  const int nfields = sizeof(fields) / sizeof(fields[0]);
+
+  for (int ff = 0; ff < nfields; ++ff) {
+    const int nentries = (ff < 6) ? nnodes : ncells;
+    double* field = fields[(ff)];
+    double* stored_field = stored_fields[(ff)];
+
+#pragma omp parallel for
+    for (int ii = 0; ii < nentries; ++ii) {
+      const double value = field[(ii)];
+      if (swap) {
+        field[(ii)] = stored_field[(ii)];
+      }
+      stored_field[(ii)] = value;
+    }
+  }
+}
+
+// Returns the largest difference between two fields
+double calc_max_difference(const int n, const double* a, const double* b) {
+
+  double max_difference = 0.0;
+
+#pragma omp parallel for reduction(max : max_difference)
+  for (int ii = 0; ii < n; ++ii) {
+    max_difference = max(max_difference, fabs(a[(ii)] - b[(ii)]));
+  }
+
+  return max_difference;
+}
+
+// Returns the largest magnitude in a field
+double calc_max_magnitude(const int n, const double* a) {
+
+  double max_magnitude = 0.0;
+
+#pragma omp parallel for reduction(max : max_magnitude)
+  for (int ii = 0; ii < n; ++ii) {
+    max_magnitude = max(max_magnitude, fabs(a[(ii)]));
+  }
+
+  return max_magnitude;
+}
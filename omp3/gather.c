@@ -16,7 +16,8 @@ void gather_subcell_mass_and_energy(
     double* subcell_centroids_x, double* subcell_centroids_y,
     double* subcell_centroids_z, int* faces_to_cells0, int* faces_to_cells1,
     int* cells_to_faces_offsets, int* cells_to_faces, int* cells_to_nodes,
-    int* nodes_to_cells_offsets, int* nodes_to_cells, double* initial_mass,
+    int* nodes_to_cells_offsets, int* nodes_to_cells,
+    const int* cells_reconstructed, double* initial_mass,
     double* initial_ie_mass, double* initial_ke_mass);
 
 // Gathers the momentum into the subcells
@@ -29,9 +30,38 @@ void gather_subcell_momentum(
     double* subcell_momentum_x, double* subcell_momentum_y,
     double* subcell_momentum_z, double* subcell_centroids_x,
     double* subcell_centroids_y, double* subcell_centroids_z,
-    int* nodes_to_cells_offsets, int* cells_to_nodes_offsets,
-    int* cells_to_nodes, int* nodes_to_nodes_offsets, int* nodes_to_nodes,
-    vec_t* initial_momentum);
+    int* nodes_to_cells_offsets, int* nodes_to_subcells,
+    int* nodes_to_nodes_offsets, int* nodes_to_nodes,
+    const int* cells_reconstructed, vec_t* initial_momentum);
+
+// Calculates the kinetic energy of each cell from its subcell masses and the
+// velocities of its nodes, returning the total
+double calc_cell_ke_mass(const int ncells, const int* cells_to_nodes_offsets,
+                         const int* cells_to_nodes, const double* subcell_mass,
+                         const double* velocity_x, const double* velocity_y,
+                         const double* velocity_z, double* ke_mass);
+
+// Gathers the mass and energy into the subcells at the mean densities of their
+// cells, for the first order remap
+void gather_constant_subcell_mass_and_energy(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* cells_to_nodes, const double* cell_volume,
+    const double* energy, const double* density, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    const double* cell_mass, const double* subcell_mass,
+    const double* subcell_volume, double* ke_mass, double* subcell_ie_mass,
+    double* subcell_ke_mass, double* initial_mass, double* initial_ie_mass,
+    double* initial_ke_mass);
+
+// Gathers the momentum into the subcells at the mean momentum densities of
+// their nodes, for the first order remap
+void gather_constant_subcell_momentum(
+    const int nnodes, const double* nodal_volumes, const double* nodal_mass,
+    const double* velocity_x, const double* velocity_y,
+    const double* velocity_z, const double* subcell_volume,
+    const int* nodes_to_cells_offsets, const int* nodes_to_subcells,
+    double* subcell_momentum_x, double* subcell_momentum_y,
+    double* subcell_momentum_z, vec_t* initial_momentum);
 
 // gathers all of the subcell quantities on the mesh
 void gather_subcell_quantities(UnstructuredMesh* umesh, HaleData* hale_data,
@@ -43,49 +73,79 @@ void gather_subcell_quantities(UnstructuredMesh* umesh, HaleData* hale_data,
   *      GATHERING STAGE OF THE REMAP
   */
 
-  // Calculates the cell volume, subcell volume and the subcell centroids
-  calc_volumes_centroids(
-      umesh->ncells, umesh->nnodes, hale_data->nnodes_by_subcell,
-      umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
-      hale_data->subcells_to_faces_offsets, hale_data->subcells_to_faces,
-      umesh->faces_to_nodes, umesh->faces_to_nodes_offsets,
-      umesh->faces_cclockwise_cell, umesh->nodes_x0, umesh->nodes_y0,
-      umesh->nodes_z0, hale_data->subcell_centroids_x,
-      hale_data->subcell_centroids_y, hale_data->subcell_centroids_z,
-      hale_data->subcell_volume, hale_data->cell_volume,
-      hale_data->nodal_volumes, umesh->nodes_to_cells_offsets,
-      umesh->nodes_to_cells);
-
-  // Gathers all of the subcell quantities on the mesh
-  gather_subcell_mass_and_energy(
-      umesh->ncells, umesh->nnodes, umesh->cell_centroids_x,
-      umesh->cell_centroids_y, umesh->cell_centroids_z,
-      umesh->cells_to_nodes_offsets, umesh->nodes_x0, umesh->nodes_y0,
-      umesh->nodes_z0, hale_data->cell_volume, hale_data->energy0,
-      hale_data->density0, hale_data->velocity_x0, hale_data->velocity_y0,
-      hale_data->velocity_z0, hale_data->ke_mass, hale_data->cell_mass,
-      hale_data->subcell_mass, hale_data->subcell_volume,
-      hale_data->subcell_ie_mass, hale_data->subcell_ke_mass,
-      hale_data->subcell_centroids_x, hale_data->subcell_centroids_y,
-      hale_data->subcell_centroids_z, umesh->faces_to_cells0,
-      umesh->faces_to_cells1, umesh->cells_to_faces_offsets,
-      umesh->cells_to_faces, umesh->cells_to_nodes,
-      umesh->nodes_to_cells_offsets, umesh->nodes_to_cells, initial_mass,
-      initial_ie_mass, initial_ke_mass);
-
-  // Gathers the momentum  the subcells
-  gather_subcell_momentum(
-      umesh->nnodes, hale_data->nodal_volumes, hale_data->nodal_mass,
-      umesh->nodes_to_cells, umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0,
-      hale_data->velocity_x0, hale_data->velocity_y0, hale_data->velocity_z0,
-      hale_data->subcell_volume, umesh->cell_centroids_x,
-      umesh->cell_centroids_y, umesh->cell_centroids_z,
-      hale_data->subcell_momentum_x, hale_data->subcell_momentum_y,
-      hale_data->subcell_momentum_z, hale_data->subcell_centroids_x,
-      hale_data->subcell_centroids_y, hale_data->subcell_centroids_z,
-      umesh->nodes_to_cells_offsets, umesh->cells_to_nodes_offsets,
-      umesh->cells_to_nodes, umesh->nodes_to_nodes_offsets,
-      umesh->nodes_to_nodes, initial_momentum);
+  // The corrector left the subcell volumes and centroids of the Lagrangian
+  // mesh, so only the nodal volumes need to be summed from them
+  calc_nodal_vol_and_c(umesh->nnodes, umesh->nodes_to_cells_offsets,
+                       umesh->nodes_to_cells, hale_data->nodes_to_subcells,
+                       hale_data->subcell_volume, hale_data->energy0,
+                       hale_data->nodal_volumes, hale_data->nodal_soundspeed);
+
+  // Flags the parts of the mesh that have moved away from the rezoned mesh,
+  // and the cells around them that the advection reconstructs from
+  START_PROFILING(&compute_profile);
+  calc_active_cells(umesh->nnodes, umesh->ncells, umesh->cells_to_nodes_offsets,
+                    umesh->cells_to_nodes, umesh->nodes_x0, umesh->nodes_y0,
+                    umesh->nodes_z0, hale_data->rezoned_nodes_x,
+                    hale_data->rezoned_nodes_y, hale_data->rezoned_nodes_z,
+                    hale_data->nodes_active, hale_data->cells_active);
+  calc_reconstructed_cells(umesh->ncells, umesh->cells_to_faces_offsets,
+                           umesh->cells_to_faces, umesh->faces_to_cells0,
+                           umesh->faces_to_cells1, hale_data->cells_active,
+                           hale_data->cells_reconstructed);
+  STOP_PROFILING(&compute_profile, "calc_active_cells");
+
+  // The first order remap holds the mean densities constant in each subcell
+  if (hale_data->remap_order == 1) {
+    gather_constant_subcell_mass_and_energy(
+        umesh->ncells, umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
+        hale_data->cell_volume, hale_data->energy0, hale_data->density0,
+        hale_data->velocity_x0, hale_data->velocity_y0,
+        hale_data->velocity_z0, hale_data->cell_mass, hale_data->subcell_mass,
+        hale_data->subcell_volume, hale_data->ke_mass,
+        hale_data->subcell_ie_mass, hale_data->subcell_ke_mass, initial_mass,
+        initial_ie_mass, initial_ke_mass);
+
+    gather_constant_subcell_momentum(
+        umesh->nnodes, hale_data->nodal_volumes, hale_data->nodal_mass,
+        hale_data->velocity_x0, hale_data->velocity_y0,
+        hale_data->velocity_z0, hale_data->subcell_volume,
+        umesh->nodes_to_cells_offsets, hale_data->nodes_to_subcells,
+        hale_data->subcell_momentum_x, hale_data->subcell_momentum_y,
+        hale_data->subcell_momentum_z, initial_momentum);
+  } else {
+    // Gathers all of the subcell quantities on the mesh
+    gather_subcell_mass_and_energy(
+        umesh->ncells, umesh->nnodes, umesh->cell_centroids_x,
+        umesh->cell_centroids_y, umesh->cell_centroids_z,
+        umesh->cells_to_nodes_offsets, umesh->nodes_x0, umesh->nodes_y0,
+        umesh->nodes_z0, hale_data->cell_volume, hale_data->energy0,
+        hale_data->density0, hale_data->velocity_x0, hale_data->velocity_y0,
+        hale_data->velocity_z0, hale_data->ke_mass, hale_data->cell_mass,
+        hale_data->subcell_mass, hale_data->subcell_volume,
+        hale_data->subcell_ie_mass, hale_data->subcell_ke_mass,
+        hale_data->subcell_centroids_x, hale_data->subcell_centroids_y,
+        hale_data->subcell_centroids_z, umesh->faces_to_cells0,
+        umesh->faces_to_cells1, umesh->cells_to_faces_offsets,
+        umesh->cells_to_faces, umesh->cells_to_nodes,
+        umesh->nodes_to_cells_offsets, umesh->nodes_to_cells,
+        hale_data->cells_reconstructed, initial_mass, initial_ie_mass,
+        initial_ke_mass);
+
+    // Gathers the momentum  the subcells
+    gather_subcell_momentum(
+        umesh->nnodes, hale_data->nodal_volumes, hale_data->nodal_mass,
+        umesh->nodes_to_cells, umesh->nodes_x0, umesh->nodes_y0,
+        umesh->nodes_z0, hale_data->velocity_x0, hale_data->velocity_y0,
+        hale_data->velocity_z0, hale_data->subcell_volume,
+        umesh->cell_centroids_x, umesh->cell_centroids_y,
+        umesh->cell_centroids_z, hale_data->subcell_momentum_x,
+        hale_data->subcell_momentum_y, hale_data->subcell_momentum_z,
+        hale_data->subcell_centroids_x, hale_data->subcell_centroids_y,
+        hale_data->subcell_centroids_z, umesh->nodes_to_cells_offsets,
+        hale_data->nodes_to_subcells, umesh->nodes_to_nodes_offsets,
+        umesh->nodes_to_nodes, hale_data->cells_reconstructed,
+        initial_momentum);
+  }
 }
 
 // Gathers all of the subcell quantities on the mesh
@@ -100,14 +160,479 @@ void gather_subcell_mass_and_energy(
     double* subcell_centroids_x, double* subcell_centroids_y,
     double* subcell_centroids_z, int* faces_to_cells0, int* faces_to_cells1,
     int* cells_to_faces_offsets, int* cells_to_faces, int* cells_to_nodes,
-    int* nodes_to_cells_offsets, int* nodes_to_cells, double* initial_mass,
+    int* nodes_to_cells_offsets, int* nodes_to_cells,
+    const int* cells_reconstructed, double* initial_mass,
     double* initial_ie_mass, double* initial_ke_mass) {
 
   double total_mass = 0.0;
   double total_ie_mass = 0.0;
+
+  // We first have to determine the cell centered kinetic energy
+  const double total_ke_mass =
+      calc_cell_ke_mass(ncells, cells_to_nodes_offsets, cells_to_nodes,
+                        subcell_mass, velocity_x, velocity_y, velocity_z,
+                        ke_mass);
+
+  double total_ie_in_subcells = 0.0;
+  double total_ke_in_subcells = 0.0;
+
+// Calculate the sub-cell internal and kinetic energies
+#pragma omp parallel for reduction(+ : total_mass, total_ie_mass,              \
+                                   total_ie_in_subcells, total_ke_in_subcells)
+  for (int cb = 0; cb < ncells; cb += NSOLVES_BY_BATCH) {
+    const int nsolves = min(NSOLVES_BY_BATCH, ncells - cb);
+
+    // The least squares systems of a batch of cells are solved together, with
+    // entry kk of system ss at kk * NSOLVES_BY_BATCH + ss
+    double batch_coeff[NSYM_3X3_ENTRIES * NSOLVES_BY_BATCH];
+    double batch_rhs[2 * 3 * NSOLVES_BY_BATCH];
+    double batch_gmax_ie[NSOLVES_BY_BATCH];
+    double batch_gmin_ie[NSOLVES_BY_BATCH];
+    double batch_gmax_ke[NSOLVES_BY_BATCH];
+    double batch_gmin_ke[NSOLVES_BY_BATCH];
+    vec_t batch_cell_c[NSOLVES_BY_BATCH];
+
+    for (int ss = 0; ss < nsolves; ++ss) {
+      const int cc = cb + ss;
+
+      // Calculating the volume dist necessary for the least squares
+      // regression
+      const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
+      const int nfaces_by_cell =
+          cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
+      const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+      const int nnodes_by_cell =
+          cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
+
+      const double cell_ie = density[(cc)] * energy[(cc)];
+      const double cell_ke = ke_mass[(cc)] / cell_volume[(cc)];
+      vec_t cell_c = {0.0, 0.0, 0.0};
+      calc_centroid(nnodes_by_cell, nodes_x, nodes_y, nodes_z, cells_to_nodes,
+                    cell_to_nodes_off, &cell_c);
+
+      vec_t ie_rhs = {0.0, 0.0, 0.0};
+      vec_t ke_rhs = {0.0, 0.0, 0.0};
+      vec_t coeff[3] = {{0.0, 0.0, 0.0}};
+
+      total_mass += cell_mass[(cc)];
+      total_ie_mass += cell_mass[(cc)] * energy[(cc)];
+
+      // A cell that the advection does not reconstruct from is gathered at
+      // its mean densities, solving the identity for a zero gradient
+      const int is_reconstructed = cells_reconstructed[(cc)];
+      if (!is_reconstructed) {
+        coeff[0].x = 1.0;
+        coeff[1].y = 1.0;
+        coeff[2].z = 1.0;
+      }
+
+      // Determine the weighted volume dist for neighbouring cells
+      double gmax_ie = -DBL_MAX;
+      double gmin_ie = DBL_MAX;
+      double gmax_ke = -DBL_MAX;
+      double gmin_ke = DBL_MAX;
+      for (int ff = 0; ff < nfaces_by_cell && is_reconstructed; ++ff) {
+        const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
+        const int neighbour_index = (faces_to_cells0[(face_index)] == cc)
+                                        ? faces_to_cells1[(face_index)]
+                                        : faces_to_cells0[(face_index)];
+
+        // Check if boundary face
+        if (neighbour_index == -1) {
+          continue;
+        }
+
+        vec_t dist = {cell_centroids_x[(neighbour_index)] - cell_c.x,
+                      cell_centroids_y[(neighbour_index)] - cell_c.y,
+                      cell_centroids_z[(neighbour_index)] - cell_c.z};
+
+        // Store the neighbouring cell's contribution to the coefficients
+        double neighbour_vol = cell_volume[(neighbour_index)];
+        coeff[0].x +=
+            2.0 * (dist.x * dist.x) / (neighbour_vol * neighbour_vol);
+        coeff[0].y +=
+            2.0 * (dist.x * dist.y) / (neighbour_vol * neighbour_vol);
+        coeff[0].z +=
+            2.0 * (dist.x * dist.z) / (neighbour_vol * neighbour_vol);
+        coeff[1].x +=
+            2.0 * (dist.y * dist.x) / (neighbour_vol * neighbour_vol);
+        coeff[1].y +=
+            2.0 * (dist.y * dist.y) / (neighbour_vol * neighbour_vol);
+        coeff[1].z +=
+            2.0 * (dist.y * dist.z) / (neighbour_vol * neighbour_vol);
+        coeff[2].x +=
+            2.0 * (dist.z * dist.x) / (neighbour_vol * neighbour_vol);
+        coeff[2].y +=
+            2.0 * (dist.z * dist.y) / (neighbour_vol * neighbour_vol);
+        coeff[2].z +=
+            2.0 * (dist.z * dist.z) / (neighbour_vol * neighbour_vol);
+
+        const double neighbour_ie =
+            density[(neighbour_index)] * energy[(neighbour_index)];
+        const double neighbour_ke = ke_mass[(neighbour_index)] / neighbour_vol;
+
+        gmax_ie = max(gmax_ie, neighbour_ie);
+        gmin_ie = min(gmin_ie, neighbour_ie);
+        gmax_ke = max(gmax_ke, neighbour_ke);
+        gmin_ke = min(gmin_ke, neighbour_ke);
+
+        // Prepare the RHS, which includes energy differential
+        const double die = (neighbour_ie - cell_ie);
+        const double dke = (neighbour_ke - cell_ke);
+        ie_rhs.x += 2.0 * (dist.x * die) / neighbour_vol;
+        ie_rhs.y += 2.0 * (dist.y * die) / neighbour_vol;
+        ie_rhs.z += 2.0 * (dist.z * die) / neighbour_vol;
+        ke_rhs.x += 2.0 * (dist.x * dke) / neighbour_vol;
+        ke_rhs.y += 2.0 * (dist.y * dke) / neighbour_vol;
+        ke_rhs.z += 2.0 * (dist.z * dke) / neighbour_vol;
+      }
+
+      store_sym_3x3_system(ss, NSOLVES_BY_BATCH, coeff, batch_coeff);
+      store_3x3_rhs(ss, NSOLVES_BY_BATCH, 0, &ie_rhs, batch_rhs);
+      store_3x3_rhs(ss, NSOLVES_BY_BATCH, 1, &ke_rhs, batch_rhs);
+      batch_gmax_ie[(ss)] = gmax_ie;
+      batch_gmin_ie[(ss)] = gmin_ie;
+      batch_gmax_ke[(ss)] = gmax_ke;
+      batch_gmin_ke[(ss)] = gmin_ke;
+      batch_cell_c[(ss)] = cell_c;
+    }
+
+    // Solve for the internal and kinetic energy gradients
+    solve_sym_3x3_batch(nsolves, NSOLVES_BY_BATCH, 2, batch_coeff, batch_rhs);
+
+    for (int ss = 0; ss < nsolves; ++ss) {
+      const int cc = cb + ss;
+      const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+      const int nnodes_by_cell =
+          cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
+
+      const double cell_ie = density[(cc)] * energy[(cc)];
+      const double cell_ke = ke_mass[(cc)] / cell_volume[(cc)];
+      vec_t cell_c = batch_cell_c[(ss)];
+      vec_t grad_ie = load_3x3_solution(ss, NSOLVES_BY_BATCH, 0, batch_rhs);
+      vec_t grad_ke = load_3x3_solution(ss, NSOLVES_BY_BATCH, 1, batch_rhs);
+
+      // The energies occupy the first lanes of the limiter
+      double phi[NFIELDS_BY_LIMITER] = {cell_ie, cell_ke};
+      double gmax[NFIELDS_BY_LIMITER] = {batch_gmax_ie[(ss)],
+                                         batch_gmax_ke[(ss)]};
+      double gmin[NFIELDS_BY_LIMITER] = {batch_gmin_ie[(ss)],
+                                         batch_gmin_ke[(ss)]};
+      double grad_x[NFIELDS_BY_LIMITER] = {grad_ie.x, grad_ke.x};
+      double grad_y[NFIELDS_BY_LIMITER] = {grad_ie.y, grad_ke.y};
+      double grad_z[NFIELDS_BY_LIMITER] = {grad_ie.z, grad_ke.z};
+      double limiters[NFIELDS_BY_LIMITER];
+      for (int ff = 0; ff < NFIELDS_BY_LIMITER; ++ff) {
+        limiters[(ff)] = 1.0;
+      }
+
+      // Calculate the limiters for the gradients
+      for (int nn = 0; nn < nnodes_by_cell && cells_reconstructed[(cc)];
+           ++nn) {
+        const int node_index = cells_to_nodes[(cell_to_nodes_off + nn)];
+        vec_t node = {nodes_x[(node_index)], nodes_y[(node_index)],
+                      nodes_z[(node_index)]};
+        limit_field_gradients(&node, &cell_c, phi, gmax, gmin, grad_x, grad_y,
+                              grad_z, limiters);
+      }
+
+      // This stops extrema from worsening as part of the gather. Is it
+      // conservative?
+      grad_ie.x *= limiters[(0)];
+      grad_ie.y *= limiters[(0)];
+      grad_ie.z *= limiters[(0)];
+      grad_ke.x *= limiters[(1)];
+      grad_ke.y *= limiters[(1)];
+      grad_ke.z *= limiters[(1)];
+
+      // Subcells are ordered with the nodes on a face
+      for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+        const int subcell_index = cell_to_nodes_off + nn;
+
+        // Calculate the center of mass distance
+        const double dx = subcell_centroids_x[(subcell_index)] - cell_c.x;
+        const double dy = subcell_centroids_y[(subcell_index)] - cell_c.y;
+        const double dz = subcell_centroids_z[(subcell_index)] - cell_c.z;
+
+        // Subcell internal and kinetic energy from linear function at cell
+        subcell_ie_mass[(subcell_index)] =
+            subcell_volume[(subcell_index)] *
+            (cell_ie + grad_ie.x * dx + grad_ie.y * dy + grad_ie.z * dz);
+
+        subcell_ke_mass[(subcell_index)] =
+            subcell_volume[(subcell_index)] *
+            (cell_ke + grad_ke.x * dx + grad_ke.y * dy + grad_ke.z * dz);
+
+        total_ie_in_subcells += subcell_ie_mass[(subcell_index)];
+        total_ke_in_subcells += subcell_ke_mass[(subcell_index)];
+
+        if (subcell_ie_mass[(subcell_index)] < -EPS ||
+            subcell_ke_mass[(subcell_index)] < -EPS) {
+          printf("Negative energy mass %d %.12f %.12f\n", subcell_index,
+                 subcell_ie_mass[(subcell_index)],
+                 subcell_ke_mass[(subcell_index)]);
+        }
+      }
+    }
+  }
+
+  *initial_mass = total_mass;
+  *initial_ie_mass = total_ie_in_subcells;
+  *initial_ke_mass = total_ke_in_subcells;
+
+  printf("Total Energy in Cells    %.12f\n", total_ie_mass + total_ke_mass);
+  printf("Total Energy in Subcells %.12f\n",
+         total_ie_in_subcells + total_ke_in_subcells);
+  printf("Difference               %.12f\n\n",
+         (total_ie_mass + total_ke_mass) -
+             (total_ie_in_subcells + total_ke_in_subcells));
+}
+
+// Gathers the momentum into the subcells
+void gather_subcell_momentum(
+    const int nnodes, const double* nodal_volumes, const double* nodal_mass,
+    int* nodes_to_cells, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, double* velocity_x, double* velocity_y,
+    double* velocity_z, double* subcell_volume, double* cell_centroids_x,
+    double* cell_centroids_y, double* cell_centroids_z,
+    double* subcell_momentum_x, double* subcell_momentum_y,
+    double* subcell_momentum_z, double* subcell_centroids_x,
+    double* subcell_centroids_y, double* subcell_centroids_z,
+    int* nodes_to_cells_offsets, int* nodes_to_subcells,
+    int* nodes_to_nodes_offsets, int* nodes_to_nodes,
+    const int* cells_reconstructed, vec_t* initial_momentum) {
+
+  double initial_momentum_x = 0.0;
+  double initial_momentum_y = 0.0;
+  double initial_momentum_z = 0.0;
+  double total_subcell_vx = 0.0;
+  double total_subcell_vy = 0.0;
+  double total_subcell_vz = 0.0;
+
+#pragma omp parallel for reduction(+ : initial_momentum_x, initial_momentum_y, \
+                                   initial_momentum_z, total_subcell_vx,       \
+                                   total_subcell_vy, total_subcell_vz)
+  for (int nb = 0; nb < nnodes; nb += NSOLVES_BY_BATCH) {
+    const int nsolves = min(NSOLVES_BY_BATCH, nnodes - nb);
+
+    // The least squares systems of a batch of nodes are solved together, with
+    // entry kk of system ss at kk * NSOLVES_BY_BATCH + ss
+    double batch_coeff[NSYM_3X3_ENTRIES * NSOLVES_BY_BATCH];
+    double batch_rhs[3 * 3 * NSOLVES_BY_BATCH];
+    vec_t batch_gmax[NSOLVES_BY_BATCH];
+    vec_t batch_gmin[NSOLVES_BY_BATCH];
+    int batch_reconstructed[NSOLVES_BY_BATCH];
+
+    for (int ss = 0; ss < nsolves; ++ss) {
+      const int nn = nb + ss;
+
+      // Calculate the gradient for the nodal momentum
+      vec_t rhsx = {0.0, 0.0, 0.0};
+      vec_t rhsy = {0.0, 0.0, 0.0};
+      vec_t rhsz = {0.0, 0.0, 0.0};
+      vec_t coeff[3] = {{0.0, 0.0, 0.0}};
+      vec_t gmin = {DBL_MAX, DBL_MAX, DBL_MAX};
+      vec_t gmax = {-DBL_MAX, -DBL_MAX, -DBL_MAX};
+      vec_t node = {nodes_x[(nn)], nodes_y[(nn)], nodes_z[(nn)]};
+
+      const double nodal_density = nodal_mass[(nn)] / nodal_volumes[(nn)];
+      vec_t node_mom_density = {nodal_density * velocity_x[(nn)],
+                                nodal_density * velocity_y[(nn)],
+                                nodal_density * velocity_z[(nn)]};
+
+      initial_momentum_x += nodal_mass[(nn)] * velocity_x[(nn)];
+      initial_momentum_y += nodal_mass[(nn)] * velocity_y[(nn)];
+      initial_momentum_z += nodal_mass[(nn)] * velocity_z[(nn)];
+
+      // A node whose subcells are all in cells that the advection does not
+      // reconstruct from is gathered at its mean momentum density
+      const int node_to_cells_off = nodes_to_cells_offsets[(nn)];
+      const int ncells_by_node =
+          nodes_to_cells_offsets[(nn + 1)] - node_to_cells_off;
+      int is_reconstructed = 0;
+      for (int cc = 0; cc < ncells_by_node; ++cc) {
+        is_reconstructed |=
+            cells_reconstructed[(nodes_to_cells[(node_to_cells_off + cc)])];
+      }
+      if (!is_reconstructed) {
+        coeff[0].x = 1.0;
+        coeff[1].y = 1.0;
+        coeff[2].z = 1.0;
+      }
+
+      const int node_to_nodes_off = nodes_to_nodes_offsets[(nn)];
+      const int nnodes_by_node =
+          nodes_to_nodes_offsets[(nn + 1)] - node_to_nodes_off;
+
+      for (int nn2 = 0; nn2 < nnodes_by_node && is_reconstructed; ++nn2) {
+        const int neighbour_index = nodes_to_nodes[(node_to_nodes_off + nn2)];
+
+        if (neighbour_index == -1) {
+          continue;
+        }
+
+        // Calculate the center of mass distance
+        vec_t i = {nodes_x[(neighbour_index)] - node.x,
+                   nodes_y[(neighbour_index)] - node.y,
+                   nodes_z[(neighbour_index)] - node.z};
+
+        // Store the neighbouring cell's contribution to the coefficients
+        double neighbour_vol = nodal_volumes[(neighbour_index)];
+        coeff[0].x += 2.0 * (i.x * i.x) / (neighbour_vol * neighbour_vol);
+        coeff[0].y += 2.0 * (i.x * i.y) / (neighbour_vol * neighbour_vol);
+        coeff[0].z += 2.0 * (i.x * i.z) / (neighbour_vol * neighbour_vol);
+        coeff[1].x += 2.0 * (i.y * i.x) / (neighbour_vol * neighbour_vol);
+        coeff[1].y += 2.0 * (i.y * i.y) / (neighbour_vol * neighbour_vol);
+        coeff[1].z += 2.0 * (i.y * i.z) / (neighbour_vol * neighbour_vol);
+        coeff[2].x += 2.0 * (i.z * i.x) / (neighbour_vol * neighbour_vol);
+        coeff[2].y += 2.0 * (i.z * i.y) / (neighbour_vol * neighbour_vol);
+        coeff[2].z += 2.0 * (i.z * i.z) / (neighbour_vol * neighbour_vol);
+
+        const double neighbour_nodal_density =
+            nodal_mass[(neighbour_index)] / nodal_volumes[(neighbour_index)];
+
+        vec_t neighbour_mom_density = {
+            neighbour_nodal_density * velocity_x[(neighbour_index)],
+            neighbour_nodal_density * velocity_y[(neighbour_index)],
+            neighbour_nodal_density * velocity_z[(neighbour_index)]};
+
+        gmax.x = max(gmax.x, neighbour_mom_density.x);
+        gmin.x = min(gmin.x, neighbour_mom_density.x);
+        gmax.y = max(gmax.y, neighbour_mom_density.y);
+        gmin.y = min(gmin.y, neighbour_mom_density.y);
+        gmax.z = max(gmax.z, neighbour_mom_density.z);
+        gmin.z = min(gmin.z, neighbour_mom_density.z);
+
+        vec_t dv = {(neighbour_mom_density.x - node_mom_density.x),
+                    (neighbour_mom_density.y - node_mom_density.y),
+                    (neighbour_mom_density.z - node_mom_density.z)};
+
+        rhsx.x += 2.0 * i.x * dv.x / neighbour_vol;
+        rhsx.y += 2.0 * i.y * dv.x / neighbour_vol;
+        rhsx.z += 2.0 * i.z * dv.x / neighbour_vol;
+        rhsy.x += 2.0 * i.x * dv.y / neighbour_vol;
+        rhsy.y += 2.0 * i.y * dv.y / neighbour_vol;
+        rhsy.z += 2.0 * i.z * dv.y / neighbour_vol;
+        rhsz.x += 2.0 * i.x * dv.z / neighbour_vol;
+        rhsz.y += 2.0 * i.y * dv.z / neighbour_vol;
+        rhsz.z += 2.0 * i.z * dv.z / neighbour_vol;
+      }
+
+      store_sym_3x3_system(ss, NSOLVES_BY_BATCH, coeff, batch_coeff);
+      store_3x3_rhs(ss, NSOLVES_BY_BATCH, 0, &rhsx, batch_rhs);
+      store_3x3_rhs(ss, NSOLVES_BY_BATCH, 1, &rhsy, batch_rhs);
+      store_3x3_rhs(ss, NSOLVES_BY_BATCH, 2, &rhsz, batch_rhs);
+      batch_gmax[(ss)] = gmax;
+      batch_gmin[(ss)] = gmin;
+      batch_reconstructed[(ss)] = is_reconstructed;
+    }
+
+    // Solve for the velocity density gradients
+    solve_sym_3x3_batch(nsolves, NSOLVES_BY_BATCH, 3, batch_coeff, batch_rhs);
+
+    for (int ss = 0; ss < nsolves; ++ss) {
+      const int nn = nb + ss;
+      vec_t gmin = batch_gmin[(ss)];
+      vec_t gmax = batch_gmax[(ss)];
+      vec_t node = {nodes_x[(nn)], nodes_y[(nn)], nodes_z[(nn)]};
+
+      const double nodal_density = nodal_mass[(nn)] / nodal_volumes[(nn)];
+      vec_t node_mom_density = {nodal_density * velocity_x[(nn)],
+                                nodal_density * velocity_y[(nn)],
+                                nodal_density * velocity_z[(nn)]};
+
+      vec_t grad_vx = load_3x3_solution(ss, NSOLVES_BY_BATCH, 0, batch_rhs);
+      vec_t grad_vy = load_3x3_solution(ss, NSOLVES_BY_BATCH, 1, batch_rhs);
+      vec_t grad_vz = load_3x3_solution(ss, NSOLVES_BY_BATCH, 2, batch_rhs);
+
+      // The momentum densities occupy the first lanes of the limiter
+      double phi[NFIELDS_BY_LIMITER] = {
+          node_mom_density.x, node_mom_density.y, node_mom_density.z};
+      double gmax_v[NFIELDS_BY_LIMITER] = {gmax.x, gmax.y, gmax.z};
+      double gmin_v[NFIELDS_BY_LIMITER] = {gmin.x, gmin.y, gmin.z};
+      double grad_x[NFIELDS_BY_LIMITER] = {grad_vx.x, grad_vy.x, grad_vz.x};
+      double grad_y[NFIELDS_BY_LIMITER] = {grad_vx.y, grad_vy.y, grad_vz.y};
+      double grad_z[NFIELDS_BY_LIMITER] = {grad_vx.z, grad_vy.z, grad_vz.z};
+      double limiters[NFIELDS_BY_LIMITER];
+      for (int ff = 0; ff < NFIELDS_BY_LIMITER; ++ff) {
+        limiters[(ff)] = 1.0;
+      }
+
+      // Limit the gradients
+      const int node_to_cells_off = nodes_to_cells_offsets[(nn)];
+      const int ncells_by_node =
+          nodes_to_cells_offsets[(nn + 1)] - node_to_cells_off;
+      for (int cc = 0; cc < ncells_by_node && batch_reconstructed[(ss)];
+           ++cc) {
+        const int cell_index = nodes_to_cells[(node_to_cells_off + cc)];
+
+        vec_t cell_c = {cell_centroids_x[(cell_index)],
+                        cell_centroids_y[(cell_index)],
+                        cell_centroids_z[(cell_index)]};
+        limit_field_gradients(&cell_c, &node, phi, gmax_v, gmin_v, grad_x,
+                              grad_y, grad_z, limiters);
+      }
+
+      // This stops extrema from worsening as part of the gather. Is it
+      // conservative?
+      grad_vx.x *= limiters[(0)];
+      grad_vx.y *= limiters[(0)];
+      grad_vx.z *= limiters[(0)];
+      grad_vy.x *= limiters[(1)];
+      grad_vy.y *= limiters[(1)];
+      grad_vy.z *= limiters[(1)];
+      grad_vz.x *= limiters[(2)];
+      grad_vz.y *= limiters[(2)];
+      grad_vz.z *= limiters[(2)];
+
+      for (int cc = 0; cc < ncells_by_node; ++cc) {
+        const int subcell_index = nodes_to_subcells[(node_to_cells_off + cc)];
+
+        const double vol = subcell_volume[(subcell_index)];
+        const double dx = subcell_centroids_x[(subcell_index)] - nodes_x[(nn)];
+        const double dy = subcell_centroids_y[(subcell_index)] - nodes_y[(nn)];
+        const double dz = subcell_centroids_z[(subcell_index)] - nodes_z[(nn)];
+
+        subcell_momentum_x[(subcell_index)] =
+            vol * (node_mom_density.x + grad_vx.x * dx + grad_vx.y * dy +
+                   grad_vx.z * dz);
+        subcell_momentum_y[(subcell_index)] =
+            vol * (node_mom_density.y + grad_vy.x * dx + grad_vy.y * dy +
+                   grad_vy.z * dz);
+        subcell_momentum_z[(subcell_index)] =
+            vol * (node_mom_density.z + grad_vz.x * dx + grad_vz.y * dy +
+                   grad_vz.z * dz);
+
+        total_subcell_vx += subcell_momentum_x[(subcell_index)];
+        total_subcell_vy += subcell_momentum_y[(subcell_index)];
+        total_subcell_vz += subcell_momentum_z[(subcell_index)];
+      }
+    }
+  }
+
+  initial_momentum->x = total_subcell_vx;
+  initial_momentum->y = total_subcell_vy;
+  initial_momentum->z = total_subcell_vz;
+
+  printf("Total Momentum in Cells    (%.12f,%.12f,%.12f)\n", initial_momentum_x,
+         initial_momentum_y, initial_momentum_z);
+  printf("Total Momentum in Subcells (%.12f,%.12f,%.12f)\n", total_subcell_vx,
+         total_subcell_vy, total_subcell_vz);
+  printf("Difference                 (%.12f,%.12f,%.12f)\n\n",
+         initial_momentum_x - total_subcell_vx,
+         initial_momentum_y - total_subcell_vy,
+         initial_momentum_z - total_subcell_vz);
+}
+
+// Calculates the kinetic energy of each cell from its subcell masses and the
+// velocities of its nodes, returning the total
+double calc_cell_ke_mass(const int ncells, const int* cells_to_nodes_offsets,
+                         const int* cells_to_nodes, const double* subcell_mass,
+                         const double* velocity_x, const double* velocity_y,
+                         const double* velocity_z, double* ke_mass) {
+
   double total_ke_mass = 0.0;
 
-// We first have to determine the cell centered kinetic energy
 #pragma omp parallel for reduction(+ : total_ke_mass)
   for (int cc = 0; cc < ncells; ++cc) {
     const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
@@ -129,160 +654,53 @@ void gather_subcell_mass_and_energy(
     total_ke_mass += ke_mass[(cc)];
   }
 
+  return total_ke_mass;
+}
+
+// Gathers the mass and energy into the subcells at the mean densities of their
+// cells, for the first order remap
+void gather_constant_subcell_mass_and_energy(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* cells_to_nodes, const double* cell_volume,
+    const double* energy, const double* density, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    const double* cell_mass, const double* subcell_mass,
+    const double* subcell_volume, double* ke_mass, double* subcell_ie_mass,
+    double* subcell_ke_mass, double* initial_mass, double* initial_ie_mass,
+    double* initial_ke_mass) {
+
+  double total_mass = 0.0;
+  double total_ie_mass = 0.0;
+  const double total_ke_mass =
+      calc_cell_ke_mass(ncells, cells_to_nodes_offsets, cells_to_nodes,
+                        subcell_mass, velocity_x, velocity_y, velocity_z,
+                        ke_mass);
+
   double total_ie_in_subcells = 0.0;
   double total_ke_in_subcells = 0.0;
 
-// Calculate the sub-cell internal and kinetic energies
 #pragma omp parallel for reduction(+ : total_mass, total_ie_mass,              \
                                    total_ie_in_subcells, total_ke_in_subcells)
   for (int cc = 0; cc < ncells; ++cc) {
-    // Calculating the volume dist necessary for the least squares
-    // regression
-    const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
-    const int nfaces_by_cell =
-        cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
     const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
     const int nnodes_by_cell =
         cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
 
     const double cell_ie = density[(cc)] * energy[(cc)];
     const double cell_ke = ke_mass[(cc)] / cell_volume[(cc)];
-    vec_t cell_c = {0.0, 0.0, 0.0};
-    calc_centroid(nnodes_by_cell, nodes_x, nodes_y, nodes_z, cells_to_nodes,
-                  cell_to_nodes_off, &cell_c);
-
-    vec_t ie_rhs = {0.0, 0.0, 0.0};
-    vec_t ke_rhs = {0.0, 0.0, 0.0};
-    vec_t coeff[3] = {{0.0, 0.0, 0.0}};
 
     total_mass += cell_mass[(cc)];
     total_ie_mass += cell_mass[(cc)] * energy[(cc)];
 
-    // Determine the weighted volume dist for neighbouring cells
-    double gmax_ie = -DBL_MAX;
-    double gmin_ie = DBL_MAX;
-    double gmax_ke = -DBL_MAX;
-    double gmin_ke = DBL_MAX;
-    for (int ff = 0; ff < nfaces_by_cell; ++ff) {
-      const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
-      const int neighbour_index = (faces_to_cells0[(face_index)] == cc)
-                                      ? faces_to_cells1[(face_index)]
-                                      : faces_to_cells0[(face_index)];
-
-      // Check if boundary face
-      if (neighbour_index == -1) {
-        continue;
-      }
-
-      vec_t dist = {cell_centroids_x[(neighbour_index)] - cell_c.x,
-                    cell_centroids_y[(neighbour_index)] - cell_c.y,
-                    cell_centroids_z[(neighbour_index)] - cell_c.z};
-
-      // Store the neighbouring cell's contribution to the coefficients
-      double neighbour_vol = cell_volume[(neighbour_index)];
-      coeff[0].x += 2.0 * (dist.x * dist.x) / (neighbour_vol * neighbour_vol);
-      coeff[0].y += 2.0 * (dist.x * dist.y) / (neighbour_vol * neighbour_vol);
-      coeff[0].z += 2.0 * (dist.x * dist.z) / (neighbour_vol * neighbour_vol);
-      coeff[1].x += 2.0 * (dist.y * dist.x) / (neighbour_vol * neighbour_vol);
-      coeff[1].y += 2.0 * (dist.y * dist.y) / (neighbour_vol * neighbour_vol);
-      coeff[1].z += 2.0 * (dist.y * dist.z) / (neighbour_vol * neighbour_vol);
-      coeff[2].x += 2.0 * (dist.z * dist.x) / (neighbour_vol * neighbour_vol);
-      coeff[2].y += 2.0 * (dist.z * dist.y) / (neighbour_vol * neighbour_vol);
-      coeff[2].z += 2.0 * (dist.z * dist.z) / (neighbour_vol * neighbour_vol);
-
-      const double neighbour_ie =
-          density[(neighbour_index)] * energy[(neighbour_index)];
-      const double neighbour_ke = ke_mass[(neighbour_index)] / neighbour_vol;
-
-      gmax_ie = max(gmax_ie, neighbour_ie);
-      gmin_ie = min(gmin_ie, neighbour_ie);
-      gmax_ke = max(gmax_ke, neighbour_ke);
-      gmin_ke = min(gmin_ke, neighbour_ke);
-
-      // Prepare the RHS, which includes energy differential
-      const double die = (neighbour_ie - cell_ie);
-      const double dke = (neighbour_ke - cell_ke);
-      ie_rhs.x += 2.0 * (dist.x * die) / neighbour_vol;
-      ie_rhs.y += 2.0 * (dist.y * die) / neighbour_vol;
-      ie_rhs.z += 2.0 * (dist.z * die) / neighbour_vol;
-      ke_rhs.x += 2.0 * (dist.x * dke) / neighbour_vol;
-      ke_rhs.y += 2.0 * (dist.y * dke) / neighbour_vol;
-      ke_rhs.z += 2.0 * (dist.z * dke) / neighbour_vol;
-    }
-
-    // Determine the inverse of the coefficient matrix
-    vec_t inv[3];
-    calc_3x3_inverse(&coeff, &inv);
-
-    // Solve for the internal and kinetic energy gradients
-    vec_t grad_ie = {
-        inv[0].x * ie_rhs.x + inv[0].y * ie_rhs.y + inv[0].z * ie_rhs.z,
-        inv[1].x * ie_rhs.x + inv[1].y * ie_rhs.y + inv[1].z * ie_rhs.z,
-        inv[2].x * ie_rhs.x + inv[2].y * ie_rhs.y + inv[2].z * ie_rhs.z};
-    vec_t grad_ke = {
-        inv[0].x * ke_rhs.x + inv[0].y * ke_rhs.y + inv[0].z * ke_rhs.z,
-        inv[1].x * ke_rhs.x + inv[1].y * ke_rhs.y + inv[1].z * ke_rhs.z,
-        inv[2].x * ke_rhs.x + inv[2].y * ke_rhs.y + inv[2].z * ke_rhs.z};
-
-    // Calculate the limiter for the gradient
-    double limiter = 1.0;
-    for (int nn = 0; nn < nnodes_by_cell; ++nn) {
-      const int node_index = cells_to_nodes[(cell_to_nodes_off + nn)];
-      limiter = min(limiter, calc_cell_limiter(cell_ie, gmax_ie, gmin_ie,
-                                               &grad_ie, nodes_x[(node_index)],
-                                               nodes_y[(node_index)],
-                                               nodes_z[(node_index)], &cell_c));
-    }
-
-    // This stops extrema from worsening as part of the gather. Is it
-    // conservative?
-    grad_ie.x *= limiter;
-    grad_ie.y *= limiter;
-    grad_ie.z *= limiter;
-
-    // Calculate the limiter for the gradient
-    limiter = 1.0;
-    for (int nn = 0; nn < nnodes_by_cell; ++nn) {
-      const int node_index = cells_to_nodes[(cell_to_nodes_off + nn)];
-      limiter = min(limiter, calc_cell_limiter(cell_ke, gmax_ke, gmin_ke,
-                                               &grad_ke, nodes_x[(node_index)],
-                                               nodes_y[(node_index)],
-                                               nodes_z[(node_index)], &cell_c));
-    }
-
-    // This stops extrema from worsening as part of the gather. Is it
-    // conservative?
-    grad_ie.x *= limiter;
-    grad_ie.y *= limiter;
-    grad_ie.z *= limiter;
-
-    // Subcells are ordered with the nodes on a face
     for (int nn = 0; nn < nnodes_by_cell; ++nn) {
       const int subcell_index = cell_to_nodes_off + nn;
-
-      // Calculate the center of mass distance
-      const double dx = subcell_centroids_x[(subcell_index)] - cell_c.x;
-      const double dy = subcell_centroids_y[(subcell_index)] - cell_c.y;
-      const double dz = subcell_centroids_z[(subcell_index)] - cell_c.z;
-
-      // Subcell internal and kinetic energy from linear function at cell
       subcell_ie_mass[(subcell_index)] =
-          subcell_volume[(subcell_index)] *
-          (cell_ie + grad_ie.x * dx + grad_ie.y * dy + grad_ie.z * dz);
-
+          subcell_volume[(subcell_index)] * cell_ie;
       subcell_ke_mass[(subcell_index)] =
-          subcell_volume[(subcell_index)] *
-          (cell_ke + grad_ke.x * dx + grad_ke.y * dy + grad_ke.z * dz);
+          subcell_volume[(subcell_index)] * cell_ke;
 
       total_ie_in_subcells += subcell_ie_mass[(subcell_index)];
       total_ke_in_subcells += subcell_ke_mass[(subcell_index)];
-
-      if (subcell_ie_mass[(subcell_index)] < -EPS ||
-          subcell_ke_mass[(subcell_index)] < -EPS) {
-        printf("Negative energy mass %d %.12f %.12f\n", subcell_index,
-               subcell_ie_mass[(subcell_index)],
-               subcell_ke_mass[(subcell_index)]);
-      }
     }
   }
 
@@ -298,19 +716,15 @@ void gather_subcell_mass_and_energy(
              (total_ie_in_subcells + total_ke_in_subcells));
 }
 
-// Gathers the momentum into the subcells
-void gather_subcell_momentum(
+// Gathers the momentum into the subcells at the mean momentum densities of
+// their nodes, for the first order remap
+void gather_constant_subcell_momentum(
     const int nnodes, const double* nodal_volumes, const double* nodal_mass,
-    int* nodes_to_cells, const double* nodes_x, const double* nodes_y,
-    const double* nodes_z, double* velocity_x, double* velocity_y,
-    double* velocity_z, double* subcell_volume, double* cell_centroids_x,
-    double* cell_centroids_y, double* cell_centroids_z,
+    const double* velocity_x, const double* velocity_y,
+    const double* velocity_z, const double* subcell_volume,
+    const int* nodes_to_cells_offsets, const int* nodes_to_subcells,
     double* subcell_momentum_x, double* subcell_momentum_y,
-    double* subcell_momentum_z, double* subcell_centroids_x,
-    double* subcell_centroids_y, double* subcell_centroids_z,
-    int* nodes_to_cells_offsets, int* cells_to_nodes_offsets,
-    int* cells_to_nodes, int* nodes_to_nodes_offsets, int* nodes_to_nodes,
-    vec_t* initial_momentum) {
+    double* subcell_momentum_z, vec_t* initial_momentum) {
 
   double initial_momentum_x = 0.0;
   double initial_momentum_y = 0.0;
@@ -323,16 +737,6 @@ void gather_subcell_momentum(
                                    initial_momentum_z, total_subcell_vx,       \
                                    total_subcell_vy, total_subcell_vz)
   for (int nn = 0; nn < nnodes; ++nn) {
-
-    // Calculate the gradient for the nodal momentum
-    vec_t rhsx = {0.0, 0.0, 0.0};
-    vec_t rhsy = {0.0, 0.0, 0.0};
-    vec_t rhsz = {0.0, 0.0, 0.0};
-    vec_t coeff[3] = {{0.0, 0.0, 0.0}};
-    vec_t gmin = {DBL_MAX, DBL_MAX, DBL_MAX};
-    vec_t gmax = {-DBL_MAX, -DBL_MAX, -DBL_MAX};
-    vec_t node = {nodes_x[(nn)], nodes_y[(nn)], nodes_z[(nn)]};
-
     const double nodal_density = nodal_mass[(nn)] / nodal_volumes[(nn)];
     vec_t node_mom_density = {nodal_density * velocity_x[(nn)],
                               nodal_density * velocity_y[(nn)],
@@ -342,148 +746,16 @@ void gather_subcell_momentum(
     initial_momentum_y += nodal_mass[(nn)] * velocity_y[(nn)];
     initial_momentum_z += nodal_mass[(nn)] * velocity_z[(nn)];
 
-    const int node_to_nodes_off = nodes_to_nodes_offsets[(nn)];
-    const int nnodes_by_node =
-        nodes_to_nodes_offsets[(nn + 1)] - node_to_nodes_off;
-
-    for (int nn2 = 0; nn2 < nnodes_by_node; ++nn2) {
-      const int neighbour_index = nodes_to_nodes[(node_to_nodes_off + nn2)];
-
-      if (neighbour_index == -1) {
-        continue;
-      }
-
-      // Calculate the center of mass distance
-      vec_t i = {nodes_x[(neighbour_index)] - node.x,
-                 nodes_y[(neighbour_index)] - node.y,
-                 nodes_z[(neighbour_index)] - node.z};
-
-      // Store the neighbouring cell's contribution to the coefficients
-      double neighbour_vol = nodal_volumes[(neighbour_index)];
-      coeff[0].x += 2.0 * (i.x * i.x) / (neighbour_vol * neighbour_vol);
-      coeff[0].y += 2.0 * (i.x * i.y) / (neighbour_vol * neighbour_vol);
-      coeff[0].z += 2.0 * (i.x * i.z) / (neighbour_vol * neighbour_vol);
-      coeff[1].x += 2.0 * (i.y * i.x) / (neighbour_vol * neighbour_vol);
-      coeff[1].y += 2.0 * (i.y * i.y) / (neighbour_vol * neighbour_vol);
-      coeff[1].z += 2.0 * (i.y * i.z) / (neighbour_vol * neighbour_vol);
-      coeff[2].x += 2.0 * (i.z * i.x) / (neighbour_vol * neighbour_vol);
-      coeff[2].y += 2.0 * (i.z * i.y) / (neighbour_vol * neighbour_vol);
-      coeff[2].z += 2.0 * (i.z * i.z) / (neighbour_vol * neighbour_vol);
-
-      const double neighbour_nodal_density =
-          nodal_mass[(neighbour_index)] / nodal_volumes[(neighbour_index)];
-
-      vec_t neighbour_mom_density = {
-          neighbour_nodal_density * velocity_x[(neighbour_index)],
-          neighbour_nodal_density * velocity_y[(neighbour_index)],
-          neighbour_nodal_density * velocity_z[(neighbour_index)]};
-
-      gmax.x = max(gmax.x, neighbour_mom_density.x);
-      gmin.x = min(gmin.x, neighbour_mom_density.x);
-      gmax.y = max(gmax.y, neighbour_mom_density.y);
-      gmin.y = min(gmin.y, neighbour_mom_density.y);
-      gmax.z = max(gmax.z, neighbour_mom_density.z);
-      gmin.z = min(gmin.z, neighbour_mom_density.z);
-
-      vec_t dv = {(neighbour_mom_density.x - node_mom_density.x),
-                  (neighbour_mom_density.y - node_mom_density.y),
-                  (neighbour_mom_density.z - node_mom_density.z)};
-
-      rhsx.x += 2.0 * i.x * dv.x / neighbour_vol;
-      rhsx.y += 2.0 * i.y * dv.x / neighbour_vol;
-      rhsx.z += 2.0 * i.z * dv.x / neighbour_vol;
-      rhsy.x += 2.0 * i.x * dv.y / neighbour_vol;
-      rhsy.y += 2.0 * i.y * dv.y / neighbour_vol;
-      rhsy.z += 2.0 * i.z * dv.y / neighbour_vol;
-      rhsz.x += 2.0 * i.x * dv.z / neighbour_vol;
-      rhsz.y += 2.0 * i.y * dv.z / neighbour_vol;
-      rhsz.z += 2.0 * i.z * dv.z / neighbour_vol;
-    }
-
-    // Determine the inverse of the coefficient matrix
-    vec_t inv[3];
-    calc_3x3_inverse(&coeff, &inv);
-
-    // Solve for the velocity density gradients
-    vec_t grad_vx = {inv[0].x * rhsx.x + inv[0].y * rhsx.y + inv[0].z * rhsx.z,
-                     inv[1].x * rhsx.x + inv[1].y * rhsx.y + inv[1].z * rhsx.z,
-                     inv[2].x * rhsx.x + inv[2].y * rhsx.y + inv[2].z * rhsx.z};
-    vec_t grad_vy = {inv[0].x * rhsy.x + inv[0].y * rhsy.y + inv[0].z * rhsy.z,
-                     inv[1].x * rhsy.x + inv[1].y * rhsy.y + inv[1].z * rhsy.z,
-                     inv[2].x * rhsy.x + inv[2].y * rhsy.y + inv[2].z * rhsy.z};
-    vec_t grad_vz = {inv[0].x * rhsz.x + inv[0].y * rhsz.y + inv[0].z * rhsz.z,
-                     inv[1].x * rhsz.x + inv[1].y * rhsz.y + inv[1].z * rhsz.z,
-                     inv[2].x * rhsz.x + inv[2].y * rhsz.y + inv[2].z * rhsz.z};
-
-    // Limit the gradients
-    double vx_limiter = 1.0;
-    double vy_limiter = 1.0;
-    double vz_limiter = 1.0;
     const int node_to_cells_off = nodes_to_cells_offsets[(nn)];
     const int ncells_by_node =
         nodes_to_cells_offsets[(nn + 1)] - node_to_cells_off;
     for (int cc = 0; cc < ncells_by_node; ++cc) {
-      const int cell_index = nodes_to_cells[(node_to_cells_off + cc)];
-
-      vec_t cell_c = {cell_centroids_x[(cell_index)],
-                      cell_centroids_y[(cell_index)],
-                      cell_centroids_z[(cell_index)]};
-      vx_limiter =
-          min(vx_limiter,
-              calc_cell_limiter(node_mom_density.x, gmax.x, gmin.x, &grad_vx,
-                                cell_c.x, cell_c.y, cell_c.z, &node));
-      vy_limiter =
-          min(vy_limiter,
-              calc_cell_limiter(node_mom_density.y, gmax.y, gmin.y, &grad_vy,
-                                cell_c.x, cell_c.y, cell_c.z, &node));
-      vz_limiter =
-          min(vz_limiter,
-              calc_cell_limiter(node_mom_density.z, gmax.z, gmin.z, &grad_vz,
-                                cell_c.x, cell_c.y, cell_c.z, &node));
-    }
-
-    // This stops extrema from worsening as part of the gather. Is it
-    // conservative?
-    grad_vx.x *= vx_limiter;
-    grad_vx.y *= vx_limiter;
-    grad_vx.z *= vx_limiter;
-    grad_vy.x *= vy_limiter;
-    grad_vy.y *= vy_limiter;
-    grad_vy.z *= vy_limiter;
-    grad_vz.x *= vz_limiter;
-    grad_vz.y *= vz_limiter;
-    grad_vz.z *= vz_limiter;
-
-    for (int cc = 0; cc < ncells_by_node; ++cc) {
-      const int cell_index = nodes_to_cells[(node_to_cells_off + cc)];
-      const int cell_to_nodes_off = cells_to_nodes_offsets[(cell_index)];
-      const int nnodes_by_cell =
-          cells_to_nodes_offsets[(cell_index + 1)] - cell_to_nodes_off;
-
-      // Determine the position of the node in the cell
-      int nn2;
-      for (nn2 = 0; nn2 < nnodes_by_cell; ++nn2) {
-        if (cells_to_nodes[(cell_to_nodes_off + nn2)] == nn) {
-          break;
-        }
-      }
-
-      const int subcell_index = cell_to_nodes_off + nn2;
-
+      const int subcell_index = nodes_to_subcells[(node_to_cells_off + cc)];
       const double vol = subcell_volume[(subcell_index)];
-      const double dx = subcell_centroids_x[(subcell_index)] - nodes_x[(nn)];
-      const double dy = subcell_centroids_y[(subcell_index)] - nodes_y[(nn)];
-      const double dz = subcell_centroids_z[(subcell_index)] - nodes_z[(nn)];
-
-      subcell_momentum_x[(subcell_index)] =
-          vol * (node_mom_density.x + grad_vx.x * dx + grad_vx.y * dy +
-                 grad_vx.z * dz);
-      subcell_momentum_y[(subcell_index)] =
-          vol * (node_mom_density.y + grad_vy.x * dx + grad_vy.y * dy +
-                 grad_vy.z * dz);
-      subcell_momentum_z[(subcell_index)] =
-          vol * (node_mom_density.z + grad_vz.x * dx + grad_vz.y * dy +
-                 grad_vz.z * dz);
+
+      subcell_momentum_x[(subcell_index)] = vol * node_mom_density.x;
+      subcell_momentum_y[(subcell_index)] = vol * node_mom_density.y;
+      subcell_momentum_z[(subcell_index)] = vol * node_mom_density.z;
 
       total_subcell_vx += subcell_momentum_x[(subcell_index)];
       total_subcell_vy += subcell_momentum_y[(subcell_index)];
@@ -16,15 +16,24 @@ void solve_unstructured_hydro_3d(Mesh* mesh, HaleData* hale_data,
   if (timestep == 0) {
     printf("\nInitialising timestep and storing initial mesh.\n");
 
-    set_timestep(umesh->ncells, umesh->nodes_x0, umesh->nodes_y0,
-                 umesh->nodes_z0, hale_data->energy0, &mesh->dt,
-                 umesh->cells_to_faces_offsets, umesh->cells_to_faces,
-                 umesh->faces_to_nodes_offsets, umesh->faces_to_nodes);
+    const time_limit_t edge_limit = update_face_geometry(
+        umesh, hale_data, umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0,
+        hale_data->energy0, hale_data->velocity_x0, hale_data->velocity_y0,
+        hale_data->velocity_z0);
+
+    // The predictor expects the subcell geometry of the current mesh
+    update_subcell_geometry(umesh, hale_data, umesh->nodes_x0, umesh->nodes_y0,
+                            umesh->nodes_z0);
+
+    // There is no previous timestep or volume change to bound the first step
+    const time_limit_t volume_limit = {DBL_MAX, -1};
+    set_timestep(0.0, 0.0, edge_limit, volume_limit, &mesh->dt);
 
     // We are storing our original mesh to allow an Eulerian remap
     store_rezoned_mesh(umesh->nnodes, umesh->nodes_x0, umesh->nodes_y0,
                        umesh->nodes_z0, hale_data->rezoned_nodes_x,
                        hale_data->rezoned_nodes_y, hale_data->rezoned_nodes_z);
+    hale_data->rezoned_geometry_valid = 0;
   }
 
   // Describe the subcell node layout
@@ -32,6 +41,20 @@ void solve_unstructured_hydro_3d(Mesh* mesh, HaleData* hale_data,
 
   struct Profile out;
 
+  // Restricts the Lagrangian kernels to the cells and nodes that can change
+  if (hale_data->frontier) {
+    START_PROFILING(&out);
+    update_frontier(umesh, hale_data);
+    STOP_PROFILING(&out, "Frontier update");
+    printf("Frontier has %d of %d cells\n", hale_data->nfrontier_cells,
+           umesh->ncells);
+  }
+
+  // Keeps the state at the start of the step to verify the frontier against
+  if (hale_data->frontier && hale_data->frontier_verify) {
+    store_frontier_state(mesh, umesh, hale_data);
+  }
+
   // Perform the Lagrangian phase of the ALE algorithm where the mesh will
   // move
   // due to the pressure (ideal gas) and artificial viscous forces
@@ -39,6 +62,19 @@ void solve_unstructured_hydro_3d(Mesh* mesh, HaleData* hale_data,
   lagrangian_phase(mesh, umesh, hale_data);
   STOP_PROFILING(&out, "Lagrangian phase");
 
+  if (hale_data->frontier) {
+    check_frontier(hale_data->nfrontier_halo_nodes,
+                   hale_data->frontier_halo_nodes, hale_data->velocity_x0,
+                   hale_data->velocity_y0, hale_data->velocity_z0);
+  }
+
+  // Repeats the step with the dense kernels and compares the results
+  if (hale_data->frontier && hale_data->frontier_verify) {
+    START_PROFILING(&out);
+    verify_frontier(mesh, umesh, hale_data);
+    STOP_PROFILING(&out, "Frontier verification");
+  }
+
   if (hale_data->visit_dump) {
     write_unstructured_to_visit_3d(umesh->nnodes, umesh->ncells, timestep * 2,
                                    umesh->nodes_x0, umesh->nodes_y0,
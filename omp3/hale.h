@@ -4,12 +4,110 @@
 // Performs the Lagrangian step of the hydro solve
 void lagrangian_phase(Mesh* mesh, UnstructuredMesh* umesh, HaleData* hale_data);
 
-// Controls the timestep for the simulation
-void set_timestep(const int ncells, const double* nodes_x,
-                  const double* nodes_y, const double* nodes_z,
-                  const double* energy, double* dt, int* cells_to_faces_offsets,
-                  int* cells_to_faces, int* faces_to_nodes_offsets,
-                  int* faces_to_nodes);
+// Controls the timestep for the simulation. The timestep is the smaller of
+// the CFL limited edge signal time and the time for any cell to change its
+// volume by the maximum fraction, and grows from the previous timestep by at
+// most the growth factor. A zero volume change or growth factor is unbounded.
+void set_timestep(const double max_dt_growth, const double max_volume_change,
+                  const time_limit_t edge_limit,
+                  const time_limit_t volume_limit, double* dt);
+
+// Calculates the face centroids, the area vectors of the tetrahedral faces
+// swept from each face edge and the edge lengths for the current mesh state.
+// When the energy is provided, the shortest time for a signal to cross an
+// edge, at the speed of sound plus the edge's fastest node speed, is returned
+// with the cell it was taken from
+time_limit_t calc_face_geometry(
+    const int nfaces, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_to_cells1, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, const double* energy, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    double* face_centroids_x, double* face_centroids_y,
+    double* face_centroids_z, double* face_edge_area_x,
+    double* face_edge_area_y, double* face_edge_area_z,
+    double* face_edge_lengths);
+
+// Calculates the face geometry for a hexahedral mesh, returning the shortest
+// edge signal time if the energy is provided
+time_limit_t calc_face_geometry_hex(
+    const int nfaces, const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_to_cells1, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, const double* energy, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    double* face_centroids_x, double* face_centroids_y,
+    double* face_centroids_z, double* face_edge_area_x,
+    double* face_edge_area_y, double* face_edge_area_z,
+    double* face_edge_lengths);
+
+// Updates the cached face geometry, with the hexahedral or general kernel.
+// When the energy is provided, the shortest edge signal time for the
+// timestep is returned, otherwise the time is DBL_MAX
+time_limit_t update_face_geometry(UnstructuredMesh* umesh,
+                                  HaleData* hale_data, const double* nodes_x,
+                                  const double* nodes_y, const double* nodes_z,
+                                  const double* energy,
+                                  const double* velocity_x,
+                                  const double* velocity_y,
+                                  const double* velocity_z);
+
+// Reduces a timestep constraint to the smaller time, taking the lower cell
+// index on ties so the limiting cell doesn't depend on the thread count
+void min_time_limit(time_limit_t* limit, const double time, const int cell);
+
+// Selects the face's cell with the highest energy, and so sound speed
+int hotter_face_cell(const int face_index, const int* faces_to_cells0,
+                     const int* faces_to_cells1, const double* energy);
+
+// Calculates the magnitude of a node's velocity
+double calc_node_speed(const int node_index, const double* velocity_x,
+                       const double* velocity_y, const double* velocity_z);
+
+// Calculates the time for a cell to change by its own volume, at the rate it
+// changed over the timestep
+double calc_volume_time(const double dt, const double old_volume,
+                        const double new_volume);
+
+// Calculates the cell centroids for a hexahedral mesh
+void calc_cell_centroids_hex(const int ncells, const int* cell_list,
+                             const int* cells_to_nodes, const double* nodes_x,
+                             const double* nodes_y, const double* nodes_z,
+                             double* cell_centroids_x, double* cell_centroids_y,
+                             double* cell_centroids_z);
+
+// Updates the cell centroids, with the hexahedral or general kernel
+void update_cell_centroids(UnstructuredMesh* umesh, HaleData* hale_data,
+                           const double* nodes_x, const double* nodes_y,
+                           const double* nodes_z);
+
+// Calculates the nodal volume and the volume weighted sound speed from the
+// volumes of the subcells around each node
+void calc_nodal_vol_and_c(const int nnodes, const int* nodes_to_cells_offsets,
+                          const int* nodes_to_cells,
+                          const int* nodes_to_subcells,
+                          const double* subcell_volume, const double* energy,
+                          double* nodal_volumes, double* nodal_soundspeed);
+
+// Calculates the volumes and centroids of all subcells for the current mesh
+// state, from the cell centroids and the cached face centroids
+void calc_subcell_geometry(
+    const int ncells, const int* cell_list, const int* cells_to_nodes_offsets,
+    const int* cells_to_faces_offsets, const int* cells_to_faces,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const double* nodes_x,
+    const double* nodes_y, const double* nodes_z,
+    const double* cell_centroids_x, const double* cell_centroids_y,
+    const double* cell_centroids_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    double* subcell_volume, double* subcell_centroids_x,
+    double* subcell_centroids_y, double* subcell_centroids_z);
+
+// Updates the subcell volumes and centroids, expecting the cell centroids and
+// face geometry to have been updated for the same nodes
+void update_subcell_geometry(UnstructuredMesh* umesh, HaleData* hale_data,
+                             const double* nodes_x, const double* nodes_y,
+                             const double* nodes_z);
 
 // gathers all of the subcell quantities on the mesh
 void gather_subcell_quantities(UnstructuredMesh* umesh, HaleData* hale_data,
@@ -68,8 +166,25 @@ void calc_inverse_coefficient_matrix(
     const int nsubcells_by_subcell, const int subcell_to_subcells_off,
     vec_t (*inv)[3]);
 
-// Calculates the inverse of a 3x3 matrix, out-of-place
-void calc_3x3_inverse(vec_t (*a)[3], vec_t (*inv)[3]);
+// Solves a batch of symmetric positive semi-definite 3x3 systems in place, with
+// the unique entries xx, xy, xz, yy, yz and zz of system ss at kk * stride + ss
+// and component dd of right hand side rr at (rr * 3 + dd) * stride + ss. A
+// system that is singular relative to its trace is regularised by shifting its
+// diagonal, and a system with no neighbours to fit has a zero solution
+void solve_sym_3x3_batch(const int nsystems, const int stride, const int nrhs,
+                         const double* coeff, double* rhs);
+
+// Stores the unique entries of a symmetric 3x3 system in a slot of a batch
+void store_sym_3x3_system(const int slot, const int stride, const vec_t* a,
+                          double* coeff);
+
+// Stores right hand side rr of a slot of a batch of 3x3 systems
+void store_3x3_rhs(const int slot, const int stride, const int rr,
+                   const vec_t* b, double* rhs);
+
+// Loads solution rr of a slot of a batch of solved 3x3 systems
+vec_t load_3x3_solution(const int slot, const int stride, const int rr,
+                        const double* rhs);
 
 // Calculate the gradient for the
 void calc_gradient(const int subcell_index, const int nsubcells_by_subcell,
@@ -80,14 +195,6 @@ void calc_gradient(const int subcell_index, const int nsubcells_by_subcell,
                    const double* subcell_centroids_z, const vec_t (*inv)[3],
                    vec_t* gradient);
 
-// Calculates the limiter for the provided gradient
-double apply_cell_limiter(const int nnodes_by_cell, const int cell_to_nodes_off,
-                          const int* cell_to_nodes, vec_t* grad,
-                          const vec_t* cell_centroid, const double* nodes_x0,
-                          const double* nodes_y0, const double* nodes_z0,
-                          const double dphi, const double gmax,
-                          const double gmin);
-
 // Calculates the cell volume, subcell volume and the subcell centroids
 void calc_volumes_centroids(
     const int ncells, const int nnodes, const int nnodes_by_subcell,
@@ -98,7 +205,7 @@ void calc_volumes_centroids(
     const double* nodes_y, const double* nodes_z, double* subcell_centroids_x,
     double* subcell_centroids_y, double* subcell_centroids_z,
     double* subcell_volume, double* cell_volume, double* nodal_volumes,
-    int* nodes_offsets, int* nodes_to_cells);
+    int* nodes_offsets, int* nodes_to_subcells);
 
 void apply_mesh_rezoning(const int nnodes, const double* rezoned_nodes_x,
                          const double* rezoned_nodes_y,
@@ -111,11 +218,6 @@ void contribute_face_volume(const int nnodes_by_face, const int* faces_to_nodes,
                             const double* nodes_z, const vec_t* cell_centroid,
                             double* vol);
 
-// Calculates the local limiter for a node
-double calc_cell_limiter(const double rho, const double gmax, const double gmin,
-                         vec_t* grad, const double node_x, const double node_y,
-                         const double node_z, const vec_t* cell_c);
-
 // Perform the scatter step of the ALE remapping algorithm
 void scatter_phase(UnstructuredMesh* umesh, HaleData* hale_data,
                    vec_t* initial_momentum, double initial_mass,
@@ -131,6 +233,14 @@ int test_prism_overlap(const int nnodes_by_face, const int* faces_to_nodes,
 // Performs an Eulerian rezone of the mesh
 void eulerian_rezone(UnstructuredMesh* umesh, HaleData* hale_data);
 
+// Calculates the geometry of the rezoned mesh, unless the cached geometry is
+// still valid for the rezoned nodes
+void update_rezoned_geometry(UnstructuredMesh* umesh, HaleData* hale_data);
+
+// Copies cached rezoned geometry into the geometry of the current mesh
+void copy_rezoned_geometry(const int n, const double* rezoned_data,
+                           double* data);
+
 // Performs a conservative repair of the mesh
 void mass_repair_phase(UnstructuredMesh* umesh, HaleData* hale_data);
 
@@ -140,67 +250,273 @@ void velocity_repair_phase(UnstructuredMesh* umesh, HaleData* hale_data);
 // Repairs the energy
 void energy_repair_phase(UnstructuredMesh* umesh, HaleData* hale_data);
 
-// Advects mass and energy through the subcell faces using swept edge approx
-void perform_advection(
-    const int ncells, const int* cells_offsets, const double* nodes_x,
-    const double* nodes_y, const double* nodes_z, const double* rezoned_nodes_x,
+// Flags the nodes displaced from the rezoned mesh by more than ACTIVE_NODE_TOL,
+// and the cells that have any such node
+void calc_active_cells(const int nnodes, const int ncells,
+                       const int* cells_to_nodes_offsets,
+                       const int* cells_to_nodes, const double* nodes_x,
+                       const double* nodes_y, const double* nodes_z,
+                       const double* rezoned_nodes_x,
+                       const double* rezoned_nodes_y,
+                       const double* rezoned_nodes_z, int* nodes_active,
+                       int* cells_active);
+
+// Determines the volume and centroid of the region swept by each subcell face
+// and whether it leaves the subcell. The non-empty sweeps of each cell are
+// packed from the cell's first subcells_to_subcells slot, in slot order
+void calc_sweep_geometry(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* cells_active, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, const double* rezoned_nodes_x,
     const double* rezoned_nodes_y, const double* rezoned_nodes_z,
-    const int* cells_to_nodes, const int* faces_to_nodes_offsets,
-    const int* faces_to_nodes, const int* faces_cclockwise_cell,
+    const double* rezoned_cell_centroids_x,
+    const double* rezoned_cell_centroids_y,
+    const double* rezoned_cell_centroids_z,
+    const double* rezoned_face_centroids_x,
+    const double* rezoned_face_centroids_y,
+    const double* rezoned_face_centroids_z, const int* cells_to_nodes,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
     const int* subcells_to_faces_offsets, const int* subcells_to_faces,
     const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    const int* subcell_face_rnodes, const int* subcell_face_lnodes,
+    const int* subcell_face_r_faces, const int* subcell_face_l_faces,
+    const int* subcell_face_r_face_rnodes, const double* subcell_centroids_x,
+    const double* subcell_centroids_y, const double* subcell_centroids_z,
+    int* cells_nsweeps, int* subcells_to_sweeps, int* sweep_subcells,
+    int* sweep_slots, int* sweep_outflux, double* sweep_volumes,
+    double* sweep_centroids_x, double* sweep_centroids_y,
+    double* sweep_centroids_z);
+
+// Evaluates a batch of a cell's swept edge prisms, with node nn of prism pp at
+// nn * NPRISMS_BY_BATCH + pp, and stores the non-empty sweeps in batch order
+// from sweep_off, returning the number of sweeps stored
+int calc_batch_sweeps(
+    const int cc, const int nprisms, const double* prism_nodes_x,
+    const double* prism_nodes_y, const double* prism_nodes_z,
+    const int* prism_subcells, const int* prism_slots,
     const double* subcell_centroids_x, const double* subcell_centroids_y,
-    const double* subcell_centroids_z, const int* faces_to_cells0,
-    const int* faces_to_cells1, double* subcell_volume,
-    double* subcell_momentum_flux_x, double* subcell_momentum_flux_y,
-    double* subcell_momentum_flux_z, const double* subcell_momentum_x,
+    const double* subcell_centroids_z, const int* subcells_to_subcells_offsets,
+    const int* subcells_to_subcells, const int sweep_off,
+    int* subcells_to_sweeps, int* sweep_subcells, int* sweep_slots,
+    int* sweep_outflux, double* sweep_volumes, double* sweep_centroids_x,
+    double* sweep_centroids_y, double* sweep_centroids_z);
+
+// Determines whether each prism of a batch leaves its subcell, by comparing
+// the movement of the face against the direction to the subcell centroid
+void calc_prism_outflux(const int nprisms, const int stride,
+                        const double* prism_nodes_x,
+                        const double* prism_nodes_y,
+                        const double* prism_nodes_z, const int* prism_subcells,
+                        const double* subcell_centroids_x,
+                        const double* subcell_centroids_y,
+                        const double* subcell_centroids_z,
+                        int* prism_outflux);
+
+// Calculates the volumes and centroids of a batch of swept edge prisms, whose
+// nodes are the subcell face on the original mesh followed by the same face on
+// the rezoned mesh, with node nn of prism pp at nn * stride + pp. The faces of
+// the prisms are fixed, so each face is evaluated across the prisms in turn
+void calc_prism_volumes_centroids(const int nprisms, const int stride,
+                                  const double* prism_nodes_x,
+                                  const double* prism_nodes_y,
+                                  const double* prism_nodes_z,
+                                  double* prism_volumes,
+                                  double* prism_centroids_x,
+                                  double* prism_centroids_y,
+                                  double* prism_centroids_z);
+
+// Determines whether a subcell owns the sweep of the face at the given slot,
+// which is the lower indexed of the two subcells sharing the face
+int is_sweep_owner(const int subcell_index, const int slot,
+                   const int* subcells_to_subcells_offsets,
+                   const int* subcells_to_subcells);
+
+// Determines whether a cell, or any cell across one of its faces, is active
+int is_near_active_cell(const int cc, const int* cells_to_faces_offsets,
+                        const int* cells_to_faces, const int* faces_to_cells0,
+                        const int* faces_to_cells1, const int* cells_active);
+
+// Flags the cells within two faces of an active cell. The sweeps of the active
+// cells are reconstructed from the cells across their faces, whose gradients
+// are fitted to the subcells of the cells across their own faces
+void calc_reconstructed_cells(const int ncells,
+                              const int* cells_to_faces_offsets,
+                              const int* cells_to_faces,
+                              const int* faces_to_cells0,
+                              const int* faces_to_cells1,
+                              const int* cells_active,
+                              int* cells_reconstructed);
+
+// Checks that a non-empty sweep has a subcell on the other side of its face
+void check_sweep_neighbour(const int subcell_index, const int slot,
+                           const int* subcells_to_subcells_offsets,
+                           const int* subcells_to_subcells,
+                           const double swept_edge_vol);
+
+// Calculates the limited gradients of mass, energy and velocity in each
+// subcell, ahead of the flux stage
+void calc_subcell_gradients(
+    const int ncells, const int* cells_to_nodes_offsets, const double* nodes_x,
+    const double* nodes_y, const double* nodes_z, const int* cells_to_nodes,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+    const int* cells_to_faces_offsets, const int* cells_to_faces,
+    const int* faces_to_cells0, const int* faces_to_cells1,
+    const int* subcells_to_faces_offsets, const int* subcells_to_faces,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    const int* subcell_face_rnodes, const int* cells_active,
+    const int* cells_nsweeps, const int* sweep_subcells, const int* sweep_slots,
+    const int* sweep_outflux, const double* subcell_centroids_x,
+    const double* subcell_centroids_y, const double* subcell_centroids_z,
+    const double* subcell_volume, const double* subcell_mass,
+    const double* subcell_ie_mass, const double* subcell_ke_mass,
+    const double* subcell_momentum_x, const double* subcell_momentum_y,
+    const double* subcell_momentum_z, double* subcell_grad_m_x,
+    double* subcell_grad_m_y, double* subcell_grad_m_z,
+    double* subcell_grad_ie_x, double* subcell_grad_ie_y,
+    double* subcell_grad_ie_z, double* subcell_grad_ke_x,
+    double* subcell_grad_ke_y, double* subcell_grad_ke_z,
+    double* subcell_grad_vx_x, double* subcell_grad_vx_y,
+    double* subcell_grad_vx_z, double* subcell_grad_vy_x,
+    double* subcell_grad_vy_y, double* subcell_grad_vy_z,
+    double* subcell_grad_vz_x, double* subcell_grad_vz_y,
+    double* subcell_grad_vz_z);
+
+// Determines whether any of the sweeps of a cell are reconstructed from the
+// given subcell
+int is_sweep_source(const int cc, const int subcell_index,
+                    const int* cells_to_nodes_offsets,
+                    const int* subcells_to_subcells_offsets,
+                    const int* subcells_to_subcells, const int* cells_nsweeps,
+                    const int* sweep_subcells, const int* sweep_slots,
+                    const int* sweep_outflux);
+
+// Assembles the least squares system for the gradients of a subcell over its
+// neighbours into a slot of a batch, with the bounds of its neighbourhood
+void calc_gradient_system(
+    const int subcell_index, const int slot, const int stride,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    const double* subcell_centroids_x, const double* subcell_centroids_y,
+    const double* subcell_centroids_z, const double* subcell_volume,
+    const double* subcell_mass, const double* subcell_ie_mass,
+    const double* subcell_ke_mass, const double* subcell_momentum_x,
     const double* subcell_momentum_y, const double* subcell_momentum_z,
-    const double* subcell_mass, double* subcell_mass_flux,
-    const double* subcell_ie_mass, double* subcell_ie_mass_flux,
-    const double* subcell_ke_mass, double* subcell_ke_mass_flux);
-
-// Contributes the local mass, energy and momentum flux for a given subcell face
-void flux_mass_energy_momentum(
-    const int cc, const int neighbour_cc, const int ff, const int subcell_index,
-    vec_t* subcell_c, vec_t* cell_c, const double* se_nodes_x,
-    const double* se_nodes_y, const double* se_nodes_z,
-    const double* subcell_mass, double* subcell_mass_flux,
-    const double* subcell_ie_mass, double* subcell_ie_mass_flux,
-    const double* subcell_ke_mass, double* subcell_ke_mass_flux,
-    const double* subcell_volume, const double* subcell_momentum_x,
+    double* batch_coeff, double* batch_rhs, double* batch_gmax,
+    double* batch_gmin);
+
+// Solves a batch of subcell gradient systems, and limits each of the gradients
+// at the subcell's node, cell centre, face centres and half edges
+void limit_batch_gradients(
+    const int nsolves, const int* batch_subcells, const vec_t* cell_c,
+    const double* nodes_x, const double* nodes_y, const double* nodes_z,
+    const int* cells_to_nodes, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* subcells_to_faces_offsets,
+    const int* subcells_to_faces, const int* subcell_face_rnodes,
+    const double* subcell_centroids_x, const double* subcell_centroids_y,
+    const double* subcell_centroids_z, const double* subcell_volume,
+    const double* subcell_mass, const double* subcell_ie_mass,
+    const double* subcell_ke_mass, const double* subcell_momentum_x,
     const double* subcell_momentum_y, const double* subcell_momentum_z,
-    double* subcell_momentum_flux_x, double* subcell_momentum_flux_y,
-    double* subcell_momentum_flux_z, const int* swept_edge_faces_to_nodes,
+    const double* batch_coeff, double* batch_rhs, const double* batch_gmax,
+    const double* batch_gmin, double* subcell_grad_m_x,
+    double* subcell_grad_m_y, double* subcell_grad_m_z,
+    double* subcell_grad_ie_x, double* subcell_grad_ie_y,
+    double* subcell_grad_ie_z, double* subcell_grad_ke_x,
+    double* subcell_grad_ke_y, double* subcell_grad_ke_z,
+    double* subcell_grad_vx_x, double* subcell_grad_vx_y,
+    double* subcell_grad_vx_z, double* subcell_grad_vy_x,
+    double* subcell_grad_vy_y, double* subcell_grad_vy_z,
+    double* subcell_grad_vz_x, double* subcell_grad_vz_y,
+    double* subcell_grad_vz_z);
+
+// Limits the solved gradients of the subcell in a slot of a batch at the
+// subcell's node, cell centre, face centres and half edges
+void limit_subcell_gradients(
+    const int subcell_index, const int slot, const int stride,
+    const vec_t* cell_c, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, const int* cells_to_nodes,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+    const int* subcells_to_faces_offsets, const int* subcells_to_faces,
+    const int* subcell_face_rnodes, const double* subcell_centroids_x,
+    const double* subcell_centroids_y, const double* subcell_centroids_z,
+    const double* subcell_volume, const double* subcell_mass,
+    const double* subcell_ie_mass, const double* subcell_ke_mass,
+    const double* subcell_momentum_x, const double* subcell_momentum_y,
+    const double* subcell_momentum_z, const double* batch_solution,
+    const double* batch_gmax, const double* batch_gmin,
+    double* subcell_grad_m_x, double* subcell_grad_m_y,
+    double* subcell_grad_m_z, double* subcell_grad_ie_x,
+    double* subcell_grad_ie_y, double* subcell_grad_ie_z,
+    double* subcell_grad_ke_x, double* subcell_grad_ke_y,
+    double* subcell_grad_ke_z, double* subcell_grad_vx_x,
+    double* subcell_grad_vx_y, double* subcell_grad_vx_z,
+    double* subcell_grad_vy_x, double* subcell_grad_vy_y,
+    double* subcell_grad_vy_z, double* subcell_grad_vz_x,
+    double* subcell_grad_vz_y, double* subcell_grad_vz_z);
+
+// Calculates the mass, energy and momentum fluxes through the non-empty sweeps
+// of each cell, out of the subcell that owns each sweep
+void calc_sweep_fluxes(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
     const double* subcell_centroids_x, const double* subcell_centroids_y,
-    const double* subcell_centroids_z, const int* swept_edge_to_faces,
-    const int* swept_edge_faces_to_nodes_offsets,
+    const double* subcell_centroids_z, const int* cells_nsweeps,
+    const int* sweep_subcells, const int* sweep_slots, const int* sweep_outflux,
+    const double* sweep_volumes, const double* sweep_centroids_x,
+    const double* sweep_centroids_y, const double* sweep_centroids_z,
+    const double* subcell_volume, const double* subcell_momentum_x,
+    const double* subcell_momentum_y, const double* subcell_momentum_z,
+    const double* subcell_mass, const double* subcell_ie_mass,
+    const double* subcell_ke_mass, const double* subcell_grad_m_x,
+    const double* subcell_grad_m_y, const double* subcell_grad_m_z,
+    const double* subcell_grad_ie_x, const double* subcell_grad_ie_y,
+    const double* subcell_grad_ie_z, const double* subcell_grad_ke_x,
+    const double* subcell_grad_ke_y, const double* subcell_grad_ke_z,
+    const double* subcell_grad_vx_x, const double* subcell_grad_vx_y,
+    const double* subcell_grad_vx_z, const double* subcell_grad_vy_x,
+    const double* subcell_grad_vy_y, const double* subcell_grad_vy_z,
+    const double* subcell_grad_vz_x, const double* subcell_grad_vz_y,
+    const double* subcell_grad_vz_z, double* sweep_mass_flux,
+    double* sweep_ie_flux, double* sweep_ke_flux,
+    double* sweep_momentum_flux_x, double* sweep_momentum_flux_y,
+    double* sweep_momentum_flux_z);
+
+// Calculates the first order mass, energy and momentum fluxes through the
+// non-empty sweeps of each cell, at the mean densities of the donor subcell
+void calc_donor_sweep_fluxes(
+    const int ncells, const int* cells_to_nodes_offsets,
     const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
-    const int* subcells_to_faces_offsets, const int* subcells_to_faces,
-    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
-    const int* cells_offsets, const int* cells_to_nodes,
-    const int* faces_cclockwise_cell, const double* nodes_x,
-    const double* nodes_y, const double* nodes_z, const int internal);
+    const int* cells_nsweeps, const int* sweep_subcells,
+    const int* sweep_slots, const int* sweep_outflux,
+    const double* sweep_volumes, const double* subcell_volume,
+    const double* subcell_momentum_x, const double* subcell_momentum_y,
+    const double* subcell_momentum_z, const double* subcell_mass,
+    const double* subcell_ie_mass, const double* subcell_ke_mass,
+    double* sweep_mass_flux, double* sweep_ie_flux, double* sweep_ke_flux,
+    double* sweep_momentum_flux_x, double* sweep_momentum_flux_y,
+    double* sweep_momentum_flux_z);
 
-// Controls the timestep for the simulation
-void set_timestep(const int ncells, const double* nodes_x,
-                  const double* nodes_y, const double* nodes_z,
-                  const double* energy, double* dt, int* cells_to_faces_offsets,
-                  int* cells_to_faces, int* faces_to_nodes_offsets,
-                  int* faces_to_nodes);
+// Accumulates the fluxes of the sweeps into the subcells, with each sweep
+// adding to the subcell that owns it and subtracting from the other subcell
+// sharing the face. Each subcell only gathers its own fluxes, so there are no
+// races, and the mass, energy and momentum are conserved by construction
+void accumulate_subcell_fluxes(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    const int* subcell_neighbour_slots, const int* cells_active,
+    const int* subcells_to_sweeps, const double* sweep_mass_flux,
+    const double* sweep_ie_flux, const double* sweep_ke_flux,
+    const double* sweep_momentum_flux_x, const double* sweep_momentum_flux_y,
+    const double* sweep_momentum_flux_z, double* subcell_mass_flux,
+    double* subcell_ie_mass_flux, double* subcell_ke_mass_flux,
+    double* subcell_momentum_flux_x, double* subcell_momentum_flux_y,
+    double* subcell_momentum_flux_z);
 
-// Limits all of the gradients during flux determination
-void limit_mass_gradients(
-    vec_t nodes, vec_t* sweep_subcell_c, const double sweep_subcell_density,
-    const double sweep_subcell_ie_density,
-    const double sweep_subcell_ke_density, const double subcell_vx,
-    const double subcell_vy, const double subcell_vz, const double gmax_m,
-    const double gmin_m, const double gmax_ie, const double gmin_ie,
-    const double gmax_ke, const double gmin_ke, const double gmax_vx,
-    const double gmin_vx, const double gmax_vy, const double gmin_vy,
-    const double gmax_vz, const double gmin_vz, vec_t* grad_m, vec_t* grad_ie,
-    vec_t* grad_ke, vec_t* grad_vx, vec_t* grad_vy, vec_t* grad_vz,
-    double* m_limiter, double* ie_limiter, double* ke_limiter,
-    double* vx_limiter, double* vy_limiter, double* vz_limiter);
+// Limits the gradients of a set of fields reconstructed about the centre c by
+// the bounds of each field at the point p, with one field in each lane
+void limit_field_gradients(const vec_t* p, const vec_t* c, const double* phi,
+                           const double* gmax, const double* gmin,
+                           const double* grad_x, const double* grad_y,
+                           const double* grad_z, double* limiters);
 
 // Limits all of the gradients during flux determination
 void limit_momentum_gradients(
@@ -209,3 +525,93 @@ void limit_momentum_gradients(
     const double gmin_vx, const double gmax_vy, const double gmin_vy,
     const double gmax_vz, const double gmin_vz, vec_t* grad_vx, vec_t* grad_vy,
     vec_t* grad_vz, double* vx_limiter, double* vy_limiter, double* vz_limiter);
+
+// Updates the frontier of cells and nodes that the Lagrangian kernels run over
+void update_frontier(UnstructuredMesh* umesh, HaleData* hale_data);
+
+// Seeds the frontier with only the cells that have a moving node, or a jump
+// in pressure or energy with a neighbour
+void seed_frontier(const int ncells, const int* cells_to_nodes_offsets,
+                   const int* cells_to_nodes, const int* cells_to_faces_offsets,
+                   const int* cells_to_faces, const int* faces_to_cells0,
+                   const int* faces_to_cells1, const double* velocity_x,
+                   const double* velocity_y, const double* velocity_z,
+                   const double* energy, const double* density,
+                   int* cells_frontier);
+
+// Widens the frontier by the cells sharing a node with a frontier cell
+void dilate_frontier(const int nnodes, const int ncells,
+                     const int* nodes_to_cells_offsets,
+                     const int* nodes_to_cells,
+                     const int* cells_to_nodes_offsets,
+                     const int* cells_to_nodes, int* cells_frontier,
+                     int* nodes_frontier);
+
+// Lists the frontier cells, the nodes whose cells are all in the frontier,
+// and those of the nodes that neighbour a node outside of the frontier
+void compact_frontier(const int nnodes, const int ncells,
+                      const int* nodes_to_cells_offsets,
+                      const int* nodes_to_cells,
+                      const int* nodes_to_nodes_offsets,
+                      const int* nodes_to_nodes, const int* cells_frontier,
+                      int* nodes_frontier, int* nfrontier_cells,
+                      int* frontier_cells, int* nfrontier_nodes,
+                      int* frontier_nodes, int* nfrontier_halo_nodes,
+                      int* frontier_halo_nodes);
+
+// Lists the edges on a face of a frontier cell, keeping them grouped by colour
+void compact_frontier_edges(const int nedge_colours,
+                            const int* edge_colour_offsets,
+                            const int* edges_by_colour,
+                            const int* edges_to_faces_offsets,
+                            const int* edges_to_faces,
+                            const int* faces_to_cells0,
+                            const int* faces_to_cells1,
+                            const int* cells_frontier,
+                            int* frontier_edge_colour_offsets,
+                            int* frontier_edges_by_colour);
+
+// Holds the nodes and cells outside of the frontier at the current time level,
+// as the dense kernels read both time levels of the whole mesh
+void hold_outside_frontier(
+    const int nnodes, const int ncells, const int* cells_frontier,
+    const int* nodes_frontier, const double* nodes_x0, const double* nodes_y0,
+    const double* nodes_z0, const double* velocity_x0,
+    const double* velocity_y0, const double* velocity_z0,
+    const double* energy0, const double* density0, double* nodes_x1,
+    double* nodes_y1, double* nodes_z1, double* velocity_x1,
+    double* velocity_y1, double* velocity_z1, double* energy1,
+    double* density1, double* pressure0, double* pressure1);
+
+// Checks that the nodes at the edge of the frontier remained at rest
+void check_frontier(const int nfrontier_halo_nodes,
+                    const int* frontier_halo_nodes, const double* velocity_x,
+                    const double* velocity_y, const double* velocity_z);
+
+// Keeps the state at the start of the step, so that the dense kernels can
+// repeat the step to verify the frontier
+void store_frontier_state(Mesh* mesh, UnstructuredMesh* umesh,
+                          HaleData* hale_data);
+
+// Repeats the step with the dense kernels from the stored state, and checks
+// that the frontier step agrees with it to within FRONTIER_VERIFY_TOL. The
+// run continues from the dense step
+void verify_frontier(Mesh* mesh, UnstructuredMesh* umesh,
+                     HaleData* hale_data);
+
+// Copies the state into the stored state, or exchanges the two when swap is
+// set
+void swap_frontier_state(
+    const int nnodes, const int ncells, double* nodes_x, double* nodes_y,
+    double* nodes_z, double* velocity_x, double* velocity_y,
+    double* velocity_z, double* energy, double* density,
+    double* stored_nodes_x, double* stored_nodes_y, double* stored_nodes_z,
+    double* stored_velocity_x, double* stored_velocity_y,
+    double* stored_velocity_z, double* stored_energy, double* stored_density,
+    const int swap);
+
+// Returns the largest difference between two fields
+double calc_max_difference(const int n, const double* a, const double* b);
+
+// Returns the largest magnitude in a field
+double calc_max_magnitude(const int n, const double* a);
@@ -13,10 +13,10 @@ void init_mesh_mass(const int ncells, const int nnodes,
                     int* cells_to_nodes_offsets, int* cells_to_nodes,
                     int* subcells_to_faces_offsets, int* subcells_to_faces,
                     int* nodes_to_cells_offsets, int* nodes_to_cells,
-                    double* subcell_centroids_x, double* subcell_centroids_y,
-                    double* subcell_centroids_z, double* subcell_volume,
-                    double* cell_volume, double* nodal_volumes,
-                    double* cell_mass) {
+                    int* nodes_to_subcells, double* subcell_centroids_x,
+                    double* subcell_centroids_y, double* subcell_centroids_z,
+                    double* subcell_volume, double* cell_volume,
+                    double* nodal_volumes, double* cell_mass) {
 
   printf("Performing Initialisation.\n");
 
@@ -27,7 +27,7 @@ void init_mesh_mass(const int ncells, const int nnodes,
       faces_to_nodes_offsets, faces_cclockwise_cell, nodes_x, nodes_y, nodes_z,
       subcell_centroids_x, subcell_centroids_y, subcell_centroids_z,
       subcell_volume, cell_volume, nodal_volumes, nodes_to_cells_offsets,
-      nodes_to_cells);
+      nodes_to_subcells);
 
   double total_mass_in_cells = 0.0;
   double total_mass_in_subcells = 0.0;
@@ -43,6 +43,7 @@ void init_mesh_mass(const int ncells, const int nnodes,
 
     // looping over corner subcells here
     double total_mass = 0.0;
+    double total_volume = 0.0;
     for (int nn = 0; nn < nnodes_by_cell; ++nn) {
       const int subcell_index = cell_to_nodes_off + nn;
       subcell_mass[(subcell_index)] =
@@ -50,9 +51,11 @@ void init_mesh_mass(const int ncells, const int nnodes,
 
       total_mass += subcell_mass[(subcell_index)];
       total_mass_in_subcells += subcell_mass[(subcell_index)];
+      total_volume += subcell_volume[(subcell_index)];
     }
 
     cell_mass[(cc)] = total_mass;
+    cell_volume[(cc)] = total_volume;
     total_mass_in_cells += cell_mass[(cc)];
   }
   STOP_PROFILING(&compute_profile, __func__);
@@ -71,18 +74,8 @@ void init_mesh_mass(const int ncells, const int nnodes,
     nodal_mass[(nn)] = 0.0;
 
     for (int cc = 0; cc < ncells_by_node; ++cc) {
-      const int cell_index = nodes_to_cells[(node_to_cells_off + cc)];
-      const int cell_to_nodes_off = cells_to_nodes_offsets[(cell_index)];
-      const int nnodes_by_cell =
-          cells_to_nodes_offsets[(cell_index + 1)] - cell_to_nodes_off;
-
-      for (int nn2 = 0; nn2 < nnodes_by_cell; ++nn2) {
-        if (cells_to_nodes[(cell_to_nodes_off + nn2)] == nn) {
-          const int subcell_index = cell_to_nodes_off + nn2;
-          nodal_mass[(nn)] += subcell_mass[(subcell_index)];
-          break;
-        }
-      }
+      const int subcell_index = nodes_to_subcells[(node_to_cells_off + cc)];
+      nodal_mass[(nn)] += subcell_mass[(subcell_index)];
     }
   }
 
@@ -99,7 +92,7 @@ void calc_volumes_centroids(
     const double* nodes_y, const double* nodes_z, double* subcell_centroids_x,
     double* subcell_centroids_y, double* subcell_centroids_z,
     double* subcell_volume, double* cell_volume, double* nodal_volumes,
-    int* nodes_to_cells_offsets, int* nodes_to_cells) {
+    int* nodes_to_cells_offsets, int* nodes_to_subcells) {
 
   double total_subcell_volume = 0.0;
 #pragma omp parallel for reduction(+ : total_subcell_volume)
@@ -304,18 +297,8 @@ void calc_volumes_centroids(
     nodal_volumes[(nn)] = 0.0;
 
     for (int cc = 0; cc < ncells_by_node; ++cc) {
-      const int cell_index = nodes_to_cells[(node_to_cells_off + cc)];
-      const int cell_to_nodes_off = cells_to_nodes_offsets[(cell_index)];
-      const int nnodes_by_cell =
-          cells_to_nodes_offsets[(cell_index + 1)] - cell_to_nodes_off;
-
-      for (int nn2 = 0; nn2 < nnodes_by_cell; ++nn2) {
-        if (cells_to_nodes[(cell_to_nodes_off + nn2)] == nn) {
-          const int subcell_index = cell_to_nodes_off + nn2;
-          nodal_volumes[(nn)] += subcell_volume[(subcell_index)];
-          break;
-        }
-      }
+      const int subcell_index = nodes_to_subcells[(node_to_cells_off + cc)];
+      nodal_volumes[(nn)] += subcell_volume[(subcell_index)];
     }
   }
 
@@ -323,7 +306,8 @@ void calc_volumes_centroids(
 }
 
 // Initialises the centroids for each cell
-void init_cell_centroids(const int ncells, const int* cells_to_nodes_offsets,
+void init_cell_centroids(const int ncells, const int* cell_list,
+                         const int* cells_to_nodes_offsets,
                          const int* cells_to_nodes, const double* nodes_x,
                          const double* nodes_y, const double* nodes_z,
                          double* cell_centroids_x, double* cell_centroids_y,
@@ -332,7 +316,8 @@ void init_cell_centroids(const int ncells, const int* cells_to_nodes_offsets,
   // Calculate the cell centroids
   START_PROFILING(&compute_profile);
 #pragma omp parallel for
-  for (int cc = 0; cc < ncells; ++cc) {
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
     const int cells_off = cells_to_nodes_offsets[(cc)];
     const int nnodes_by_cell = cells_to_nodes_offsets[(cc + 1)] - cells_off;
 
@@ -612,6 +597,120 @@ void init_subcells_to_subcells(
   }
 }
 
+// Initialises the orientation of each subcell face about the subcell's node,
+// and the slot of each subcell neighbour that refers back to the subcell
+void init_subcell_face_orientations(
+    const int ncells, const int* cells_to_nodes_offsets,
+    const int* cells_to_nodes, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_cclockwise_cell,
+    const int* subcells_to_faces_offsets, const int* subcells_to_faces,
+    const int* subcells_to_subcells_offsets, const int* subcells_to_subcells,
+    int* subcell_face_rnodes, int* subcell_face_lnodes,
+    int* subcell_face_r_faces, int* subcell_face_l_faces,
+    int* subcell_face_r_face_rnodes, int* subcell_neighbour_slots) {
+
+#pragma omp parallel for
+  for (int cc = 0; cc < ncells; ++cc) {
+    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+    const int nnodes_by_cell =
+        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
+
+    for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+      const int node_index = cells_to_nodes[(cell_to_nodes_off + nn)];
+      const int subcell_index = cell_to_nodes_off + nn;
+      const int subcell_to_faces_off =
+          subcells_to_faces_offsets[(subcell_index)];
+      const int nfaces_by_subcell =
+          subcells_to_faces_offsets[(subcell_index + 1)] - subcell_to_faces_off;
+
+      for (int ff = 0; ff < nfaces_by_subcell; ++ff) {
+        const int subcell_face_index = subcell_to_faces_off + ff;
+        const int face_index = subcells_to_faces[(subcell_face_index)];
+        const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
+        const int nnodes_by_face =
+            faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
+
+        // Determine the position of the node in the face list of nodes
+        int nn2;
+        for (nn2 = 0; nn2 < nnodes_by_face; ++nn2) {
+          if (faces_to_nodes[(face_to_nodes_off + nn2)] == node_index) {
+            break;
+          }
+        }
+
+        const int face_clockwise = (faces_cclockwise_cell[(face_index)] != cc);
+        const int next_node = (nn2 == nnodes_by_face - 1) ? 0 : nn2 + 1;
+        const int prev_node = (nn2 == 0) ? nnodes_by_face - 1 : nn2 - 1;
+        const int rnode_off = (face_clockwise ? prev_node : next_node);
+        const int lnode_off = (face_clockwise ? next_node : prev_node);
+        subcell_face_rnodes[(subcell_face_index)] =
+            faces_to_nodes[(face_to_nodes_off + rnode_off)];
+        subcell_face_lnodes[(subcell_face_index)] =
+            faces_to_nodes[(face_to_nodes_off + lnode_off)];
+
+        // The faces either side of the face about the node
+        const int r_face_off = (ff == nfaces_by_subcell - 1) ? 0 : ff + 1;
+        const int l_face_off = (ff == 0) ? nfaces_by_subcell - 1 : ff - 1;
+        const int r_face_index =
+            subcells_to_faces[(subcell_to_faces_off + r_face_off)];
+        subcell_face_r_faces[(subcell_face_index)] = r_face_index;
+        subcell_face_l_faces[(subcell_face_index)] =
+            subcells_to_faces[(subcell_to_faces_off + l_face_off)];
+
+        const int r_face_to_nodes_off = faces_to_nodes_offsets[(r_face_index)];
+        const int nnodes_by_r_face =
+            faces_to_nodes_offsets[(r_face_index + 1)] - r_face_to_nodes_off;
+
+        // Determine the position of the node in the right face list of nodes
+        for (nn2 = 0; nn2 < nnodes_by_r_face; ++nn2) {
+          if (faces_to_nodes[(r_face_to_nodes_off + nn2)] == node_index) {
+            break;
+          }
+        }
+
+        const int r_face_clockwise =
+            (faces_cclockwise_cell[(r_face_index)] != cc);
+        const int r_face_next_node =
+            (nn2 == nnodes_by_r_face - 1) ? 0 : nn2 + 1;
+        const int r_face_prev_node =
+            (nn2 == 0) ? nnodes_by_r_face - 1 : nn2 - 1;
+        const int r_face_rnode_off =
+            (r_face_clockwise ? r_face_prev_node : r_face_next_node);
+        subcell_face_r_face_rnodes[(subcell_face_index)] =
+            faces_to_nodes[(r_face_to_nodes_off + r_face_rnode_off)];
+      }
+
+      // Find the slot of each neighbour that refers back to this subcell
+      const int subcell_to_subcells_off =
+          subcells_to_subcells_offsets[(subcell_index)];
+      const int nneighbours_by_subcell =
+          subcells_to_subcells_offsets[(subcell_index + 1)] -
+          subcell_to_subcells_off;
+      for (int ss = 0; ss < nneighbours_by_subcell; ++ss) {
+        const int neighbour_index =
+            subcells_to_subcells[(subcell_to_subcells_off + ss)];
+        subcell_neighbour_slots[(subcell_to_subcells_off + ss)] = -1;
+        if (neighbour_index == -1) {
+          continue;
+        }
+
+        const int neighbour_to_subcells_off =
+            subcells_to_subcells_offsets[(neighbour_index)];
+        const int nneighbours_by_neighbour =
+            subcells_to_subcells_offsets[(neighbour_index + 1)] -
+            neighbour_to_subcells_off;
+        for (int ss2 = 0; ss2 < nneighbours_by_neighbour; ++ss2) {
+          if (subcells_to_subcells[(neighbour_to_subcells_off + ss2)] ==
+              subcell_index) {
+            subcell_neighbour_slots[(subcell_to_subcells_off + ss)] = ss2;
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
 // NOTE: This is not intended to be a production device, rather used for
 // debugging the code against a well tested description of the subcell mesh.
 void init_subcell_data_structures(Mesh* mesh, HaleData* hale_data,
@@ -939,3 +1038,389 @@ void init_subcell_data_structures(Mesh* mesh, HaleData* hale_data,
     }
   }
 }
+
+// Initialises the list of subcells attached to each node
+void init_nodes_to_subcells(const int nnodes, const int* nodes_to_cells_offsets,
+                            const int* nodes_to_cells,
+                            const int* cells_to_nodes_offsets,
+                            const int* cells_to_nodes, int* nodes_to_subcells) {
+
+#pragma omp parallel for
+  for (int nn = 0; nn < nnodes; ++nn) {
+    const int node_to_cells_off = nodes_to_cells_offsets[(nn)];
+    const int ncells_by_node =
+        nodes_to_cells_offsets[(nn + 1)] - node_to_cells_off;
+
+    for (int cc = 0; cc < ncells_by_node; ++cc) {
+      const int cell_index = nodes_to_cells[(node_to_cells_off + cc)];
+      const int cell_to_nodes_off = cells_to_nodes_offsets[(cell_index)];
+      const int nnodes_by_cell =
+          cells_to_nodes_offsets[(cell_index + 1)] - cell_to_nodes_off;
+
+      // Determine the position of the node in the cell
+      int nn2;
+      for (nn2 = 0; nn2 < nnodes_by_cell; ++nn2) {
+        if (cells_to_nodes[(cell_to_nodes_off + nn2)] == nn) {
+          break;
+        }
+      }
+
+      nodes_to_subcells[(node_to_cells_off + cc)] = cell_to_nodes_off + nn2;
+    }
+  }
+}
+
+// Initialises the subcells of each face node, for both of the face's cells
+void init_faces_nodes_to_subcells(
+    const int nfaces, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_to_cells1, const int* cells_to_nodes_offsets,
+    const int* cells_to_nodes, int* faces_nodes_to_subcells0,
+    int* faces_nodes_to_subcells1) {
+
+#pragma omp parallel for
+  for (int ff = 0; ff < nfaces; ++ff) {
+    const int face_to_nodes_off = faces_to_nodes_offsets[(ff)];
+    const int nnodes_by_face =
+        faces_to_nodes_offsets[(ff + 1)] - face_to_nodes_off;
+    const int cells[2] = {faces_to_cells0[(ff)], faces_to_cells1[(ff)]};
+    int* faces_nodes_to_subcells[2] = {faces_nodes_to_subcells0,
+                                       faces_nodes_to_subcells1};
+
+    for (int cc = 0; cc < 2; ++cc) {
+      const int cell_index = cells[(cc)];
+
+      // Boundary faces have no second cell
+      if (cell_index == -1) {
+        for (int nn = 0; nn < nnodes_by_face; ++nn) {
+          faces_nodes_to_subcells[cc][(face_to_nodes_off + nn)] = -1;
+        }
+        continue;
+      }
+
+      const int cell_to_nodes_off = cells_to_nodes_offsets[(cell_index)];
+      const int nnodes_by_cell =
+          cells_to_nodes_offsets[(cell_index + 1)] - cell_to_nodes_off;
+
+      for (int nn = 0; nn < nnodes_by_face; ++nn) {
+        const int node_index = faces_to_nodes[(face_to_nodes_off + nn)];
+
+        // Determine the position of the node in the cell
+        int nn2;
+        for (nn2 = 0; nn2 < nnodes_by_cell; ++nn2) {
+          if (cells_to_nodes[(cell_to_nodes_off + nn2)] == node_index) {
+            break;
+          }
+        }
+
+        faces_nodes_to_subcells[cc][(face_to_nodes_off + nn)] =
+            cell_to_nodes_off + nn2;
+      }
+    }
+  }
+}
+
+// Determines whether every cell in the mesh is a hexahedron
+int is_hex_mesh(const int ncells, const int nfaces,
+                const int* cells_to_nodes_offsets,
+                const int* cells_to_faces_offsets,
+                const int* faces_to_nodes_offsets) {
+
+  int nnon_hex = 0;
+#pragma omp parallel for reduction(+ : nnon_hex)
+  for (int cc = 0; cc < ncells; ++cc) {
+    if (cells_to_nodes_offsets[(cc)] != cc * NNODES_BY_HEX_CELL ||
+        cells_to_faces_offsets[(cc)] != cc * NFACES_BY_HEX_CELL) {
+      nnon_hex++;
+    }
+  }
+
+#pragma omp parallel for reduction(+ : nnon_hex)
+  for (int ff = 0; ff < nfaces; ++ff) {
+    if (faces_to_nodes_offsets[(ff)] != ff * NNODES_BY_HEX_FACE) {
+      nnon_hex++;
+    }
+  }
+
+  // The final offsets close the last cell and face
+  return nnon_hex == 0 &&
+         cells_to_nodes_offsets[(ncells)] == ncells * NNODES_BY_HEX_CELL &&
+         cells_to_faces_offsets[(ncells)] == ncells * NFACES_BY_HEX_CELL &&
+         faces_to_nodes_offsets[(nfaces)] == nfaces * NNODES_BY_HEX_FACE;
+}
+
+// Colours the faces so that no two faces of the same colour share a cell
+int init_face_colours(const int nfaces, const int* faces_to_cells0,
+                      const int* faces_to_cells1,
+                      const int* cells_to_faces_offsets,
+                      const int* cells_to_faces, int* face_colours,
+                      int* face_colour_offsets, int* faces_by_colour) {
+
+#pragma omp parallel for
+  for (int ff = 0; ff < nfaces; ++ff) {
+    face_colours[(ff)] = -1;
+  }
+
+  // Greedily choose the first colour not taken by a face of either cell
+  int nface_colours = 0;
+  for (int ff = 0; ff < nfaces; ++ff) {
+    int colour_used[MAX_FACE_COLOURS] = {0};
+    const int cells[2] = {faces_to_cells0[(ff)], faces_to_cells1[(ff)]};
+    for (int cc = 0; cc < 2; ++cc) {
+      const int cell_index = cells[(cc)];
+      if (cell_index == -1) {
+        continue;
+      }
+
+      const int cell_to_faces_off = cells_to_faces_offsets[(cell_index)];
+      const int nfaces_by_cell =
+          cells_to_faces_offsets[(cell_index + 1)] - cell_to_faces_off;
+      for (int ff2 = 0; ff2 < nfaces_by_cell; ++ff2) {
+        const int colour =
+            face_colours[(cells_to_faces[(cell_to_faces_off + ff2)])];
+        if (colour != -1) {
+          colour_used[(colour)] = 1;
+        }
+      }
+    }
+
+    int colour;
+    for (colour = 0; colour < MAX_FACE_COLOURS; ++colour) {
+      if (!colour_used[(colour)]) {
+        break;
+      }
+    }
+    if (colour == MAX_FACE_COLOURS) {
+      TERMINATE("Unable to colour the faces with %d colours.",
+                MAX_FACE_COLOURS);
+    }
+
+    face_colours[(ff)] = colour;
+    nface_colours = max(nface_colours, colour + 1);
+  }
+
+  // Group the faces by colour, keeping the original ordering inside a colour
+  int nfaces_coloured = 0;
+  for (int colour = 0; colour < nface_colours; ++colour) {
+    face_colour_offsets[(colour)] = nfaces_coloured;
+    for (int ff = 0; ff < nfaces; ++ff) {
+      if (face_colours[(ff)] == colour) {
+        faces_by_colour[(nfaces_coloured++)] = ff;
+      }
+    }
+  }
+  face_colour_offsets[(nface_colours)] = nfaces_coloured;
+
+  printf("Coloured %d faces with %d colours.\n", nfaces, nface_colours);
+
+  return nface_colours;
+}
+
+// Determines the unique edges of the mesh, numbering the edge of each face
+// edge, and returns the number of edges
+int init_face_edges_to_edges(const int nfaces,
+                             const int* faces_to_nodes_offsets,
+                             const int* faces_to_nodes,
+                             const int* nodes_to_faces_offsets,
+                             const int* nodes_to_faces,
+                             int* face_edges_to_edges) {
+
+// Find the first face edge joining the same nodes as each face edge
+#pragma omp parallel for
+  for (int ff = 0; ff < nfaces; ++ff) {
+    const int face_to_nodes_off = faces_to_nodes_offsets[(ff)];
+    const int nnodes_by_face =
+        faces_to_nodes_offsets[(ff + 1)] - face_to_nodes_off;
+
+    for (int nn = 0; nn < nnodes_by_face; ++nn) {
+      const int face_edge_index = face_to_nodes_off + nn;
+      const int node_index = faces_to_nodes[(face_edge_index)];
+      const int rnode_index = (nn + 1 < nnodes_by_face)
+                                  ? faces_to_nodes[(face_edge_index + 1)]
+                                  : faces_to_nodes[(face_to_nodes_off)];
+
+      // Every face holding the edge is attached to both of its nodes
+      int first_face_edge = face_edge_index;
+      const int node_to_faces_off = nodes_to_faces_offsets[(node_index)];
+      const int nfaces_by_node =
+          nodes_to_faces_offsets[(node_index + 1)] - node_to_faces_off;
+      for (int ff2 = 0; ff2 < nfaces_by_node; ++ff2) {
+        const int face_index = nodes_to_faces[(node_to_faces_off + ff2)];
+        if (face_index == -1) {
+          continue;
+        }
+
+        const int face2_to_nodes_off = faces_to_nodes_offsets[(face_index)];
+        const int nnodes_by_face2 =
+            faces_to_nodes_offsets[(face_index + 1)] - face2_to_nodes_off;
+        for (int nn2 = 0; nn2 < nnodes_by_face2; ++nn2) {
+          const int face2_edge_index = face2_to_nodes_off + nn2;
+          const int node2_index = faces_to_nodes[(face2_edge_index)];
+          const int rnode2_index = (nn2 + 1 < nnodes_by_face2)
+                                       ? faces_to_nodes[(face2_edge_index + 1)]
+                                       : faces_to_nodes[(face2_to_nodes_off)];
+          if ((node2_index == node_index && rnode2_index == rnode_index) ||
+              (node2_index == rnode_index && rnode2_index == node_index)) {
+            first_face_edge = min(first_face_edge, face2_edge_index);
+          }
+        }
+      }
+
+      face_edges_to_edges[(face_edge_index)] = first_face_edge;
+    }
+  }
+
+  // Number the edges in the order of their first face edge, which always
+  // precedes the face edges that refer to it
+  const int nface_edges = faces_to_nodes_offsets[(nfaces)];
+  int nedges = 0;
+  for (int ee = 0; ee < nface_edges; ++ee) {
+    const int first_face_edge = face_edges_to_edges[(ee)];
+    face_edges_to_edges[(ee)] = (first_face_edge == ee)
+                                    ? nedges++
+                                    : face_edges_to_edges[(first_face_edge)];
+  }
+
+  return nedges;
+}
+
+// Initialises the nodes of each edge and the faces holding it, with the face
+// edge of each face
+void init_edges(const int nfaces, const int nedges,
+                const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+                const int* face_edges_to_edges, int* edges_to_nodes,
+                int* edges_to_faces_offsets, int* edges_to_faces,
+                int* edges_to_face_edges) {
+
+  for (int ee = 0; ee < nedges + 1; ++ee) {
+    edges_to_faces_offsets[(ee)] = 0;
+  }
+
+  // Count the faces of each edge, taking the nodes from the first face edge
+  for (int ff = 0; ff < nfaces; ++ff) {
+    const int face_to_nodes_off = faces_to_nodes_offsets[(ff)];
+    const int nnodes_by_face =
+        faces_to_nodes_offsets[(ff + 1)] - face_to_nodes_off;
+
+    for (int nn = 0; nn < nnodes_by_face; ++nn) {
+      const int face_edge_index = face_to_nodes_off + nn;
+      const int edge_index = face_edges_to_edges[(face_edge_index)];
+      if (edges_to_faces_offsets[(edge_index + 1)]++ == 0) {
+        edges_to_nodes[(edge_index * 2)] = faces_to_nodes[(face_edge_index)];
+        edges_to_nodes[(edge_index * 2 + 1)] =
+            (nn + 1 < nnodes_by_face) ? faces_to_nodes[(face_edge_index + 1)]
+                                      : faces_to_nodes[(face_to_nodes_off)];
+      }
+    }
+  }
+
+  for (int ee = 0; ee < nedges; ++ee) {
+    edges_to_faces_offsets[(ee + 1)] += edges_to_faces_offsets[(ee)];
+  }
+
+  // Fill the faces of each edge, advancing the offsets to the end of each
+  // edge's list and then shifting them back
+  for (int ff = 0; ff < nfaces; ++ff) {
+    const int face_to_nodes_off = faces_to_nodes_offsets[(ff)];
+    const int nnodes_by_face =
+        faces_to_nodes_offsets[(ff + 1)] - face_to_nodes_off;
+
+    for (int nn = 0; nn < nnodes_by_face; ++nn) {
+      const int face_edge_index = face_to_nodes_off + nn;
+      const int edge_index = face_edges_to_edges[(face_edge_index)];
+      const int edge_to_faces_off = edges_to_faces_offsets[(edge_index)]++;
+      edges_to_faces[(edge_to_faces_off)] = ff;
+      edges_to_face_edges[(edge_to_faces_off)] = face_edge_index;
+    }
+  }
+
+  for (int ee = nedges; ee > 0; --ee) {
+    edges_to_faces_offsets[(ee)] = edges_to_faces_offsets[(ee - 1)];
+  }
+  edges_to_faces_offsets[(0)] = 0;
+}
+
+// Colours the edges so that no two edges of the same colour share a node
+int init_edge_colours(const int nedges, const int* edges_to_nodes,
+                      const int* nodes_to_faces_offsets,
+                      const int* nodes_to_faces,
+                      const int* faces_to_nodes_offsets,
+                      const int* faces_to_nodes,
+                      const int* face_edges_to_edges, int* edge_colours,
+                      int* edge_colour_offsets, int* edges_by_colour) {
+
+#pragma omp parallel for
+  for (int ee = 0; ee < nedges; ++ee) {
+    edge_colours[(ee)] = -1;
+  }
+
+  // Greedily choose the first colour not taken by an edge of either node,
+  // finding those edges through the faces attached to each node
+  int nedge_colours = 0;
+  for (int ee = 0; ee < nedges; ++ee) {
+    int colour_used[MAX_EDGE_COLOURS] = {0};
+    for (int nn = 0; nn < 2; ++nn) {
+      const int node_index = edges_to_nodes[(ee * 2 + nn)];
+      const int node_to_faces_off = nodes_to_faces_offsets[(node_index)];
+      const int nfaces_by_node =
+          nodes_to_faces_offsets[(node_index + 1)] - node_to_faces_off;
+
+      for (int ff = 0; ff < nfaces_by_node; ++ff) {
+        const int face_index = nodes_to_faces[(node_to_faces_off + ff)];
+        if (face_index == -1) {
+          continue;
+        }
+
+        const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
+        const int nnodes_by_face =
+            faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
+        for (int nn2 = 0; nn2 < nnodes_by_face; ++nn2) {
+          const int face_edge_index = face_to_nodes_off + nn2;
+          const int rnode_index = (nn2 + 1 < nnodes_by_face)
+                                      ? faces_to_nodes[(face_edge_index + 1)]
+                                      : faces_to_nodes[(face_to_nodes_off)];
+          if (faces_to_nodes[(face_edge_index)] != node_index &&
+              rnode_index != node_index) {
+            continue;
+          }
+
+          const int colour =
+              edge_colours[(face_edges_to_edges[(face_edge_index)])];
+          if (colour != -1) {
+            colour_used[(colour)] = 1;
+          }
+        }
+      }
+    }
+
+    int colour;
+    for (colour = 0; colour < MAX_EDGE_COLOURS; ++colour) {
+      if (!colour_used[(colour)]) {
+        break;
+      }
+    }
+    if (colour == MAX_EDGE_COLOURS) {
+      TERMINATE("Unable to colour the edges with %d colours.",
+                MAX_EDGE_COLOURS);
+    }
+
+    edge_colours[(ee)] = colour;
+    nedge_colours = max(nedge_colours, colour + 1);
+  }
+
+  // Group the edges by colour, keeping the original ordering inside a colour
+  int nedges_coloured = 0;
+  for (int colour = 0; colour < nedge_colours; ++colour) {
+    edge_colour_offsets[(colour)] = nedges_coloured;
+    for (int ee = 0; ee < nedges; ++ee) {
+      if (edge_colours[(ee)] == colour) {
+        edges_by_colour[(nedges_coloured++)] = ee;
+      }
+    }
+  }
+  edge_colour_offsets[(nedge_colours)] = nedges_coloured;
+
+  printf("Coloured %d edges with %d colours.\n", nedges, nedge_colours);
+
+  return nedge_colours;
+}
@@ -17,70 +17,55 @@ void lagrangian_phase(Mesh* mesh, UnstructuredMesh* umesh,
 // Performs the predictor step of the Lagrangian phase
 void predictor(Mesh* mesh, UnstructuredMesh* umesh, HaleData* hale_data) {
 
-  // Update the pressure
-  START_PROFILING(&compute_profile);
-  equation_of_state(umesh->ncells, hale_data->energy0, hale_data->density0,
-                    hale_data->pressure0);
-  STOP_PROFILING(&compute_profile, "equation_of_state");
-
-  // Calculate the nodal volume and sound speed
-  START_PROFILING(&compute_profile);
-  calc_nodal_vol_and_c(
-      umesh->nnodes, umesh->nodes_to_faces_offsets, umesh->nodes_to_faces,
-      umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
-      umesh->faces_to_cells0, umesh->faces_to_cells1, umesh->nodes_x0,
-      umesh->nodes_y0, umesh->nodes_z0, umesh->cell_centroids_x,
-      umesh->cell_centroids_y, umesh->cell_centroids_z, hale_data->energy0,
-      hale_data->nodal_volumes, hale_data->nodal_soundspeed);
-  STOP_PROFILING(&compute_profile, "calc_nodal_vol_and_c");
-
-  // Sets all of the subcell forces to 0
-  START_PROFILING(&compute_profile);
-  zero_subcell_forces(umesh->ncells, umesh->cells_to_nodes_offsets,
-                      hale_data->subcell_force_x, hale_data->subcell_force_y,
-                      hale_data->subcell_force_z);
-  STOP_PROFILING(&compute_profile, "zero_subcell_forces");
+  if (hale_data->fused_predictor && !hale_data->face_centric_forces) {
+    // Update the pressure and set the subcell forces from it in one pass
+    START_PROFILING(&compute_profile);
+    calc_eos_and_pressure_forces(umesh, hale_data);
+    STOP_PROFILING(&compute_profile, "calc_eos_and_pressure_forces");
+  } else {
+    // Update the pressure
+    START_PROFILING(&compute_profile);
+    equation_of_state(hale_data->nfrontier_cells, hale_data->frontier_cells,
+                      hale_data->energy0, hale_data->density0,
+                      hale_data->pressure0);
+    STOP_PROFILING(&compute_profile, "equation_of_state");
+
+    // Sets all of the subcell forces to 0
+    START_PROFILING(&compute_profile);
+    zero_subcell_forces(hale_data->nfrontier_cells, hale_data->frontier_cells,
+                        umesh->cells_to_nodes_offsets,
+                        hale_data->subcell_force_x, hale_data->subcell_force_y,
+                        hale_data->subcell_force_z);
+    STOP_PROFILING(&compute_profile, "zero_subcell_forces");
 
-  START_PROFILING(&compute_profile);
-  calc_subcell_force_from_pressure(
-      umesh->ncells, umesh->cells_to_faces_offsets,
-      umesh->cells_to_nodes_offsets, umesh->cells_to_faces,
-      umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
-      umesh->cells_to_nodes, umesh->faces_cclockwise_cell, umesh->nodes_x0,
-      umesh->nodes_y0, umesh->nodes_z0, hale_data->pressure0,
-      hale_data->subcell_force_x, hale_data->subcell_force_y,
-      hale_data->subcell_force_z);
-  STOP_PROFILING(&compute_profile, "calc_subcell_force_from_pressure");
+    START_PROFILING(&compute_profile);
+    calc_pressure_forces(umesh, hale_data, hale_data->pressure0);
+    STOP_PROFILING(&compute_profile, "calc_subcell_force_from_pressure");
+  }
 
+  // Calculate the nodal volume and sound speed, where the subcell geometry of
+  // the current mesh was left by the corrector or the remap
   START_PROFILING(&compute_profile);
-  scale_soundspeed(umesh->nnodes, hale_data->nodal_volumes,
-                   hale_data->nodal_soundspeed);
-  STOP_PROFILING(&compute_profile, "scale_soundspeed");
+  calc_nodal_vol_and_c(umesh->nnodes, umesh->nodes_to_cells_offsets,
+                       umesh->nodes_to_cells, hale_data->nodes_to_subcells,
+                       hale_data->subcell_volume, hale_data->energy0,
+                       hale_data->nodal_volumes, hale_data->nodal_soundspeed);
+  STOP_PROFILING(&compute_profile, "calc_nodal_vol_and_c");
 
   START_PROFILING(&compute_profile);
-  calc_artificial_viscosity(
-      umesh->ncells, hale_data->visc_coeff1, hale_data->visc_coeff2,
-      umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
-      umesh->faces_cclockwise_cell, umesh->nodes_x0, umesh->nodes_y0,
-      umesh->nodes_z0, umesh->cell_centroids_x, umesh->cell_centroids_y,
-      umesh->cell_centroids_z, hale_data->velocity_x0, hale_data->velocity_y0,
-      hale_data->velocity_z0, hale_data->nodal_soundspeed,
-      hale_data->nodal_mass, hale_data->nodal_volumes, hale_data->limiter,
-      hale_data->subcell_force_x, hale_data->subcell_force_y,
-      hale_data->subcell_force_z, umesh->faces_to_nodes_offsets,
-      umesh->faces_to_nodes, umesh->cells_to_faces_offsets,
-      umesh->cells_to_faces);
+  calc_viscous_forces(umesh, hale_data, umesh->nodes_x0, umesh->nodes_y0,
+                      umesh->nodes_z0, hale_data->velocity_x0,
+                      hale_data->velocity_y0, hale_data->velocity_z0);
   STOP_PROFILING(&compute_profile, "calc_artificial_viscosity");
 
   START_PROFILING(&compute_profile);
-  calc_new_velocity(umesh->nnodes, mesh->dt, umesh->nodes_to_cells_offsets,
-                    umesh->nodes_to_cells, umesh->cells_to_nodes_offsets,
-                    umesh->cells_to_nodes, hale_data->subcell_force_x,
-                    hale_data->subcell_force_y, hale_data->subcell_force_z,
-                    hale_data->nodal_mass, hale_data->velocity_x0,
-                    hale_data->velocity_y0, hale_data->velocity_z0,
-                    hale_data->velocity_x1, hale_data->velocity_y1,
-                    hale_data->velocity_z1);
+  calc_new_velocity(
+      hale_data->nfrontier_nodes, hale_data->frontier_nodes, mesh->dt,
+      umesh->nodes_to_cells_offsets, hale_data->nodes_to_subcells,
+      hale_data->subcell_force_x, hale_data->subcell_force_y,
+      hale_data->subcell_force_z, hale_data->nodal_mass, hale_data->velocity_x0,
+      hale_data->velocity_y0, hale_data->velocity_z0, hale_data->velocity_x1,
+      hale_data->velocity_y1, hale_data->velocity_z1);
   STOP_PROFILING(&compute_profile, "calc_new_velocity");
 
   // TODO: NEED TO WORK OUT HOW TO HANDLE BOUNDARY CONDITIONS REASONABLY
@@ -92,55 +77,77 @@ void predictor(Mesh* mesh, UnstructuredMesh* umesh, HaleData* hale_data) {
 
   // Move the nodes by the predicted velocity
   START_PROFILING(&compute_profile);
-  move_nodes(umesh->nnodes, mesh->dt, umesh->nodes_x0, umesh->nodes_y0,
-             umesh->nodes_z0, hale_data->velocity_x1, hale_data->velocity_y1,
+  move_nodes(hale_data->nfrontier_nodes, hale_data->frontier_nodes, mesh->dt,
+             umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0,
+             hale_data->velocity_x1, hale_data->velocity_y1,
              hale_data->velocity_z1, umesh->nodes_x1, umesh->nodes_y1,
              umesh->nodes_z1);
   STOP_PROFILING(&compute_profile, "move_nodes");
 
-  init_cell_centroids(umesh->ncells, umesh->cells_to_nodes_offsets,
-                      umesh->cells_to_nodes, umesh->nodes_x1, umesh->nodes_y1,
-                      umesh->nodes_z1, umesh->cell_centroids_x,
-                      umesh->cell_centroids_y, umesh->cell_centroids_z);
-
-  set_timestep(umesh->ncells, umesh->nodes_x1, umesh->nodes_y1, umesh->nodes_z1,
-               hale_data->energy0, &mesh->dt, umesh->cells_to_faces_offsets,
-               umesh->cells_to_faces, umesh->faces_to_nodes_offsets,
-               umesh->faces_to_nodes);
+  update_cell_centroids(umesh, hale_data, umesh->nodes_x1, umesh->nodes_y1,
+                        umesh->nodes_z1);
+
+  // Update the face geometry for the predicted mesh, only determining the
+  // timestep here if requested, as the corrector sets it for the next step.
+  // The predicted mesh can only shorten the timestep the corrector chose, so
+  // the growth is bounded once per step, against the previous timestep.
+  if (hale_data->predictor_timestep) {
+    const time_limit_t edge_limit = update_face_geometry(
+        umesh, hale_data, umesh->nodes_x1, umesh->nodes_y1, umesh->nodes_z1,
+        hale_data->energy0, hale_data->velocity_x1, hale_data->velocity_y1,
+        hale_data->velocity_z1);
+    if (CFL * edge_limit.time < mesh->dt) {
+      const time_limit_t volume_limit = {DBL_MAX, -1};
+      set_timestep(0.0, 0.0, edge_limit, volume_limit, &mesh->dt);
+    }
+  } else {
+    update_face_geometry(umesh, hale_data, umesh->nodes_x1, umesh->nodes_y1,
+                         umesh->nodes_z1, NULL, NULL, NULL, NULL);
+  }
 
   // Calculate the predicted energy
   START_PROFILING(&compute_profile);
-  calc_predicted_energy(umesh->ncells, mesh->dt, umesh->cells_to_nodes_offsets,
-                        umesh->cells_to_nodes, hale_data->velocity_x1,
-                        hale_data->velocity_y1, hale_data->velocity_z1,
-                        hale_data->subcell_force_x, hale_data->subcell_force_y,
-                        hale_data->subcell_force_z, hale_data->energy0,
-                        hale_data->cell_mass, hale_data->energy1);
+  calc_predicted_energy(
+      hale_data->nfrontier_cells, hale_data->frontier_cells, mesh->dt,
+      umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
+      hale_data->velocity_x1, hale_data->velocity_y1, hale_data->velocity_z1,
+      hale_data->subcell_force_x, hale_data->subcell_force_y,
+      hale_data->subcell_force_z, hale_data->energy0, hale_data->cell_mass,
+      hale_data->energy1);
   STOP_PROFILING(&compute_profile, "calc_predicted_energy");
 
+  // Update the subcell geometry for the predicted mesh
+  START_PROFILING(&compute_profile);
+  update_subcell_geometry(umesh, hale_data, umesh->nodes_x1, umesh->nodes_y1,
+                          umesh->nodes_z1);
+  STOP_PROFILING(&compute_profile, "update_subcell_geometry");
+
   // Using the new volume, calculate the predicted density
   START_PROFILING(&compute_profile);
-  calc_predicted_density(
-      umesh->ncells, umesh->cells_to_faces_offsets, umesh->cells_to_faces,
-      umesh->faces_to_nodes_offsets, umesh->faces_to_nodes, umesh->nodes_x1,
-      umesh->nodes_y1, umesh->nodes_z1, umesh->cell_centroids_x,
-      umesh->cell_centroids_y, umesh->cell_centroids_z, hale_data->cell_mass,
-      hale_data->density1);
+  calc_predicted_density(hale_data->nfrontier_cells, hale_data->frontier_cells,
+                         umesh->cells_to_nodes_offsets,
+                         hale_data->subcell_volume, hale_data->cell_mass,
+                         hale_data->density1);
   STOP_PROFILING(&compute_profile, "calc_predicted_density");
 
   // Calculate the time centered pressure from mid point between rezoned and
   // predicted pressures
   START_PROFILING(&compute_profile);
-  time_center_pressure(umesh->ncells, hale_data->energy1, hale_data->density1,
+  time_center_pressure(hale_data->nfrontier_cells, hale_data->frontier_cells,
+                       hale_data->energy1, hale_data->density1,
                        hale_data->pressure0, hale_data->pressure1);
   STOP_PROFILING(&compute_profile, "time_center_pressure");
 
   // Prepare time centered variables for the corrector step
   START_PROFILING(&compute_profile);
-  time_center_nodes(umesh->nnodes, umesh->nodes_x0, umesh->nodes_y0,
-                    umesh->nodes_z0, umesh->nodes_x1, umesh->nodes_y1,
-                    umesh->nodes_z1);
+  time_center_nodes(hale_data->nfrontier_nodes, hale_data->frontier_nodes,
+                    umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0,
+                    umesh->nodes_x1, umesh->nodes_y1, umesh->nodes_z1);
   STOP_PROFILING(&compute_profile, "time_center_nodes");
+
+  // Update the face geometry for the time centered mesh
+  update_face_geometry(umesh, hale_data, umesh->nodes_x1, umesh->nodes_y1,
+                       umesh->nodes_z1, NULL, NULL, NULL, NULL);
 }
 
 // Performs the corrector step of the Lagrangian phase
@@ -148,58 +155,40 @@ void corrector(Mesh* mesh, UnstructuredMesh* umesh, HaleData* hale_data) {
 
   // Sets all of the subcell forces to 0
   START_PROFILING(&compute_profile);
-  zero_subcell_forces(umesh->ncells, umesh->cells_to_nodes_offsets,
-                      hale_data->subcell_force_x, hale_data->subcell_force_y,
-                      hale_data->subcell_force_z);
+  zero_subcell_forces(hale_data->nfrontier_cells, hale_data->frontier_cells,
+                      umesh->cells_to_nodes_offsets, hale_data->subcell_force_x,
+                      hale_data->subcell_force_y, hale_data->subcell_force_z);
   STOP_PROFILING(&compute_profile, "calc_nodal_mass_vol");
 
-  // Calculate the nodal mass
+  // Update the subcell geometry for the time centered mesh
   START_PROFILING(&compute_profile);
-  calc_nodal_vol_and_c(
-      umesh->nnodes, umesh->nodes_to_faces_offsets, umesh->nodes_to_faces,
-      umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
-      umesh->faces_to_cells0, umesh->faces_to_cells1, umesh->nodes_x1,
-      umesh->nodes_y1, umesh->nodes_z1, umesh->cell_centroids_x,
-      umesh->cell_centroids_y, umesh->cell_centroids_z, hale_data->energy1,
-      hale_data->nodal_volumes, hale_data->nodal_soundspeed);
-  STOP_PROFILING(&compute_profile, "calc_nodal_vol_and_c");
+  update_subcell_geometry(umesh, hale_data, umesh->nodes_x1, umesh->nodes_y1,
+                          umesh->nodes_z1);
+  STOP_PROFILING(&compute_profile, "update_subcell_geometry");
 
+  // Calculate the nodal volume and sound speed
   START_PROFILING(&compute_profile);
-  scale_soundspeed(umesh->nnodes, hale_data->nodal_volumes,
-                   hale_data->nodal_soundspeed);
-  STOP_PROFILING(&compute_profile, "scale_soundspeed");
+  calc_nodal_vol_and_c(umesh->nnodes, umesh->nodes_to_cells_offsets,
+                       umesh->nodes_to_cells, hale_data->nodes_to_subcells,
+                       hale_data->subcell_volume, hale_data->energy1,
+                       hale_data->nodal_volumes, hale_data->nodal_soundspeed);
+  STOP_PROFILING(&compute_profile, "calc_nodal_vol_and_c");
 
   // Calculate the pressure gradients
   START_PROFILING(&compute_profile);
-  calc_subcell_force_from_pressure(
-      umesh->ncells, umesh->cells_to_faces_offsets,
-      umesh->cells_to_nodes_offsets, umesh->cells_to_faces,
-      umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
-      umesh->cells_to_nodes, umesh->faces_cclockwise_cell, umesh->nodes_x1,
-      umesh->nodes_y1, umesh->nodes_z1, hale_data->pressure1,
-      hale_data->subcell_force_x, hale_data->subcell_force_y,
-      hale_data->subcell_force_z);
+  calc_pressure_forces(umesh, hale_data, hale_data->pressure1);
   STOP_PROFILING(&compute_profile, "node_force_from_pressure");
 
-  calc_artificial_viscosity(
-      umesh->ncells, hale_data->visc_coeff1, hale_data->visc_coeff2,
-      umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
-      umesh->faces_cclockwise_cell, umesh->nodes_x1, umesh->nodes_y1,
-      umesh->nodes_z1, umesh->cell_centroids_x, umesh->cell_centroids_y,
-      umesh->cell_centroids_z, hale_data->velocity_x1, hale_data->velocity_y1,
-      hale_data->velocity_z1, hale_data->nodal_soundspeed,
-      hale_data->nodal_mass, hale_data->nodal_volumes, hale_data->limiter,
-      hale_data->subcell_force_x, hale_data->subcell_force_y,
-      hale_data->subcell_force_z, umesh->faces_to_nodes_offsets,
-      umesh->faces_to_nodes, umesh->cells_to_faces_offsets,
-      umesh->cells_to_faces);
+  calc_viscous_forces(umesh, hale_data, umesh->nodes_x1, umesh->nodes_y1,
+                      umesh->nodes_z1, hale_data->velocity_x1,
+                      hale_data->velocity_y1, hale_data->velocity_z1);
 
   START_PROFILING(&compute_profile);
   // Updates and time center velocity in the corrector step
   update_and_time_center_velocity(
-      umesh->nnodes, mesh->dt, umesh->nodes_to_cells_offsets,
-      umesh->nodes_to_cells, umesh->cells_to_nodes_offsets,
-      umesh->cells_to_nodes, hale_data->nodal_mass, hale_data->subcell_force_x,
+      hale_data->nfrontier_nodes, hale_data->frontier_nodes, mesh->dt,
+      umesh->nodes_to_cells_offsets, hale_data->nodes_to_subcells,
+      hale_data->nodal_mass, hale_data->subcell_force_x,
       hale_data->subcell_force_y, hale_data->subcell_force_z,
       hale_data->velocity_x0, hale_data->velocity_y0, hale_data->velocity_z0,
       hale_data->velocity_x1, hale_data->velocity_y1, hale_data->velocity_z1);
@@ -213,175 +202,110 @@ void corrector(Mesh* mesh, UnstructuredMesh* umesh, HaleData* hale_data) {
 
   // Advances the nodes using the corrected velocity
   START_PROFILING(&compute_profile);
-  advance_nodes_corrected(umesh->nnodes, mesh->dt, hale_data->velocity_x0,
+  advance_nodes_corrected(hale_data->nfrontier_nodes, hale_data->frontier_nodes,
+                          mesh->dt, hale_data->velocity_x0,
                           hale_data->velocity_y0, hale_data->velocity_z0,
                           umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0);
   STOP_PROFILING(&compute_profile, "advance_nodes_corrected");
 
-  set_timestep(umesh->ncells, umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0,
-               hale_data->energy1, &mesh->dt, umesh->cells_to_faces_offsets,
-               umesh->cells_to_faces, umesh->faces_to_nodes_offsets,
-               umesh->faces_to_nodes);
-
-  // Calculate the corrected energy
-  START_PROFILING(&compute_profile);
-  calc_corrected_energy(umesh->ncells, mesh->dt, umesh->cells_to_nodes_offsets,
-                        umesh->cells_to_nodes, hale_data->velocity_x0,
-                        hale_data->velocity_y0, hale_data->velocity_z0,
-                        hale_data->subcell_force_x, hale_data->subcell_force_y,
-                        hale_data->subcell_force_z, hale_data->cell_mass,
-                        hale_data->energy0);
-  STOP_PROFILING(&compute_profile, "calc_corrected_energy");
+  // Update the face geometry for the corrected mesh, determining the shortest
+  // edge signal time for the next timestep in the same pass
+  const time_limit_t edge_limit = update_face_geometry(
+      umesh, hale_data, umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0,
+      hale_data->energy1, hale_data->velocity_x0, hale_data->velocity_y0,
+      hale_data->velocity_z0);
 
-  init_cell_centroids(umesh->ncells, umesh->cells_to_nodes_offsets,
-                      umesh->cells_to_nodes, umesh->nodes_x0, umesh->nodes_y0,
-                      umesh->nodes_z0, umesh->cell_centroids_x,
-                      umesh->cell_centroids_y, umesh->cell_centroids_z);
+  // Update the energy with the timestep the nodes were advanced by, and limit
+  // the next timestep by the volume change of each cell over this one
+  time_limit_t volume_limit;
+  if (hale_data->fused_corrector) {
+    START_PROFILING(&compute_profile);
+    volume_limit = update_corrected_cells(umesh, hale_data, mesh->dt);
+    STOP_PROFILING(&compute_profile, "update_corrected_cells");
+  } else {
+    // Calculate the corrected energy
+    START_PROFILING(&compute_profile);
+    calc_corrected_energy(
+        hale_data->nfrontier_cells, hale_data->frontier_cells, mesh->dt,
+        umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
+        hale_data->velocity_x0, hale_data->velocity_y0, hale_data->velocity_z0,
+        hale_data->subcell_force_x, hale_data->subcell_force_y,
+        hale_data->subcell_force_z, hale_data->cell_mass, hale_data->energy0);
+    STOP_PROFILING(&compute_profile, "calc_corrected_energy");
+
+    update_cell_centroids(umesh, hale_data, umesh->nodes_x0, umesh->nodes_y0,
+                          umesh->nodes_z0);
+
+    // Update the subcell geometry for the corrected mesh
+    START_PROFILING(&compute_profile);
+    update_subcell_geometry(umesh, hale_data, umesh->nodes_x0, umesh->nodes_y0,
+                            umesh->nodes_z0);
+    STOP_PROFILING(&compute_profile, "update_subcell_geometry");
+
+    // Using the new corrected volume, calculate the density
+    START_PROFILING(&compute_profile);
+    volume_limit = calc_corrected_density(
+        hale_data->nfrontier_cells, hale_data->frontier_cells, mesh->dt,
+        umesh->cells_to_nodes_offsets, hale_data->subcell_volume,
+        hale_data->cell_mass, hale_data->cell_volume, hale_data->density0);
+    STOP_PROFILING(&compute_profile, "calc_corrected_density");
+  }
 
-  // Using the new corrected volume, calculate the density
-  START_PROFILING(&compute_profile);
-  calc_corrected_density(
-      umesh->ncells, umesh->cells_to_faces_offsets, umesh->cells_to_faces,
-      umesh->faces_to_nodes_offsets, umesh->faces_to_nodes, umesh->nodes_x0,
-      umesh->nodes_y0, umesh->nodes_z0, umesh->cell_centroids_x,
-      umesh->cell_centroids_y, umesh->cell_centroids_z, hale_data->cell_mass,
-      hale_data->cell_volume, hale_data->density0);
-  STOP_PROFILING(&compute_profile, "calc_corrected_density");
+  set_timestep(hale_data->max_dt_growth, hale_data->max_volume_change,
+               edge_limit, volume_limit, &mesh->dt);
 }
 
 // A simple ideal gas equation of state
-void equation_of_state(const int ncells, const double* energy,
-                       const double* density, double* pressure) {
+void equation_of_state(const int ncells, const int* cell_list,
+                       const double* energy, const double* density,
+                       double* pressure) {
 #pragma omp parallel for
-  for (int cc = 0; cc < ncells; ++cc) {
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
     pressure[(cc)] = (GAM - 1.0) * energy[(cc)] * density[(cc)];
   }
 }
 
-// Calculates the nodal volume and sound speed
-void calc_nodal_vol_and_c(const int nnodes, const int* nodes_to_faces_offsets,
-                          const int* nodes_to_faces,
-                          const int* faces_to_nodes_offsets,
-                          const int* faces_to_nodes, const int* faces_to_cells0,
-                          const int* faces_to_cells1, const double* nodes_x,
-                          const double* nodes_y, const double* nodes_z,
-                          const double* cell_centroids_x,
-                          const double* cell_centroids_y,
-                          const double* cell_centroids_z, const double* energy,
+// Calculates the nodal volume and the volume weighted sound speed from the
+// volumes of the subcells around each node
+void calc_nodal_vol_and_c(const int nnodes, const int* nodes_to_cells_offsets,
+                          const int* nodes_to_cells,
+                          const int* nodes_to_subcells,
+                          const double* subcell_volume, const double* energy,
                           double* nodal_volumes, double* nodal_soundspeed) {
 
 #pragma omp parallel for
   for (int nn = 0; nn < nnodes; ++nn) {
-    const int node_to_faces_off = nodes_to_faces_offsets[(nn)];
-    const int nfaces_by_node =
-        nodes_to_faces_offsets[(nn + 1)] - node_to_faces_off;
-
-    nodal_volumes[(nn)] = 0.0;
-    nodal_soundspeed[(nn)] = 0.0;
-
-    // Consider all faces attached to node
-    for (int ff = 0; ff < nfaces_by_node; ++ff) {
-      const int face_index = nodes_to_faces[(node_to_faces_off + ff)];
-      if (face_index == -1) {
-        continue;
-      }
-
-      // Determine the offset into the list of nodes
-      const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
-      const int nnodes_by_face =
-          faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
-
-      // Find node center and location of current node on face
-      vec_t face_c = {0.0, 0.0, 0.0};
-      int node_in_face_c;
-      for (int nn2 = 0; nn2 < nnodes_by_face; ++nn2) {
-        const int node_index = faces_to_nodes[(face_to_nodes_off + nn2)];
-        face_c.x += nodes_x[(node_index)] / nnodes_by_face;
-        face_c.y += nodes_y[(node_index)] / nnodes_by_face;
-        face_c.z += nodes_z[(node_index)] / nnodes_by_face;
-
-        // Choose the node in the list of nodes attached to the face
-        if (nn == node_index) {
-          node_in_face_c = nn2;
-        }
-      }
+    const int node_to_cells_off = nodes_to_cells_offsets[(nn)];
+    const int ncells_by_node =
+        nodes_to_cells_offsets[(nn + 1)] - node_to_cells_off;
 
-      // Fetch the nodes attached to our current node on the current face
-      int local_nodes[2];
-      local_nodes[0] =
-          (node_in_face_c - 1 >= 0)
-              ? faces_to_nodes[(face_to_nodes_off + node_in_face_c - 1)]
-              : faces_to_nodes[(face_to_nodes_off + nnodes_by_face - 1)];
-      local_nodes[1] =
-          (node_in_face_c + 1 < nnodes_by_face)
-              ? faces_to_nodes[(face_to_nodes_off + node_in_face_c + 1)]
-              : faces_to_nodes[(face_to_nodes_off)];
-
-      // Fetch the cells attached to our current face
-      int local_cells[2];
-      local_cells[0] = faces_to_cells0[(face_index)];
-      local_cells[1] = faces_to_cells1[(face_index)];
-
-      // Add contributions from both of the cells attached to the face
-      for (int cc = 0; cc < 2; ++cc) {
-        const int cell_index = local_cells[(cc)];
-        if (cell_index == -1) {
-          continue;
-        }
+    double nodal_volume = 0.0;
+    double nodal_c = 0.0;
 
-        // Add contributions for both edges attached to our current node
-        for (int nn2 = 0; nn2 < 2; ++nn2) {
-          const double subsubcell_vol = calc_subsubcell_volume(
-              cell_index, local_nodes[(nn2)], nn, face_c, nodes_x, nodes_y,
-              nodes_z, cell_centroids_x, cell_centroids_y, cell_centroids_z);
-          nodal_soundspeed[(nn)] +=
-              sqrt(GAM * (GAM - 1.0) * energy[(cell_index)]) * subsubcell_vol;
-          nodal_volumes[(nn)] += subsubcell_vol;
-        }
-      }
+    // Consider the subcells of all cells attached to node
+    for (int cc = 0; cc < ncells_by_node; ++cc) {
+      const int cell_index = nodes_to_cells[(node_to_cells_off + cc)];
+      const int subcell_index = nodes_to_subcells[(node_to_cells_off + cc)];
+      const double subcell_vol = subcell_volume[(subcell_index)];
+      nodal_c += sqrt(GAM * (GAM - 1.0) * energy[(cell_index)]) * subcell_vol;
+      nodal_volume += subcell_vol;
     }
-  }
-}
-
-// Calculates the volume of a subsubcell
-double calc_subsubcell_volume(const int cc, const int rnode_index,
-                              const int node_index, vec_t face_c,
-                              const double* nodes_x, const double* nodes_y,
-                              const double* nodes_z,
-                              const double* cell_centroids_x,
-                              const double* cell_centroids_y,
-                              const double* cell_centroids_z) {
-
-  // Construct the vectors describing an edge tetrahedron
-  const vec_t ad = {(face_c.x - nodes_x[(node_index)]),
-                    (face_c.y - nodes_y[(node_index)]),
-                    (face_c.z - nodes_z[(node_index)])};
-  const vec_t bd = {nodes_x[(rnode_index)] - nodes_x[(node_index)],
-                    nodes_y[(rnode_index)] - nodes_y[(node_index)],
-                    nodes_z[(rnode_index)] - nodes_z[(node_index)]};
-  const vec_t cd = {cell_centroids_x[(cc)] - nodes_x[(node_index)],
-                    cell_centroids_y[(cc)] - nodes_y[(node_index)],
-                    cell_centroids_z[(cc)] - nodes_z[(node_index)]};
-
-  // Fetch the are vector of one of the faces of the tetrahedron
-  const vec_t area = {0.5 * (ad.y * bd.z - ad.z * bd.y),
-                      -0.5 * (ad.x * bd.z - ad.z * bd.x),
-                      0.5 * (ad.x * bd.y - ad.y * bd.x)};
 
-  // Determine the volume using standard irregular tetrahedron formula
-  const double edge_subcell_vol =
-      fabs(cd.x * area.x + cd.y * area.y + cd.z * area.z) / 3.0;
-
-  // The subsubcell is half the volume of the edge subcell
-  return 0.5 * edge_subcell_vol;
+    // The sound speed is volume weighted, so scale it here
+    nodal_volumes[(nn)] = nodal_volume;
+    nodal_soundspeed[(nn)] = nodal_c / nodal_volume;
+  }
 }
 
 // Sets all of the subcell forces to 0
-void zero_subcell_forces(const int ncells, const int* cells_to_nodes_offsets,
+void zero_subcell_forces(const int ncells, const int* cell_list,
+                         const int* cells_to_nodes_offsets,
                          double* subcell_force_x, double* subcell_force_y,
                          double* subcell_force_z) {
 #pragma omp parallel for
-  for (int cc = 0; cc < ncells; ++cc) {
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
     const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
     const int nnodes_by_cell =
         cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
@@ -394,24 +318,65 @@ void zero_subcell_forces(const int ncells, const int* cells_to_nodes_offsets,
   }
 }
 
+// Adds the pressure force on a face of the cell to the cell's subcells, with
+// the subcell forces indexed from subcell_off
+static inline void add_face_pressure_forces(
+    const int cc, const int face_index, const int nnodes_by_face,
+    const int face_to_nodes_off, const int subcell_off,
+    const double cell_pressure, const int* faces_to_cells0,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const int* faces_cclockwise_cell, const double* face_edge_area_x,
+    const double* face_edge_area_y, const double* face_edge_area_z,
+    double* force_x, double* force_y, double* force_z) {
+
+  // The edge area vectors are stored for the counter-clockwise ordering of
+  // the face, and are equal and opposite for the clockwise cell
+  const double face_pressure =
+      (faces_cclockwise_cell[(face_index)] != cc) ? -cell_pressure
+                                                  : cell_pressure;
+
+  // The subcells of the face nodes from this cell's side of the face
+  const int* face_nodes_to_subcells =
+      ((faces_to_cells0[(face_index)] == cc) ? faces_nodes_to_subcells0
+                                             : faces_nodes_to_subcells1) +
+      face_to_nodes_off;
+
+  for (int nn2 = 0; nn2 < nnodes_by_face; ++nn2) {
+    // Fetch the subcells of the current and next nodes on the face
+    const int next_node = (nn2 == nnodes_by_face - 1) ? 0 : nn2 + 1;
+    const int subcell = face_nodes_to_subcells[(nn2)] - subcell_off;
+    const int rsubcell = face_nodes_to_subcells[(next_node)] - subcell_off;
+
+    const int edge_index = face_to_nodes_off + nn2;
+    const double Ax = face_pressure * face_edge_area_x[(edge_index)];
+    const double Ay = face_pressure * face_edge_area_y[(edge_index)];
+    const double Az = face_pressure * face_edge_area_z[(edge_index)];
+
+    force_x[(subcell)] += Ax;
+    force_y[(subcell)] += Ay;
+    force_z[(subcell)] += Az;
+    force_x[(rsubcell)] += Ax;
+    force_y[(rsubcell)] += Ay;
+    force_z[(rsubcell)] += Az;
+  }
+}
+
 // Calculate the subcell force from pressure gradients
 void calc_subcell_force_from_pressure(
-    const int ncells, const int* cells_to_faces_offsets,
-    const int* cells_to_nodes_offsets, const int* cells_to_faces,
-    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
-    const int* cells_to_nodes, const int* faces_cclockwise_cell,
-    const double* nodes_x, const double* nodes_y, const double* nodes_z,
-    const double* pressure, double* subcell_force_x, double* subcell_force_y,
-    double* subcell_force_z) {
+    const int ncells, const int* cell_list, const int* cells_to_faces_offsets,
+    const int* cells_to_faces, const int* faces_to_nodes_offsets,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const int* faces_cclockwise_cell,
+    const double* face_edge_area_x, const double* face_edge_area_y,
+    const double* face_edge_area_z, const double* pressure,
+    double* subcell_force_x, double* subcell_force_y, double* subcell_force_z) {
 
 #pragma omp parallel for
-  for (int cc = 0; cc < ncells; ++cc) {
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
     const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
     const int nfaces_by_cell =
         cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
-    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
-    const int nnodes_by_cell =
-        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
 
     // Look at all of the faces attached to the cell
     for (int ff = 0; ff < nfaces_by_cell; ++ff) {
@@ -420,79 +385,284 @@ void calc_subcell_force_from_pressure(
       const int nnodes_by_face =
           faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
 
-      // Calculate the face center... SHOULD WE PRECOMPUTE?
-      vec_t face_c = {0.0, 0.0, 0.0};
-      calc_centroid(nnodes_by_face, nodes_x, nodes_y, nodes_z, faces_to_nodes,
-                    face_to_nodes_off, &face_c);
+      // Each face is visited once per adjacent cell here, while
+      // calc_subcell_force_from_pressure_by_face visits it once for both cells,
+      // selected with face_centric_forces
+      add_face_pressure_forces(
+          cc, face_index, nnodes_by_face, face_to_nodes_off, 0, pressure[(cc)],
+          faces_to_cells0, faces_nodes_to_subcells0, faces_nodes_to_subcells1,
+          faces_cclockwise_cell, face_edge_area_x, face_edge_area_y,
+          face_edge_area_z, subcell_force_x, subcell_force_y, subcell_force_z);
+    }
+  }
+}
+
+// Calculate the subcell force from pressure gradients on a hexahedral mesh
+void calc_subcell_force_from_pressure_hex(
+    const int ncells, const int* cell_list, const int* cells_to_faces,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const int* faces_cclockwise_cell,
+    const double* face_edge_area_x, const double* face_edge_area_y,
+    const double* face_edge_area_z, const double* pressure,
+    double* subcell_force_x, double* subcell_force_y, double* subcell_force_z) {
+
+#pragma omp parallel for
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
+    const int cell_to_faces_off = cc * NFACES_BY_HEX_CELL;
+    const int cell_to_nodes_off = cc * NNODES_BY_HEX_CELL;
+
+    // Accumulate the forces for the cell's subcells locally
+    double cell_force_x[NNODES_BY_HEX_CELL] = {0.0};
+    double cell_force_y[NNODES_BY_HEX_CELL] = {0.0};
+    double cell_force_z[NNODES_BY_HEX_CELL] = {0.0};
+
+    for (int ff = 0; ff < NFACES_BY_HEX_CELL; ++ff) {
+      const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
+      add_face_pressure_forces(
+          cc, face_index, NNODES_BY_HEX_FACE, face_index * NNODES_BY_HEX_FACE,
+          cell_to_nodes_off, pressure[(cc)], faces_to_cells0,
+          faces_nodes_to_subcells0, faces_nodes_to_subcells1,
+          faces_cclockwise_cell, face_edge_area_x, face_edge_area_y,
+          face_edge_area_z, cell_force_x, cell_force_y, cell_force_z);
+    }
+
+    for (int nn = 0; nn < NNODES_BY_HEX_CELL; ++nn) {
+      subcell_force_x[(cell_to_nodes_off + nn)] += cell_force_x[(nn)];
+      subcell_force_y[(cell_to_nodes_off + nn)] += cell_force_y[(nn)];
+      subcell_force_z[(cell_to_nodes_off + nn)] += cell_force_z[(nn)];
+    }
+  }
+}
+
+// Calculate the subcell force from pressure gradients, visiting each face once
+// and applying its contribution to both adjacent cells, with each side scaled
+// by the pressure of its own cell
+void calc_subcell_force_from_pressure_by_face(
+    const int nface_colours, const int* face_colour_offsets,
+    const int* faces_by_colour, const int* faces_to_cells0,
+    const int* faces_to_cells1, const int* faces_to_nodes_offsets,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const int* faces_cclockwise_cell, const double* face_edge_area_x,
+    const double* face_edge_area_y, const double* face_edge_area_z,
+    const double* pressure, double* subcell_force_x, double* subcell_force_y,
+    double* subcell_force_z) {
+
+  // The faces of a single colour share no cells, so they can contribute to
+  // the subcell forces without any races
+  for (int colour = 0; colour < nface_colours; ++colour) {
+    const int colour_start = face_colour_offsets[(colour)];
+    const int colour_end = face_colour_offsets[(colour + 1)];
+
+#pragma omp parallel for
+    for (int ff = colour_start; ff < colour_end; ++ff) {
+      const int face_index = faces_by_colour[(ff)];
+      const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
+      const int nnodes_by_face =
+          faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
+      const int cells[2] = {faces_to_cells0[(face_index)],
+                            faces_to_cells1[(face_index)]};
+      const int* face_nodes_to_subcells[2] = {
+          faces_nodes_to_subcells0 + face_to_nodes_off,
+          faces_nodes_to_subcells1 + face_to_nodes_off};
 
-      // Now we will sum the contributions at each of the nodes
-      // TODO: THERE IS SOME SYMMETRY HERE THAT MEANS WE MIGHT BE ABLE TO
-      // OPTIMISE
       for (int nn2 = 0; nn2 < nnodes_by_face; ++nn2) {
-        // Fetch the nodes attached to our current node on the current face
-        const int node_index = faces_to_nodes[(face_to_nodes_off + nn2)];
-        const int face_clockwise = (faces_cclockwise_cell[(face_index)] != cc);
         const int next_node = (nn2 == nnodes_by_face - 1) ? 0 : nn2 + 1;
-        const int prev_node = (nn2 == 0) ? nnodes_by_face - 1 : nn2 - 1;
-        const int rnode_off = (face_clockwise ? prev_node : next_node);
-        const int rnode_index = faces_to_nodes[(face_to_nodes_off + rnode_off)];
-
-        // Get the halfway point on the right edge
-        vec_t half_edge = {
-            0.5 * (nodes_x[(node_index)] + nodes_x[(rnode_index)]),
-            0.5 * (nodes_y[(node_index)] + nodes_y[(rnode_index)]),
-            0.5 * (nodes_z[(node_index)] + nodes_z[(rnode_index)])};
 
-        // Setup basis on plane of tetrahedron
-        vec_t a = {(nodes_x[(node_index)] - half_edge.x),
-                   (nodes_y[(node_index)] - half_edge.y),
-                   (nodes_z[(node_index)] - half_edge.z)};
-        vec_t b = {(face_c.x - half_edge.x), (face_c.y - half_edge.y),
-                   (face_c.z - half_edge.z)};
+        const int edge_index = face_to_nodes_off + nn2;
+        const vec_t A = {face_edge_area_x[(edge_index)],
+                         face_edge_area_y[(edge_index)],
+                         face_edge_area_z[(edge_index)]};
 
-        // Calculate the area vector A using cross product
-        vec_t A = {0.5 * (a.y * b.z - a.z * b.y),
-                   -0.5 * (a.x * b.z - a.z * b.x),
-                   0.5 * (a.x * b.y - a.y * b.x)};
-
-        int subcell_index;
-        int rsubcell_index;
-        for (int nn3 = 0; nn3 < nnodes_by_cell; ++nn3) {
-          if (cells_to_nodes[(cell_to_nodes_off + nn3)] == node_index) {
-            subcell_index = cell_to_nodes_off + nn3;
-          } else if (cells_to_nodes[(cell_to_nodes_off + nn3)] == rnode_index) {
-            rsubcell_index = cell_to_nodes_off + nn3;
+        for (int cc = 0; cc < 2; ++cc) {
+          const int cell_index = cells[(cc)];
+          if (cell_index == -1) {
+            continue;
           }
-        }
 
-        subcell_force_x[(subcell_index)] += pressure[(cc)] * A.x;
-        subcell_force_y[(subcell_index)] += pressure[(cc)] * A.y;
-        subcell_force_z[(subcell_index)] += pressure[(cc)] * A.z;
-        subcell_force_x[(rsubcell_index)] += pressure[(cc)] * A.x;
-        subcell_force_y[(rsubcell_index)] += pressure[(cc)] * A.y;
-        subcell_force_z[(rsubcell_index)] += pressure[(cc)] * A.z;
+          // The area vector is reversed for the clockwise cell
+          const double face_pressure =
+              (faces_cclockwise_cell[(face_index)] != cell_index)
+                  ? -pressure[(cell_index)]
+                  : pressure[(cell_index)];
+
+          const int subcell_index = face_nodes_to_subcells[cc][(nn2)];
+          const int rsubcell_index = face_nodes_to_subcells[cc][(next_node)];
+
+          subcell_force_x[(subcell_index)] += face_pressure * A.x;
+          subcell_force_y[(subcell_index)] += face_pressure * A.y;
+          subcell_force_z[(subcell_index)] += face_pressure * A.z;
+          subcell_force_x[(rsubcell_index)] += face_pressure * A.x;
+          subcell_force_y[(rsubcell_index)] += face_pressure * A.y;
+          subcell_force_z[(rsubcell_index)] += face_pressure * A.z;
+        }
       }
     }
   }
 }
 
-// Scale the soundspeed by the inverse of the nodal volume
-void scale_soundspeed(const int nnodes, const double* nodal_volumes,
-                      double* nodal_soundspeed) {
+// Calculates the subcell forces from the pressure, with the face centric,
+// hexahedral or general cell centric kernel
+void calc_pressure_forces(UnstructuredMesh* umesh, HaleData* hale_data,
+                          const double* pressure) {
+
+  if (hale_data->face_centric_forces) {
+    calc_subcell_force_from_pressure_by_face(
+        hale_data->nface_colours, hale_data->face_colour_offsets,
+        hale_data->faces_by_colour, umesh->faces_to_cells0,
+        umesh->faces_to_cells1, umesh->faces_to_nodes_offsets,
+        hale_data->faces_nodes_to_subcells0,
+        hale_data->faces_nodes_to_subcells1, umesh->faces_cclockwise_cell,
+        hale_data->face_edge_area_x, hale_data->face_edge_area_y,
+        hale_data->face_edge_area_z, pressure, hale_data->subcell_force_x,
+        hale_data->subcell_force_y, hale_data->subcell_force_z);
+  } else if (hale_data->hex_mesh) {
+    calc_subcell_force_from_pressure_hex(
+        hale_data->nfrontier_cells, hale_data->frontier_cells,
+        umesh->cells_to_faces, umesh->faces_to_cells0,
+        hale_data->faces_nodes_to_subcells0,
+        hale_data->faces_nodes_to_subcells1, umesh->faces_cclockwise_cell,
+        hale_data->face_edge_area_x, hale_data->face_edge_area_y,
+        hale_data->face_edge_area_z, pressure, hale_data->subcell_force_x,
+        hale_data->subcell_force_y, hale_data->subcell_force_z);
+  } else {
+    calc_subcell_force_from_pressure(
+        hale_data->nfrontier_cells, hale_data->frontier_cells,
+        umesh->cells_to_faces_offsets, umesh->cells_to_faces,
+        umesh->faces_to_nodes_offsets, umesh->faces_to_cells0,
+        hale_data->faces_nodes_to_subcells0,
+        hale_data->faces_nodes_to_subcells1, umesh->faces_cclockwise_cell,
+        hale_data->face_edge_area_x, hale_data->face_edge_area_y,
+        hale_data->face_edge_area_z, pressure, hale_data->subcell_force_x,
+        hale_data->subcell_force_y, hale_data->subcell_force_z);
+  }
+}
+
+// Calculates the pressure with the equation of state and sets the subcell
+// forces from it, without a separate pass to zero the forces
+void calc_eos_and_subcell_force(
+    const int ncells, const int* cell_list, const int* cells_to_faces_offsets,
+    const int* cells_to_nodes_offsets, const int* cells_to_faces,
+    const int* faces_to_nodes_offsets, const int* faces_to_cells0,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const int* faces_cclockwise_cell, const double* face_edge_area_x,
+    const double* face_edge_area_y, const double* face_edge_area_z,
+    const double* energy, const double* density, double* pressure,
+    double* subcell_force_x, double* subcell_force_y, double* subcell_force_z) {
 
 #pragma omp parallel for
-  for (int nn = 0; nn < nnodes; ++nn) {
-    nodal_soundspeed[(nn)] /= nodal_volumes[(nn)];
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
+    const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
+    const int nfaces_by_cell =
+        cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
+    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+    const int nnodes_by_cell =
+        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
+
+    const double cell_pressure = (GAM - 1.0) * energy[(cc)] * density[(cc)];
+    pressure[(cc)] = cell_pressure;
+
+    // The cell owns its subcells, so they can be reset here
+    for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+      subcell_force_x[(cell_to_nodes_off + nn)] = 0.0;
+      subcell_force_y[(cell_to_nodes_off + nn)] = 0.0;
+      subcell_force_z[(cell_to_nodes_off + nn)] = 0.0;
+    }
+
+    for (int ff = 0; ff < nfaces_by_cell; ++ff) {
+      const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
+      const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
+      const int nnodes_by_face =
+          faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
+
+      add_face_pressure_forces(
+          cc, face_index, nnodes_by_face, face_to_nodes_off, 0, cell_pressure,
+          faces_to_cells0, faces_nodes_to_subcells0, faces_nodes_to_subcells1,
+          faces_cclockwise_cell, face_edge_area_x, face_edge_area_y,
+          face_edge_area_z, subcell_force_x, subcell_force_y, subcell_force_z);
+    }
+  }
+}
+
+// Calculates the pressure with the equation of state and sets the subcell
+// forces from it on a hexahedral mesh
+void calc_eos_and_subcell_force_hex(
+    const int ncells, const int* cell_list, const int* cells_to_faces,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const int* faces_cclockwise_cell,
+    const double* face_edge_area_x, const double* face_edge_area_y,
+    const double* face_edge_area_z, const double* energy, const double* density,
+    double* pressure, double* subcell_force_x, double* subcell_force_y,
+    double* subcell_force_z) {
+
+#pragma omp parallel for
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
+    const int cell_to_faces_off = cc * NFACES_BY_HEX_CELL;
+    const int cell_to_nodes_off = cc * NNODES_BY_HEX_CELL;
+
+    const double cell_pressure = (GAM - 1.0) * energy[(cc)] * density[(cc)];
+    pressure[(cc)] = cell_pressure;
+
+    // Accumulate the forces for the cell's subcells locally
+    double cell_force_x[NNODES_BY_HEX_CELL] = {0.0};
+    double cell_force_y[NNODES_BY_HEX_CELL] = {0.0};
+    double cell_force_z[NNODES_BY_HEX_CELL] = {0.0};
+
+    for (int ff = 0; ff < NFACES_BY_HEX_CELL; ++ff) {
+      const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
+      add_face_pressure_forces(
+          cc, face_index, NNODES_BY_HEX_FACE, face_index * NNODES_BY_HEX_FACE,
+          cell_to_nodes_off, cell_pressure, faces_to_cells0,
+          faces_nodes_to_subcells0, faces_nodes_to_subcells1,
+          faces_cclockwise_cell, face_edge_area_x, face_edge_area_y,
+          face_edge_area_z, cell_force_x, cell_force_y, cell_force_z);
+    }
+
+    for (int nn = 0; nn < NNODES_BY_HEX_CELL; ++nn) {
+      subcell_force_x[(cell_to_nodes_off + nn)] = cell_force_x[(nn)];
+      subcell_force_y[(cell_to_nodes_off + nn)] = cell_force_y[(nn)];
+      subcell_force_z[(cell_to_nodes_off + nn)] = cell_force_z[(nn)];
+    }
+  }
+}
+
+// Calculates the pressure and the subcell forces from it in a single cell
+// pass, with the hexahedral or general kernel
+void calc_eos_and_pressure_forces(UnstructuredMesh* umesh,
+                                  HaleData* hale_data) {
+
+  if (hale_data->hex_mesh) {
+    calc_eos_and_subcell_force_hex(
+        hale_data->nfrontier_cells, hale_data->frontier_cells,
+        umesh->cells_to_faces, umesh->faces_to_cells0,
+        hale_data->faces_nodes_to_subcells0,
+        hale_data->faces_nodes_to_subcells1, umesh->faces_cclockwise_cell,
+        hale_data->face_edge_area_x, hale_data->face_edge_area_y,
+        hale_data->face_edge_area_z, hale_data->energy0, hale_data->density0,
+        hale_data->pressure0, hale_data->subcell_force_x,
+        hale_data->subcell_force_y, hale_data->subcell_force_z);
+  } else {
+    calc_eos_and_subcell_force(
+        hale_data->nfrontier_cells, hale_data->frontier_cells,
+        umesh->cells_to_faces_offsets, umesh->cells_to_nodes_offsets,
+        umesh->cells_to_faces, umesh->faces_to_nodes_offsets,
+        umesh->faces_to_cells0, hale_data->faces_nodes_to_subcells0,
+        hale_data->faces_nodes_to_subcells1, umesh->faces_cclockwise_cell,
+        hale_data->face_edge_area_x, hale_data->face_edge_area_y,
+        hale_data->face_edge_area_z, hale_data->energy0, hale_data->density0,
+        hale_data->pressure0, hale_data->subcell_force_x,
+        hale_data->subcell_force_y, hale_data->subcell_force_z);
   }
 }
 
 // Calculate the time centered evolved velocities, by calculating the predicted
 // values at the new timestep and averaging with current velocity
-void calc_new_velocity(const int nnodes, const double dt,
+void calc_new_velocity(const int nnodes, const int* node_list, const double dt,
                        const int* nodes_to_cells_offsets,
-                       const int* nodes_to_cells,
-                       const int* cells_to_nodes_offsets,
-                       const int* cells_to_nodes, const double* subcell_force_x,
+                       const int* nodes_to_subcells,
+                       const double* subcell_force_x,
                        const double* subcell_force_y,
                        const double* subcell_force_z, const double* nodal_mass,
                        const double* velocity_x0, const double* velocity_y0,
@@ -500,7 +670,8 @@ void calc_new_velocity(const int nnodes, const double dt,
                        double* velocity_y1, double* velocity_z1) {
 
 #pragma omp parallel for simd
-  for (int nn = 0; nn < nnodes; ++nn) {
+  for (int ii = 0; ii < nnodes; ++ii) {
+    const int nn = (node_list ? node_list[(ii)] : ii);
     const int node_to_cells_off = nodes_to_cells_offsets[(nn)];
     const int ncells_by_node =
         nodes_to_cells_offsets[(nn + 1)] - node_to_cells_off;
@@ -508,20 +679,7 @@ void calc_new_velocity(const int nnodes, const double dt,
     // Accumulate the force at this node
     vec_t node_force = {0.0, 0.0, 0.0};
     for (int cc = 0; cc < ncells_by_node; ++cc) {
-      const int cell_index = nodes_to_cells[(node_to_cells_off + cc)];
-      const int cell_to_nodes_off = cells_to_nodes_offsets[(cell_index)];
-      const int nnodes_by_cell =
-          cells_to_nodes_offsets[(cell_index + 1)] - cell_to_nodes_off;
-
-      // ARRGHHHH
-      int nn2;
-      for (nn2 = 0; nn2 < nnodes_by_cell; ++nn2) {
-        if (cells_to_nodes[(cell_to_nodes_off + nn2)] == nn) {
-          break;
-        }
-      }
-
-      const int subcell_index = cell_to_nodes_off + nn2;
+      const int subcell_index = nodes_to_subcells[(node_to_cells_off + cc)];
       node_force.x += subcell_force_x[(subcell_index)];
       node_force.y += subcell_force_y[(subcell_index)];
       node_force.z += subcell_force_z[(subcell_index)];
@@ -543,14 +701,15 @@ void calc_new_velocity(const int nnodes, const double dt,
 }
 
 // Moves the nodes to the next time level
-void move_nodes(const int nnodes, const double dt, const double* nodes_x0,
-                const double* nodes_y0, const double* nodes_z0,
-                const double* velocity_x1, const double* velocity_y1,
-                const double* velocity_z1, double* nodes_x1, double* nodes_y1,
-                double* nodes_z1) {
+void move_nodes(const int nnodes, const int* node_list, const double dt,
+                const double* nodes_x0, const double* nodes_y0,
+                const double* nodes_z0, const double* velocity_x1,
+                const double* velocity_y1, const double* velocity_z1,
+                double* nodes_x1, double* nodes_y1, double* nodes_z1) {
 
 #pragma omp parallel for simd
-  for (int nn = 0; nn < nnodes; ++nn) {
+  for (int ii = 0; ii < nnodes; ++ii) {
+    const int nn = (node_list ? node_list[(ii)] : ii);
     nodes_x1[(nn)] = nodes_x0[(nn)] + dt * velocity_x1[(nn)];
     nodes_y1[(nn)] = nodes_y0[(nn)] + dt * velocity_y1[(nn)];
     nodes_z1[(nn)] = nodes_z0[(nn)] + dt * velocity_z1[(nn)];
@@ -558,37 +717,32 @@ void move_nodes(const int nnodes, const double dt, const double* nodes_x0,
 }
 
 // calculates a new density from the pressure gradients
-void calc_predicted_density(const int ncells, const int* cells_to_faces_offsets,
-                            const int* cells_to_faces,
-                            const int* faces_to_nodes_offsets,
-                            const int* faces_to_nodes, const double* nodes_x1,
-                            const double* nodes_y1, const double* nodes_z1,
-                            const double* cell_centroids_x,
-                            const double* cell_centroids_y,
-                            const double* cell_centroids_z,
+void calc_predicted_density(const int ncells, const int* cell_list,
+                            const int* cells_to_nodes_offsets,
+                            const double* subcell_volume,
                             const double* cell_mass, double* density1) {
 
 #pragma omp parallel for
-  for (int cc = 0; cc < ncells; ++cc) {
-    const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
-    const int nfaces_by_cell =
-        cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
+    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+    const int nnodes_by_cell =
+        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
 
-    const double cell_volume = calc_cell_volume(
-        cc, nfaces_by_cell, cell_to_faces_off, cells_to_faces,
-        faces_to_nodes_offsets, faces_to_nodes, nodes_x1, nodes_y1, nodes_z1,
-        cell_centroids_x, cell_centroids_y, cell_centroids_z);
+    const double cell_volume =
+        calc_cell_volume(cell_to_nodes_off, nnodes_by_cell, subcell_volume);
 
     density1[(cc)] = cell_mass[(cc)] / cell_volume;
   }
 }
 
 // Time centers the pressure
-void time_center_pressure(const int ncells, const double* energy1,
-                          const double* density1, const double* pressure0,
-                          double* pressure1) {
+void time_center_pressure(const int ncells, const int* cell_list,
+                          const double* energy1, const double* density1,
+                          const double* pressure0, double* pressure1) {
 #pragma omp parallel for
-  for (int cc = 0; cc < ncells; ++cc) {
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
     // Calculate the predicted pressure from the equation of state
     pressure1[(cc)] = (GAM - 1.0) * energy1[(cc)] * density1[(cc)];
 
@@ -598,12 +752,14 @@ void time_center_pressure(const int ncells, const double* energy1,
 }
 
 // Time centers the nodal positions
-void time_center_nodes(const int nnodes, const double* nodes_x0,
-                       const double* nodes_y0, const double* nodes_z0,
-                       double* nodes_x1, double* nodes_y1, double* nodes_z1) {
+void time_center_nodes(const int nnodes, const int* node_list,
+                       const double* nodes_x0, const double* nodes_y0,
+                       const double* nodes_z0, double* nodes_x1,
+                       double* nodes_y1, double* nodes_z1) {
 
 #pragma omp parallel for
-  for (int nn = 0; nn < nnodes; ++nn) {
+  for (int ii = 0; ii < nnodes; ++ii) {
+    const int nn = (node_list ? node_list[(ii)] : ii);
     nodes_x1[(nn)] = 0.5 * (nodes_x1[(nn)] + nodes_x0[(nn)]);
     nodes_y1[(nn)] = 0.5 * (nodes_y1[(nn)] + nodes_y0[(nn)]);
     nodes_z1[(nn)] = 0.5 * (nodes_z1[(nn)] + nodes_z0[(nn)]);
@@ -612,16 +768,16 @@ void time_center_nodes(const int nnodes, const double* nodes_x0,
 
 // Updates and time center velocity in the corrector step
 void update_and_time_center_velocity(
-    const int nnodes, const double dt, const int* nodes_to_cells_offsets,
-    const int* nodes_to_cells, const int* cells_to_nodes_offsets,
-    const int* cells_to_nodes, const double* nodal_mass,
-    const double* subcell_force_x, const double* subcell_force_y,
-    const double* subcell_force_z, double* velocity_x0, double* velocity_y0,
-    double* velocity_z0, double* velocity_x1, double* velocity_y1,
-    double* velocity_z1) {
+    const int nnodes, const int* node_list, const double dt,
+    const int* nodes_to_cells_offsets, const int* nodes_to_subcells,
+    const double* nodal_mass, const double* subcell_force_x,
+    const double* subcell_force_y, const double* subcell_force_z,
+    double* velocity_x0, double* velocity_y0, double* velocity_z0,
+    double* velocity_x1, double* velocity_y1, double* velocity_z1) {
 
 #pragma omp parallel for simd
-  for (int nn = 0; nn < nnodes; ++nn) {
+  for (int ii = 0; ii < nnodes; ++ii) {
+    const int nn = (node_list ? node_list[(ii)] : ii);
     const int node_to_cells_off = nodes_to_cells_offsets[(nn)];
     const int ncells_by_node =
         nodes_to_cells_offsets[(nn + 1)] - node_to_cells_off;
@@ -629,21 +785,10 @@ void update_and_time_center_velocity(
     // Consider all faces attached to node
     vec_t node_force = {0.0, 0.0, 0.0};
     for (int cc = 0; cc < ncells_by_node; ++cc) {
-      const int cell_index = nodes_to_cells[(node_to_cells_off + cc)];
-      const int cell_to_nodes_off = cells_to_nodes_offsets[(cell_index)];
-      const int nnodes_by_cell =
-          cells_to_nodes_offsets[(cell_index + 1)] - cell_to_nodes_off;
-
-      int nn2;
-      for (nn2 = 0; nn2 < nnodes_by_cell; ++nn2) {
-        if (cells_to_nodes[(cell_to_nodes_off + nn2)] == nn) {
-          break;
-        }
-      }
-
-      node_force.x += subcell_force_x[(cell_to_nodes_off + nn2)];
-      node_force.y += subcell_force_y[(cell_to_nodes_off + nn2)];
-      node_force.z += subcell_force_z[(cell_to_nodes_off + nn2)];
+      const int subcell_index = nodes_to_subcells[(node_to_cells_off + cc)];
+      node_force.x += subcell_force_x[(subcell_index)];
+      node_force.y += subcell_force_y[(subcell_index)];
+      node_force.z += subcell_force_z[(subcell_index)];
     }
 
     // TODO: Do we actually need to update the velocities back here??
@@ -660,14 +805,15 @@ void update_and_time_center_velocity(
 }
 
 // Advances the nodes using the corrected velocity
-void advance_nodes_corrected(const int nnodes, const double dt,
-                             const double* velocity_x0,
+void advance_nodes_corrected(const int nnodes, const int* node_list,
+                             const double dt, const double* velocity_x0,
                              const double* velocity_y0,
                              const double* velocity_z0, double* nodes_x0,
                              double* nodes_y0, double* nodes_z0) {
 
 #pragma omp parallel for
-  for (int nn = 0; nn < nnodes; ++nn) {
+  for (int ii = 0; ii < nnodes; ++ii) {
+    const int nn = (node_list ? node_list[(ii)] : ii);
     nodes_x0[(nn)] += dt * velocity_x0[(nn)];
     nodes_y0[(nn)] += dt * velocity_y0[(nn)];
     nodes_z0[(nn)] += dt * velocity_z0[(nn)];
@@ -675,8 +821,8 @@ void advance_nodes_corrected(const int nnodes, const double dt,
 }
 
 // Calculate the new energy base on subcell forces
-void calc_predicted_energy(const int ncells, const double dt,
-                           const int* cells_to_nodes_offsets,
+void calc_predicted_energy(const int ncells, const int* cell_list,
+                           const double dt, const int* cells_to_nodes_offsets,
                            const int* cells_to_nodes, const double* velocity_x1,
                            const double* velocity_y1, const double* velocity_z1,
                            const double* subcell_force_x,
@@ -685,7 +831,8 @@ void calc_predicted_energy(const int ncells, const double dt,
                            const double* cell_mass, double* energy1) {
 
 #pragma omp parallel for
-  for (int cc = 0; cc < ncells; ++cc) {
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
     const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
     const int nnodes_by_cell =
         cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
@@ -704,8 +851,8 @@ void calc_predicted_energy(const int ncells, const double dt,
 }
 
 // Calculates the energy from the correct subcell pressures and velocity
-void calc_corrected_energy(const int ncells, const double dt,
-                           const int* cells_to_nodes_offsets,
+void calc_corrected_energy(const int ncells, const int* cell_list,
+                           const double dt, const int* cells_to_nodes_offsets,
                            const int* cells_to_nodes, const double* velocity_x0,
                            const double* velocity_y0, const double* velocity_z0,
                            const double* subcell_force_x,
@@ -714,7 +861,8 @@ void calc_corrected_energy(const int ncells, const double dt,
                            const double* cell_mass, double* energy0) {
 
 #pragma omp parallel for
-  for (int cc = 0; cc < ncells; ++cc) {
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
     const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
     const int nnodes_by_cell =
         cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
@@ -733,42 +881,268 @@ void calc_corrected_energy(const int ncells, const double dt,
   }
 }
 
-// Calculates the density from the corrected volume
-void calc_corrected_density(
-    const int ncells, const int* cells_to_faces_offsets,
-    const int* cells_to_faces, const int* faces_to_nodes_offsets,
-    const int* faces_to_nodes, const double* nodes_x, const double* nodes_y,
-    const double* nodes_z, const double* cell_centroids_x,
-    const double* cell_centroids_y, const double* cell_centroids_z,
-    const double* cell_mass, double* cell_volume, double* density) {
+// Calculates the density from the corrected volume, returning the shortest
+// time for a cell to change by its own volume at the rate of this timestep
+time_limit_t calc_corrected_density(const int ncells, const int* cell_list,
+                                    const double dt,
+                                    const int* cells_to_nodes_offsets,
+                                    const double* subcell_volume,
+                                    const double* cell_mass,
+                                    double* cell_volume, double* density) {
+
+  time_limit_t volume_limit = {DBL_MAX, -1};
+#pragma omp parallel
+  {
+    time_limit_t thread_limit = {DBL_MAX, -1};
+
+#pragma omp for nowait
+    for (int ii = 0; ii < ncells; ++ii) {
+      const int cc = (cell_list ? cell_list[(ii)] : ii);
+      const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+      const int nnodes_by_cell =
+          cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
 
-#pragma omp parallel for
-  for (int cc = 0; cc < ncells; ++cc) {
-    const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
-    const int nfaces_by_cell =
-        cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
+      const double cell_vol =
+          calc_cell_volume(cell_to_nodes_off, nnodes_by_cell, subcell_volume);
+      min_time_limit(&thread_limit,
+                     calc_volume_time(dt, cell_volume[(cc)], cell_vol), cc);
 
-    cell_volume[(cc)] = calc_cell_volume(
-        cc, nfaces_by_cell, cell_to_faces_off, cells_to_faces,
-        faces_to_nodes_offsets, faces_to_nodes, nodes_x, nodes_y, nodes_z,
-        cell_centroids_x, cell_centroids_y, cell_centroids_z);
+      // Update the density using the new volume
+      cell_volume[(cc)] = cell_vol;
+      density[(cc)] = cell_mass[(cc)] / cell_vol;
+    }
 
-    // Update the density using the new volume
-    density[(cc)] = cell_mass[(cc)] / cell_volume[(cc)];
+#pragma omp critical
+    min_time_limit(&volume_limit, thread_limit.time, thread_limit.cell);
   }
+
+  return volume_limit;
 }
 
-// Calculates the volume in a cell by tetrahedral decomposition
-double calc_cell_volume(const int cc, const int nfaces_by_cell,
-                        const int cell_to_faces_off, const int* cells_to_faces,
-                        const int* faces_to_nodes_offsets,
-                        const int* faces_to_nodes, const double* nodes_x,
-                        const double* nodes_y, const double* nodes_z,
-                        const double* cell_centroids_x,
-                        const double* cell_centroids_y,
-                        const double* cell_centroids_z) {
+// Calculates the corrected cell centroids, subcell geometry, volumes,
+// densities and energies in a single cell pass, returning the shortest volume
+// change time
+time_limit_t calc_corrected_cell_state(
+    const int ncells, const int* cell_list, const double dt,
+    const int* cells_to_nodes_offsets, const int* cells_to_nodes,
+    const int* cells_to_faces_offsets, const int* cells_to_faces,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const double* nodes_x,
+    const double* nodes_y, const double* nodes_z, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    const double* subcell_force_x, const double* subcell_force_y,
+    const double* subcell_force_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    const double* cell_mass, double* cell_centroids_x, double* cell_centroids_y,
+    double* cell_centroids_z, double* subcell_volume,
+    double* subcell_centroids_x, double* subcell_centroids_y,
+    double* subcell_centroids_z, double* cell_volume, double* density,
+    double* energy0) {
+
+  time_limit_t volume_limit = {DBL_MAX, -1};
+#pragma omp parallel
+  {
+    time_limit_t thread_limit = {DBL_MAX, -1};
+
+#pragma omp for nowait
+    for (int ii = 0; ii < ncells; ++ii) {
+      const int cc = (cell_list ? cell_list[(ii)] : ii);
+      const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+      const int nnodes_by_cell =
+          cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
+      const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
+      const int nfaces_by_cell =
+          cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
+
+      vec_t cell_c = {0.0, 0.0, 0.0};
+      calc_centroid(nnodes_by_cell, nodes_x, nodes_y, nodes_z, cells_to_nodes,
+                    cell_to_nodes_off, &cell_c);
+      cell_centroids_x[(cc)] = cell_c.x;
+      cell_centroids_y[(cc)] = cell_c.y;
+      cell_centroids_z[(cc)] = cell_c.z;
+
+      // Update the density using the new volume
+      const double cell_vol = calc_cell_subcell_geometry(
+          cc, cell_to_nodes_off, nnodes_by_cell, cell_to_faces_off,
+          nfaces_by_cell, cells_to_faces, faces_to_nodes_offsets,
+          faces_to_nodes, faces_to_cells0, faces_nodes_to_subcells0,
+          faces_nodes_to_subcells1, nodes_x, nodes_y, nodes_z, cell_c,
+          face_centroids_x, face_centroids_y, face_centroids_z, subcell_volume,
+          subcell_centroids_x, subcell_centroids_y, subcell_centroids_z);
+      min_time_limit(&thread_limit,
+                     calc_volume_time(dt, cell_volume[(cc)], cell_vol), cc);
+      cell_volume[(cc)] = cell_vol;
+      density[(cc)] = cell_mass[(cc)] / cell_vol;
+
+      // Update the energy with the work done by the subcell forces
+      double cell_force = 0.0;
+      for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+        const int node_index = cells_to_nodes[(cell_to_nodes_off + nn)];
+        const int subcell_index = cell_to_nodes_off + nn;
+        cell_force +=
+            (velocity_x[(node_index)] * subcell_force_x[(subcell_index)] +
+             velocity_y[(node_index)] * subcell_force_y[(subcell_index)] +
+             velocity_z[(node_index)] * subcell_force_z[(subcell_index)]);
+      }
+      energy0[(cc)] -= dt * cell_force / cell_mass[(cc)];
+    }
+
+#pragma omp critical
+    min_time_limit(&volume_limit, thread_limit.time, thread_limit.cell);
+  }
+
+  return volume_limit;
+}
+
+// Calculates the corrected cell state in a single pass on a hexahedral mesh,
+// with the fixed numbers of nodes and faces by cell
+time_limit_t calc_corrected_cell_state_hex(
+    const int ncells, const int* cell_list, const double dt,
+    const int* cells_to_nodes, const int* cells_to_faces,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const double* nodes_x,
+    const double* nodes_y, const double* nodes_z, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    const double* subcell_force_x, const double* subcell_force_y,
+    const double* subcell_force_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    const double* cell_mass, double* cell_centroids_x, double* cell_centroids_y,
+    double* cell_centroids_z, double* subcell_volume,
+    double* subcell_centroids_x, double* subcell_centroids_y,
+    double* subcell_centroids_z, double* cell_volume, double* density,
+    double* energy0) {
+
+  time_limit_t volume_limit = {DBL_MAX, -1};
+#pragma omp parallel
+  {
+    time_limit_t thread_limit = {DBL_MAX, -1};
+
+#pragma omp for nowait
+    for (int ii = 0; ii < ncells; ++ii) {
+      const int cc = (cell_list ? cell_list[(ii)] : ii);
+      const int cell_to_nodes_off = cc * NNODES_BY_HEX_CELL;
+      const int cell_to_faces_off = cc * NFACES_BY_HEX_CELL;
+
+      // Determine the centroid, and the work done by the subcell forces
+      vec_t cell_c = {0.0, 0.0, 0.0};
+      double cell_force = 0.0;
+      for (int nn = 0; nn < NNODES_BY_HEX_CELL; ++nn) {
+        const int node_index = cells_to_nodes[(cell_to_nodes_off + nn)];
+        const int subcell_index = cell_to_nodes_off + nn;
+        cell_c.x += nodes_x[(node_index)] / NNODES_BY_HEX_CELL;
+        cell_c.y += nodes_y[(node_index)] / NNODES_BY_HEX_CELL;
+        cell_c.z += nodes_z[(node_index)] / NNODES_BY_HEX_CELL;
+        cell_force +=
+            (velocity_x[(node_index)] * subcell_force_x[(subcell_index)] +
+             velocity_y[(node_index)] * subcell_force_y[(subcell_index)] +
+             velocity_z[(node_index)] * subcell_force_z[(subcell_index)]);
+      }
+      cell_centroids_x[(cc)] = cell_c.x;
+      cell_centroids_y[(cc)] = cell_c.y;
+      cell_centroids_z[(cc)] = cell_c.z;
+      energy0[(cc)] -= dt * cell_force / cell_mass[(cc)];
+
+      const double cell_vol = calc_cell_subcell_geometry(
+          cc, cell_to_nodes_off, NNODES_BY_HEX_CELL, cell_to_faces_off,
+          NFACES_BY_HEX_CELL, cells_to_faces, faces_to_nodes_offsets,
+          faces_to_nodes, faces_to_cells0, faces_nodes_to_subcells0,
+          faces_nodes_to_subcells1, nodes_x, nodes_y, nodes_z, cell_c,
+          face_centroids_x, face_centroids_y, face_centroids_z, subcell_volume,
+          subcell_centroids_x, subcell_centroids_y, subcell_centroids_z);
+
+      // Update the density using the new volume
+      min_time_limit(&thread_limit,
+                     calc_volume_time(dt, cell_volume[(cc)], cell_vol), cc);
+      cell_volume[(cc)] = cell_vol;
+      density[(cc)] = cell_mass[(cc)] / cell_vol;
+    }
+
+#pragma omp critical
+    min_time_limit(&volume_limit, thread_limit.time, thread_limit.cell);
+  }
+
+  return volume_limit;
+}
+
+// Updates the corrected cell state in a single cell pass, with the hexahedral
+// or general kernel, returning the shortest volume change time
+time_limit_t update_corrected_cells(UnstructuredMesh* umesh,
+                                    HaleData* hale_data, const double dt) {
+
+  if (hale_data->hex_mesh) {
+    return calc_corrected_cell_state_hex(
+        hale_data->nfrontier_cells, hale_data->frontier_cells, dt,
+        umesh->cells_to_nodes, umesh->cells_to_faces,
+        umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+        umesh->faces_to_cells0, hale_data->faces_nodes_to_subcells0,
+        hale_data->faces_nodes_to_subcells1, umesh->nodes_x0, umesh->nodes_y0,
+        umesh->nodes_z0, hale_data->velocity_x0, hale_data->velocity_y0,
+        hale_data->velocity_z0, hale_data->subcell_force_x,
+        hale_data->subcell_force_y, hale_data->subcell_force_z,
+        hale_data->face_centroids_x, hale_data->face_centroids_y,
+        hale_data->face_centroids_z, hale_data->cell_mass,
+        umesh->cell_centroids_x, umesh->cell_centroids_y,
+        umesh->cell_centroids_z, hale_data->subcell_volume,
+        hale_data->subcell_centroids_x, hale_data->subcell_centroids_y,
+        hale_data->subcell_centroids_z, hale_data->cell_volume,
+        hale_data->density0, hale_data->energy0);
+  }
+
+  return calc_corrected_cell_state(
+      hale_data->nfrontier_cells, hale_data->frontier_cells, dt,
+      umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
+      umesh->cells_to_faces_offsets, umesh->cells_to_faces,
+      umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+      umesh->faces_to_cells0, hale_data->faces_nodes_to_subcells0,
+      hale_data->faces_nodes_to_subcells1, umesh->nodes_x0, umesh->nodes_y0,
+      umesh->nodes_z0, hale_data->velocity_x0, hale_data->velocity_y0,
+      hale_data->velocity_z0, hale_data->subcell_force_x,
+      hale_data->subcell_force_y, hale_data->subcell_force_z,
+      hale_data->face_centroids_x, hale_data->face_centroids_y,
+      hale_data->face_centroids_z, hale_data->cell_mass,
+      umesh->cell_centroids_x, umesh->cell_centroids_y, umesh->cell_centroids_z,
+      hale_data->subcell_volume, hale_data->subcell_centroids_x,
+      hale_data->subcell_centroids_y, hale_data->subcell_centroids_z,
+      hale_data->cell_volume, hale_data->density0, hale_data->energy0);
+}
+
+// Calculates the volume of a cell as the sum of its subcell volumes
+double calc_cell_volume(const int cell_to_nodes_off, const int nnodes_by_cell,
+                        const double* subcell_volume) {
 
   double cell_vol = 0.0;
+  for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+    cell_vol += subcell_volume[(cell_to_nodes_off + nn)];
+  }
+
+  return cell_vol;
+}
+
+// Calculates the volumes and centroids of the subcells of a cell, returning
+// the cell volume. The tetrahedron between each face edge, the face centroid
+// and the cell centroid is split at the edge midpoint between the subcells of
+// the edge's two nodes
+double calc_cell_subcell_geometry(
+    const int cc, const int cell_to_nodes_off, const int nnodes_by_cell,
+    const int cell_to_faces_off, const int nfaces_by_cell,
+    const int* cells_to_faces, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const double* nodes_x, const double* nodes_y, const double* nodes_z,
+    const vec_t cell_c, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    double* subcell_volume, double* subcell_centroids_x,
+    double* subcell_centroids_y, double* subcell_centroids_z) {
+
+  for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+    const int subcell_index = cell_to_nodes_off + nn;
+    subcell_volume[(subcell_index)] = 0.0;
+    subcell_centroids_x[(subcell_index)] = 0.0;
+    subcell_centroids_y[(subcell_index)] = 0.0;
+    subcell_centroids_z[(subcell_index)] = 0.0;
+  }
 
   // Look at all of the faces attached to the cell
   for (int ff = 0; ff < nfaces_by_cell; ++ff) {
@@ -777,110 +1151,632 @@ double calc_cell_volume(const int cc, const int nfaces_by_cell,
     const int nnodes_by_face =
         faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
 
-    vec_t face_c = {0.0, 0.0, 0.0};
-    calc_centroid(nnodes_by_face, nodes_x, nodes_y, nodes_z, faces_to_nodes,
-                  face_to_nodes_off, &face_c);
+    const vec_t face_c = {face_centroids_x[(face_index)],
+                          face_centroids_y[(face_index)],
+                          face_centroids_z[(face_index)]};
+
+    // The subcells of the face nodes in this cell
+    const int* face_nodes_to_subcells =
+        ((faces_to_cells0[(face_index)] == cc) ? faces_nodes_to_subcells0
+                                               : faces_nodes_to_subcells1) +
+        face_to_nodes_off;
 
-    // Now we will sum the contributions at each of the nodes
     for (int nn2 = 0; nn2 < nnodes_by_face; ++nn2) {
-      // Fetch the nodes attached to our current node on the current face
+      const int next_node = (nn2 == nnodes_by_face - 1) ? 0 : nn2 + 1;
       const int node_index = faces_to_nodes[(face_to_nodes_off + nn2)];
-      const int rnode_index =
-          (nn2 + 1 < nnodes_by_face)
-              ? faces_to_nodes[(face_to_nodes_off + nn2 + 1)]
-              : faces_to_nodes[(face_to_nodes_off)];
-
-      cell_vol += 2.0 * calc_subsubcell_volume(
-                            cc, rnode_index, node_index, face_c, nodes_x,
-                            nodes_y, nodes_z, cell_centroids_x,
-                            cell_centroids_y, cell_centroids_z);
+      const int rnode_index = faces_to_nodes[(face_to_nodes_off + next_node)];
+      const int subcell_index = face_nodes_to_subcells[(nn2)];
+      const int rsubcell_index = face_nodes_to_subcells[(next_node)];
+
+      // Construct the vectors describing an edge tetrahedron
+      const vec_t ad = {(face_c.x - nodes_x[(node_index)]),
+                        (face_c.y - nodes_y[(node_index)]),
+                        (face_c.z - nodes_z[(node_index)])};
+      const vec_t bd = {nodes_x[(rnode_index)] - nodes_x[(node_index)],
+                        nodes_y[(rnode_index)] - nodes_y[(node_index)],
+                        nodes_z[(rnode_index)] - nodes_z[(node_index)]};
+      const vec_t cd = {cell_c.x - nodes_x[(node_index)],
+                        cell_c.y - nodes_y[(node_index)],
+                        cell_c.z - nodes_z[(node_index)]};
+      const vec_t area = {0.5 * (ad.y * bd.z - ad.z * bd.y),
+                          -0.5 * (ad.x * bd.z - ad.z * bd.x),
+                          0.5 * (ad.x * bd.y - ad.y * bd.x)};
+
+      // Each subcell holds the half of the edge tetrahedron on its side
+      const double subsubcell_vol =
+          0.5 * fabs(cd.x * area.x + cd.y * area.y + cd.z * area.z) / 3.0;
+
+      // The centroids of the halves share three vertices, so accumulate the
+      // volume weighted vertex sums and divide by four once per subcell
+      const vec_t shared = {
+          0.5 * (nodes_x[(node_index)] + nodes_x[(rnode_index)]) + face_c.x +
+              cell_c.x,
+          0.5 * (nodes_y[(node_index)] + nodes_y[(rnode_index)]) + face_c.y +
+              cell_c.y,
+          0.5 * (nodes_z[(node_index)] + nodes_z[(rnode_index)]) + face_c.z +
+              cell_c.z};
+
+      subcell_volume[(subcell_index)] += subsubcell_vol;
+      subcell_centroids_x[(subcell_index)] +=
+          subsubcell_vol * (nodes_x[(node_index)] + shared.x);
+      subcell_centroids_y[(subcell_index)] +=
+          subsubcell_vol * (nodes_y[(node_index)] + shared.y);
+      subcell_centroids_z[(subcell_index)] +=
+          subsubcell_vol * (nodes_z[(node_index)] + shared.z);
+
+      subcell_volume[(rsubcell_index)] += subsubcell_vol;
+      subcell_centroids_x[(rsubcell_index)] +=
+          subsubcell_vol * (nodes_x[(rnode_index)] + shared.x);
+      subcell_centroids_y[(rsubcell_index)] +=
+          subsubcell_vol * (nodes_y[(rnode_index)] + shared.y);
+      subcell_centroids_z[(rsubcell_index)] +=
+          subsubcell_vol * (nodes_z[(rnode_index)] + shared.z);
     }
   }
 
+  double cell_vol = 0.0;
+  for (int nn = 0; nn < nnodes_by_cell; ++nn) {
+    const int subcell_index = cell_to_nodes_off + nn;
+    const double subcell_vol = subcell_volume[(subcell_index)];
+    subcell_centroids_x[(subcell_index)] /= 4.0 * subcell_vol;
+    subcell_centroids_y[(subcell_index)] /= 4.0 * subcell_vol;
+    subcell_centroids_z[(subcell_index)] /= 4.0 * subcell_vol;
+    cell_vol += subcell_vol;
+  }
+
   return cell_vol;
 }
 
-// Controls the timestep for the simulation
-void set_timestep(const int ncells, const double* nodes_x,
-                  const double* nodes_y, const double* nodes_z,
-                  const double* energy, double* dt, int* cells_to_faces_offsets,
-                  int* cells_to_faces, int* faces_to_nodes_offsets,
-                  int* faces_to_nodes) {
+// Calculates the volumes and centroids of all subcells for the current mesh
+// state, from the cell centroids and the cached face centroids
+void calc_subcell_geometry(
+    const int ncells, const int* cell_list, const int* cells_to_nodes_offsets,
+    const int* cells_to_faces_offsets, const int* cells_to_faces,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const double* nodes_x,
+    const double* nodes_y, const double* nodes_z,
+    const double* cell_centroids_x, const double* cell_centroids_y,
+    const double* cell_centroids_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    double* subcell_volume, double* subcell_centroids_x,
+    double* subcell_centroids_y, double* subcell_centroids_z) {
 
-  // Calculate the timestep based on the computational mesh and CFL
-  // condition
-  double local_dt = DBL_MAX;
-  START_PROFILING(&compute_profile);
-#pragma omp parallel for reduction(min : local_dt)
-  for (int cc = 0; cc < ncells; ++cc) {
+#pragma omp parallel for
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
+    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
+    const int nnodes_by_cell =
+        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
     const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
     const int nfaces_by_cell =
         cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
 
-    double shortest_edge = DBL_MAX;
+    const vec_t cell_c = {cell_centroids_x[(cc)], cell_centroids_y[(cc)],
+                          cell_centroids_z[(cc)]};
 
-    // Look at all of the faces attached to the cell
-    for (int ff = 0; ff < nfaces_by_cell; ++ff) {
-      const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
-      const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
+    calc_cell_subcell_geometry(
+        cc, cell_to_nodes_off, nnodes_by_cell, cell_to_faces_off,
+        nfaces_by_cell, cells_to_faces, faces_to_nodes_offsets, faces_to_nodes,
+        faces_to_cells0, faces_nodes_to_subcells0, faces_nodes_to_subcells1,
+        nodes_x, nodes_y, nodes_z, cell_c, face_centroids_x, face_centroids_y,
+        face_centroids_z, subcell_volume, subcell_centroids_x,
+        subcell_centroids_y, subcell_centroids_z);
+  }
+}
+
+// Updates the subcell volumes and centroids, expecting the cell centroids and
+// face geometry to have been updated for the same nodes
+void update_subcell_geometry(UnstructuredMesh* umesh, HaleData* hale_data,
+                             const double* nodes_x, const double* nodes_y,
+                             const double* nodes_z) {
+
+  calc_subcell_geometry(
+      hale_data->nfrontier_cells, hale_data->frontier_cells,
+      umesh->cells_to_nodes_offsets, umesh->cells_to_faces_offsets,
+      umesh->cells_to_faces, umesh->faces_to_nodes_offsets,
+      umesh->faces_to_nodes, umesh->faces_to_cells0,
+      hale_data->faces_nodes_to_subcells0, hale_data->faces_nodes_to_subcells1,
+      nodes_x, nodes_y, nodes_z, umesh->cell_centroids_x,
+      umesh->cell_centroids_y, umesh->cell_centroids_z,
+      hale_data->face_centroids_x, hale_data->face_centroids_y,
+      hale_data->face_centroids_z, hale_data->subcell_volume,
+      hale_data->subcell_centroids_x, hale_data->subcell_centroids_y,
+      hale_data->subcell_centroids_z);
+}
+
+// Calculates the face centroids, the area vectors of the tetrahedral faces
+// swept from each face edge and the edge lengths for the current mesh state.
+// When the energy is provided, the shortest time for a signal to cross an
+// edge, at the speed of sound plus the edge's fastest node speed, is returned
+// with the cell it was taken from
+time_limit_t calc_face_geometry(
+    const int nfaces, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_to_cells1, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, const double* energy, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    double* face_centroids_x, double* face_centroids_y,
+    double* face_centroids_z, double* face_edge_area_x,
+    double* face_edge_area_y, double* face_edge_area_z,
+    double* face_edge_lengths) {
+
+  time_limit_t edge_limit = {DBL_MAX, -1};
+  START_PROFILING(&compute_profile);
+#pragma omp parallel
+  {
+    time_limit_t thread_limit = {DBL_MAX, -1};
+
+#pragma omp for nowait
+    for (int ff = 0; ff < nfaces; ++ff) {
+      const int face_to_nodes_off = faces_to_nodes_offsets[(ff)];
       const int nnodes_by_face =
-          faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
+          faces_to_nodes_offsets[(ff + 1)] - face_to_nodes_off;
 
+      vec_t face_c = {0.0, 0.0, 0.0};
+      calc_centroid(nnodes_by_face, nodes_x, nodes_y, nodes_z, faces_to_nodes,
+                    face_to_nodes_off, &face_c);
+      face_centroids_x[(ff)] = face_c.x;
+      face_centroids_y[(ff)] = face_c.y;
+      face_centroids_z[(ff)] = face_c.z;
+
+      // The sound speed is taken from the hotter of the face's cells
+      const int face_cell = (energy) ? hotter_face_cell(ff, faces_to_cells0,
+                                                        faces_to_cells1, energy)
+                                     : -1;
+      const double soundspeed =
+          (energy) ? sqrt(GAM * (GAM - 1.0) * energy[(face_cell)]) : 0.0;
+
+      // The edges are stored in the counter-clockwise order of the face nodes
       for (int nn = 0; nn < nnodes_by_face; ++nn) {
-        // Fetch the nodes attached to our current node on the current face
-        const int node_index = faces_to_nodes[(face_to_nodes_off + nn)];
+        const int edge_index = face_to_nodes_off + nn;
+        const int node_index = faces_to_nodes[(edge_index)];
+        const int rnode_index = (nn + 1 < nnodes_by_face)
+                                    ? faces_to_nodes[(edge_index + 1)]
+                                    : faces_to_nodes[(face_to_nodes_off)];
+
+        // Get the halfway point on the right edge
+        vec_t half_edge = {
+            0.5 * (nodes_x[(node_index)] + nodes_x[(rnode_index)]),
+            0.5 * (nodes_y[(node_index)] + nodes_y[(rnode_index)]),
+            0.5 * (nodes_z[(node_index)] + nodes_z[(rnode_index)])};
+
+        // Setup basis on plane of tetrahedron
+        vec_t a = {(nodes_x[(node_index)] - half_edge.x),
+                   (nodes_y[(node_index)] - half_edge.y),
+                   (nodes_z[(node_index)] - half_edge.z)};
+        vec_t b = {(face_c.x - half_edge.x), (face_c.y - half_edge.y),
+                   (face_c.z - half_edge.z)};
+
+        // Calculate the area vector using cross product
+        face_edge_area_x[(edge_index)] = 0.5 * (a.y * b.z - a.z * b.y);
+        face_edge_area_y[(edge_index)] = -0.5 * (a.x * b.z - a.z * b.x);
+        face_edge_area_z[(edge_index)] = 0.5 * (a.x * b.y - a.y * b.x);
 
-        const int rnode_index =
-            (nn + 1 < nnodes_by_face)
-                ? faces_to_nodes[(face_to_nodes_off + nn + 1)]
-                : faces_to_nodes[(face_to_nodes_off)];
         const double x_component =
             nodes_x[(node_index)] - nodes_x[(rnode_index)];
         const double y_component =
             nodes_y[(node_index)] - nodes_y[(rnode_index)];
         const double z_component =
             nodes_z[(node_index)] - nodes_z[(rnode_index)];
+        face_edge_lengths[(edge_index)] =
+            sqrt(x_component * x_component + y_component * y_component +
+                 z_component * z_component);
+
+        if (energy) {
+          const double node_speed = max(
+              calc_node_speed(node_index, velocity_x, velocity_y, velocity_z),
+              calc_node_speed(rnode_index, velocity_x, velocity_y,
+                              velocity_z));
+          min_time_limit(&thread_limit,
+                         face_edge_lengths[(edge_index)] /
+                             (soundspeed + node_speed),
+                         face_cell);
+        }
+      }
+    }
+
+#pragma omp critical
+    min_time_limit(&edge_limit, thread_limit.time, thread_limit.cell);
+  }
+  STOP_PROFILING(&compute_profile, __func__);
 
-        // Find the shortest edge of this cell
-        shortest_edge = min(shortest_edge, sqrt(x_component * x_component +
-                                                y_component * y_component +
-                                                z_component * z_component));
+  return edge_limit;
+}
+
+// Calculates the face geometry for a hexahedral mesh, returning the shortest
+// edge signal time if the energy is provided
+time_limit_t calc_face_geometry_hex(
+    const int nfaces, const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_to_cells1, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, const double* energy, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    double* face_centroids_x, double* face_centroids_y,
+    double* face_centroids_z, double* face_edge_area_x,
+    double* face_edge_area_y, double* face_edge_area_z,
+    double* face_edge_lengths) {
+
+  time_limit_t edge_limit = {DBL_MAX, -1};
+  START_PROFILING(&compute_profile);
+#pragma omp parallel
+  {
+    time_limit_t thread_limit = {DBL_MAX, -1};
+
+#pragma omp for nowait
+    for (int ff = 0; ff < nfaces; ++ff) {
+      const int face_to_nodes_off = ff * NNODES_BY_HEX_FACE;
+
+      double face_nodes_x[NNODES_BY_HEX_FACE];
+      double face_nodes_y[NNODES_BY_HEX_FACE];
+      double face_nodes_z[NNODES_BY_HEX_FACE];
+      double face_node_speeds[NNODES_BY_HEX_FACE];
+      vec_t face_c = {0.0, 0.0, 0.0};
+      for (int nn = 0; nn < NNODES_BY_HEX_FACE; ++nn) {
+        const int node_index = faces_to_nodes[(face_to_nodes_off + nn)];
+        face_nodes_x[(nn)] = nodes_x[(node_index)];
+        face_nodes_y[(nn)] = nodes_y[(node_index)];
+        face_nodes_z[(nn)] = nodes_z[(node_index)];
+        face_node_speeds[(nn)] =
+            (energy) ? calc_node_speed(node_index, velocity_x, velocity_y,
+                                       velocity_z)
+                     : 0.0;
+        face_c.x += face_nodes_x[(nn)] / NNODES_BY_HEX_FACE;
+        face_c.y += face_nodes_y[(nn)] / NNODES_BY_HEX_FACE;
+        face_c.z += face_nodes_z[(nn)] / NNODES_BY_HEX_FACE;
+      }
+      face_centroids_x[(ff)] = face_c.x;
+      face_centroids_y[(ff)] = face_c.y;
+      face_centroids_z[(ff)] = face_c.z;
+
+      // The sound speed is taken from the hotter of the face's cells
+      const int face_cell = (energy) ? hotter_face_cell(ff, faces_to_cells0,
+                                                        faces_to_cells1, energy)
+                                     : -1;
+      const double soundspeed =
+          (energy) ? sqrt(GAM * (GAM - 1.0) * energy[(face_cell)]) : 0.0;
+
+      // The edges are stored in the counter-clockwise order of the face nodes
+      for (int nn = 0; nn < NNODES_BY_HEX_FACE; ++nn) {
+        const int edge_index = face_to_nodes_off + nn;
+        const int rnn = (nn + 1 < NNODES_BY_HEX_FACE) ? nn + 1 : 0;
+
+        // Get the halfway point on the right edge
+        vec_t half_edge = {0.5 * (face_nodes_x[(nn)] + face_nodes_x[(rnn)]),
+                           0.5 * (face_nodes_y[(nn)] + face_nodes_y[(rnn)]),
+                           0.5 * (face_nodes_z[(nn)] + face_nodes_z[(rnn)])};
+
+        // Setup basis on plane of tetrahedron
+        vec_t a = {(face_nodes_x[(nn)] - half_edge.x),
+                   (face_nodes_y[(nn)] - half_edge.y),
+                   (face_nodes_z[(nn)] - half_edge.z)};
+        vec_t b = {(face_c.x - half_edge.x), (face_c.y - half_edge.y),
+                   (face_c.z - half_edge.z)};
+
+        // Calculate the area vector using cross product
+        face_edge_area_x[(edge_index)] = 0.5 * (a.y * b.z - a.z * b.y);
+        face_edge_area_y[(edge_index)] = -0.5 * (a.x * b.z - a.z * b.x);
+        face_edge_area_z[(edge_index)] = 0.5 * (a.x * b.y - a.y * b.x);
+
+        const double x_component = face_nodes_x[(nn)] - face_nodes_x[(rnn)];
+        const double y_component = face_nodes_y[(nn)] - face_nodes_y[(rnn)];
+        const double z_component = face_nodes_z[(nn)] - face_nodes_z[(rnn)];
+        face_edge_lengths[(edge_index)] =
+            sqrt(x_component * x_component + y_component * y_component +
+                 z_component * z_component);
+
+        if (energy) {
+          const double node_speed =
+              max(face_node_speeds[(nn)], face_node_speeds[(rnn)]);
+          min_time_limit(&thread_limit,
+                         face_edge_lengths[(edge_index)] /
+                             (soundspeed + node_speed),
+                         face_cell);
+        }
       }
     }
 
-    const double soundspeed = sqrt(GAM * (GAM - 1.0) * energy[(cc)]);
-    local_dt = min(local_dt, shortest_edge / soundspeed);
+#pragma omp critical
+    min_time_limit(&edge_limit, thread_limit.time, thread_limit.cell);
+  }
+  STOP_PROFILING(&compute_profile, __func__);
+
+  return edge_limit;
+}
+
+// Updates the cached face geometry, with the hexahedral or general kernel.
+// When the energy is provided, the shortest edge signal time for the
+// timestep is returned, otherwise the time is DBL_MAX
+time_limit_t update_face_geometry(UnstructuredMesh* umesh,
+                                  HaleData* hale_data, const double* nodes_x,
+                                  const double* nodes_y, const double* nodes_z,
+                                  const double* energy,
+                                  const double* velocity_x,
+                                  const double* velocity_y,
+                                  const double* velocity_z) {
+
+  if (hale_data->hex_mesh) {
+    return calc_face_geometry_hex(
+        umesh->nfaces, umesh->faces_to_nodes, umesh->faces_to_cells0,
+        umesh->faces_to_cells1, nodes_x, nodes_y, nodes_z, energy, velocity_x,
+        velocity_y, velocity_z, hale_data->face_centroids_x,
+        hale_data->face_centroids_y, hale_data->face_centroids_z,
+        hale_data->face_edge_area_x, hale_data->face_edge_area_y,
+        hale_data->face_edge_area_z, hale_data->face_edge_lengths);
+  }
+
+  return calc_face_geometry(
+      umesh->nfaces, umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+      umesh->faces_to_cells0, umesh->faces_to_cells1, nodes_x, nodes_y,
+      nodes_z, energy, velocity_x, velocity_y, velocity_z,
+      hale_data->face_centroids_x, hale_data->face_centroids_y,
+      hale_data->face_centroids_z, hale_data->face_edge_area_x,
+      hale_data->face_edge_area_y, hale_data->face_edge_area_z,
+      hale_data->face_edge_lengths);
+}
+
+// Calculates the cell centroids for a hexahedral mesh
+void calc_cell_centroids_hex(const int ncells, const int* cell_list,
+                             const int* cells_to_nodes, const double* nodes_x,
+                             const double* nodes_y, const double* nodes_z,
+                             double* cell_centroids_x, double* cell_centroids_y,
+                             double* cell_centroids_z) {
+
+  START_PROFILING(&compute_profile);
+#pragma omp parallel for
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
+    const int cell_to_nodes_off = cc * NNODES_BY_HEX_CELL;
+
+    vec_t cell_c = {0.0, 0.0, 0.0};
+    for (int nn = 0; nn < NNODES_BY_HEX_CELL; ++nn) {
+      const int node_index = cells_to_nodes[(cell_to_nodes_off + nn)];
+      cell_c.x += nodes_x[(node_index)] / NNODES_BY_HEX_CELL;
+      cell_c.y += nodes_y[(node_index)] / NNODES_BY_HEX_CELL;
+      cell_c.z += nodes_z[(node_index)] / NNODES_BY_HEX_CELL;
+    }
+
+    cell_centroids_x[(cc)] = cell_c.x;
+    cell_centroids_y[(cc)] = cell_c.y;
+    cell_centroids_z[(cc)] = cell_c.z;
   }
   STOP_PROFILING(&compute_profile, __func__);
+}
+
+// Updates the cell centroids, with the hexahedral or general kernel
+void update_cell_centroids(UnstructuredMesh* umesh, HaleData* hale_data,
+                           const double* nodes_x, const double* nodes_y,
+                           const double* nodes_z) {
+
+  if (hale_data->hex_mesh) {
+    calc_cell_centroids_hex(hale_data->nfrontier_cells,
+                            hale_data->frontier_cells, umesh->cells_to_nodes,
+                            nodes_x, nodes_y, nodes_z, umesh->cell_centroids_x,
+                            umesh->cell_centroids_y, umesh->cell_centroids_z);
+  } else {
+    init_cell_centroids(hale_data->nfrontier_cells, hale_data->frontier_cells,
+                        umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
+                        nodes_x, nodes_y, nodes_z, umesh->cell_centroids_x,
+                        umesh->cell_centroids_y, umesh->cell_centroids_z);
+  }
+}
+
+// Controls the timestep for the simulation. The timestep is the smaller of
+// the CFL limited edge signal time and the time for any cell to change its
+// volume by the maximum fraction, and grows from the previous timestep by at
+// most the growth factor. A zero volume change or growth factor is unbounded.
+void set_timestep(const double max_dt_growth, const double max_volume_change,
+                  const time_limit_t edge_limit,
+                  const time_limit_t volume_limit, double* dt) {
+
+  const double prev_dt = *dt;
+  const char* limiter = "signal speed";
+  int limit_cell = edge_limit.cell;
+
+  *dt = CFL * edge_limit.time;
+
+  if (max_volume_change > 0.0 &&
+      max_volume_change * volume_limit.time < *dt) {
+    *dt = max_volume_change * volume_limit.time;
+    limiter = "volume change";
+    limit_cell = volume_limit.cell;
+  }
+
+  if (max_dt_growth > 0.0 && max_dt_growth * prev_dt < *dt) {
+    *dt = max_dt_growth * prev_dt;
+    limiter = "growth";
+    limit_cell = -1;
+  }
+
+  printf("Timestep %.8fs limited by %s", *dt, limiter);
+  if (limit_cell != -1) {
+    printf(" in cell %d", limit_cell);
+  }
+  printf("\n");
+}
+
+// Reduces a timestep constraint to the smaller time, taking the lower cell
+// index on ties so the limiting cell doesn't depend on the thread count
+void min_time_limit(time_limit_t* limit, const double time, const int cell) {
+  if (time < limit->time || (time == limit->time && cell < limit->cell)) {
+    limit->time = time;
+    limit->cell = cell;
+  }
+}
+
+// Selects the face's cell with the highest energy, and so sound speed
+int hotter_face_cell(const int face_index, const int* faces_to_cells0,
+                     const int* faces_to_cells1, const double* energy) {
+  const int cell_index0 = faces_to_cells0[(face_index)];
+  const int cell_index1 = faces_to_cells1[(face_index)];
+  if (cell_index1 == -1) {
+    return cell_index0;
+  }
+  if (cell_index0 == -1) {
+    return cell_index1;
+  }
+  return (energy[(cell_index1)] > energy[(cell_index0)]) ? cell_index1
+                                                         : cell_index0;
+}
+
+// Calculates the magnitude of a node's velocity
+double calc_node_speed(const int node_index, const double* velocity_x,
+                       const double* velocity_y, const double* velocity_z) {
+  return sqrt(velocity_x[(node_index)] * velocity_x[(node_index)] +
+              velocity_y[(node_index)] * velocity_y[(node_index)] +
+              velocity_z[(node_index)] * velocity_z[(node_index)]);
+}
+
+// Calculates the time for a cell to change by its own volume, at the rate it
+// changed over the timestep
+double calc_volume_time(const double dt, const double old_volume,
+                        const double new_volume) {
+  const double volume_change = fabs(new_volume - old_volume);
+  return (volume_change > 0.0) ? dt * old_volume / volume_change : DBL_MAX;
+}
 
-  *dt = CFL * local_dt;
+// Adds the artificial viscous forces from the edges of a face of the cell to
+// the cell's subcells
+static inline void add_face_viscous_forces(
+    const int cc, const int face_index, const int nnodes_by_face,
+    const int face_to_nodes_off, const double visc_coeff1,
+    const double visc_coeff2, const int* faces_to_nodes,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const int* faces_cclockwise_cell,
+    const double* nodes_x, const double* nodes_y, const double* nodes_z,
+    const double* cell_centroids_x, const double* cell_centroids_y,
+    const double* cell_centroids_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    const double* velocity_x, const double* velocity_y,
+    const double* velocity_z, const double* nodal_soundspeed,
+    const double* nodal_mass, const double* nodal_volumes,
+    const double* limiter, double* subcell_force_x, double* subcell_force_y,
+    double* subcell_force_z) {
 
-  printf("Timestep %.8fs\n", *dt);
+  const int face_clockwise = (faces_cclockwise_cell[(face_index)] != cc);
+
+  const vec_t face_c = {face_centroids_x[(face_index)],
+                        face_centroids_y[(face_index)],
+                        face_centroids_z[(face_index)]};
+
+  // The subcells of the face nodes from this cell's side of the face
+  const int* face_nodes_to_subcells =
+      ((faces_to_cells0[(face_index)] == cc) ? faces_nodes_to_subcells0
+                                             : faces_nodes_to_subcells1) +
+      face_to_nodes_off;
+
+  // Now we will sum the contributions at each of the nodes
+  for (int nn2 = 0; nn2 < nnodes_by_face; ++nn2) {
+    const int node_index = faces_to_nodes[(face_to_nodes_off + nn2)];
+    const int next_node = (nn2 == nnodes_by_face - 1) ? 0 : nn2 + 1;
+    const int prev_node = (nn2 == 0) ? nnodes_by_face - 1 : nn2 - 1;
+    const int rnode_off = (face_clockwise ? prev_node : next_node);
+    const int rnode_index = faces_to_nodes[(face_to_nodes_off + rnode_off)];
+
+    // Get the halfway point on the right edge
+    vec_t half_edge = {
+        0.5 * (nodes_x[(node_index)] + nodes_x[(rnode_index)]),
+        0.5 * (nodes_y[(node_index)] + nodes_y[(rnode_index)]),
+        0.5 * (nodes_z[(node_index)] + nodes_z[(rnode_index)])};
+
+    // Setup basis on plane of tetrahedron
+    vec_t a = {(cell_centroids_x[(cc)] - face_c.x),
+               (cell_centroids_y[(cc)] - face_c.y),
+               (cell_centroids_z[(cc)] - face_c.z)};
+    vec_t b = {(half_edge.x - face_c.x), (half_edge.y - face_c.y),
+               (half_edge.z - face_c.z)};
+
+    vec_t S = {0.5 * (a.y * b.z - a.z * b.y),
+               -0.5 * (a.x * b.z - a.z * b.x),
+               0.5 * (a.x * b.y - a.y * b.x)};
+
+    // Calculate the velocity gradients
+    vec_t dvel = {velocity_x[(node_index)] - velocity_x[(rnode_index)],
+                  velocity_y[(node_index)] - velocity_y[(rnode_index)],
+                  velocity_z[(node_index)] - velocity_z[(rnode_index)]};
+
+    const double dvel_mag =
+        sqrt(dvel.x * dvel.x + dvel.y * dvel.y + dvel.z * dvel.z);
+
+    // Calculate the unit vectors of the velocity gradients
+    vec_t dvel_unit = {(dvel_mag != 0.0) ? dvel.x / dvel_mag : 0.0,
+                       (dvel_mag != 0.0) ? dvel.y / dvel_mag : 0.0,
+                       (dvel_mag != 0.0) ? dvel.z / dvel_mag : 0.0};
+
+    // Get the edge-centered density
+    double nodal_density =
+        nodal_mass[(node_index)] / nodal_volumes[(node_index)];
+    double rnodal_density =
+        nodal_mass[(rnode_index)] / nodal_volumes[(rnode_index)];
+    const double density_edge = (2.0 * nodal_density * rnodal_density) /
+                                (nodal_density + rnodal_density);
+
+    // Calculate the artificial viscous force term for the edge
+    double expansion_term = (dvel.x * S.x + dvel.y * S.y + dvel.z * S.z);
+
+    // If the cell is compressing, calculate the edge forces and add
+    // their contributions to the node forces
+    if (expansion_term <= 0.0) {
+      // Calculate the minimum soundspeed
+      const double cs = min(nodal_soundspeed[(node_index)],
+                            nodal_soundspeed[(rnode_index)]);
+      const double t = 0.25 * (GAM + 1.0);
+      const double edge_visc_force_x =
+          density_edge *
+          (visc_coeff2 * t * fabs(dvel.x) +
+           sqrt(visc_coeff2 * visc_coeff2 * t * t * dvel.x * dvel.x +
+                visc_coeff1 * visc_coeff1 * cs * cs)) *
+          (1.0 - limiter[(node_index)]) * expansion_term * dvel_unit.x;
+      const double edge_visc_force_y =
+          density_edge *
+          (visc_coeff2 * t * fabs(dvel.y) +
+           sqrt(visc_coeff2 * visc_coeff2 * t * t * dvel.y * dvel.y +
+                visc_coeff1 * visc_coeff1 * cs * cs)) *
+          (1.0 - limiter[(node_index)]) * expansion_term * dvel_unit.y;
+      const double edge_visc_force_z =
+          density_edge *
+          (visc_coeff2 * t * fabs(dvel.z) +
+           sqrt(visc_coeff2 * visc_coeff2 * t * t * dvel.z * dvel.z +
+                visc_coeff1 * visc_coeff1 * cs * cs)) *
+          (1.0 - limiter[(node_index)]) * expansion_term * dvel_unit.z;
+
+      const int subcell_index = face_nodes_to_subcells[(nn2)];
+      const int rsubcell_index = face_nodes_to_subcells[(rnode_off)];
+
+      // Add the contributions of the edge based artifical viscous terms
+      // to the main force terms
+      subcell_force_x[(subcell_index)] += edge_visc_force_x;
+      subcell_force_y[(subcell_index)] += edge_visc_force_y;
+      subcell_force_z[(subcell_index)] += edge_visc_force_z;
+      subcell_force_x[(rsubcell_index)] -= edge_visc_force_x;
+      subcell_force_y[(rsubcell_index)] -= edge_visc_force_y;
+      subcell_force_z[(rsubcell_index)] -= edge_visc_force_z;
+    }
+  }
 }
 
 // Calculates the artificial viscous forces for momentum acceleration
 void calc_artificial_viscosity(
-    const int ncells, const double visc_coeff1, const double visc_coeff2,
-    const int* cells_to_nodes_offsets, const int* cells_to_nodes,
+    const int ncells, const int* cell_list, const double visc_coeff1,
+    const double visc_coeff2, const int* faces_to_cells0,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
     const int* faces_cclockwise_cell, const double* nodes_x,
     const double* nodes_y, const double* nodes_z,
     const double* cell_centroids_x, const double* cell_centroids_y,
-    const double* cell_centroids_z, const double* velocity_x,
-    const double* velocity_y, const double* velocity_z,
-    const double* nodal_soundspeed, const double* nodal_mass,
-    const double* nodal_volumes, const double* limiter, double* subcell_force_x,
-    double* subcell_force_y, double* subcell_force_z,
-    int* faces_to_nodes_offsets, int* faces_to_nodes,
+    const double* cell_centroids_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    const double* velocity_x, const double* velocity_y,
+    const double* velocity_z, const double* nodal_soundspeed,
+    const double* nodal_mass, const double* nodal_volumes,
+    const double* limiter, double* subcell_force_x, double* subcell_force_y,
+    double* subcell_force_z, int* faces_to_nodes_offsets, int* faces_to_nodes,
     int* cells_to_faces_offsets, int* cells_to_faces) {
 
 #pragma omp parallel for
-  for (int cc = 0; cc < ncells; ++cc) {
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
     const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
     const int nfaces_by_cell =
         cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
-    const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
-    const int nnodes_by_cell =
-        cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
 
     // Look at all of the faces attached to the cell
     for (int ff = 0; ff < nfaces_by_cell; ++ff) {
@@ -888,108 +1784,282 @@ void calc_artificial_viscosity(
       const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
       const int nnodes_by_face =
           faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
+      add_face_viscous_forces(
+          cc, face_index, nnodes_by_face, face_to_nodes_off, visc_coeff1,
+          visc_coeff2, faces_to_nodes, faces_to_cells0,
+          faces_nodes_to_subcells0, faces_nodes_to_subcells1,
+          faces_cclockwise_cell, nodes_x, nodes_y, nodes_z, cell_centroids_x,
+          cell_centroids_y, cell_centroids_z, face_centroids_x,
+          face_centroids_y, face_centroids_z, velocity_x, velocity_y,
+          velocity_z, nodal_soundspeed, nodal_mass, nodal_volumes, limiter,
+          subcell_force_x, subcell_force_y, subcell_force_z);
+    }
+  }
+}
 
-      vec_t face_c = {0.0, 0.0, 0.0};
-      calc_centroid(nnodes_by_face, nodes_x, nodes_y, nodes_z, faces_to_nodes,
-                    face_to_nodes_off, &face_c);
+// Calculates the artificial viscous forces for momentum acceleration on a
+// hexahedral mesh
+void calc_artificial_viscosity_hex(
+    const int ncells, const int* cell_list, const double visc_coeff1,
+    const double visc_coeff2, const int* cells_to_faces,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const int* faces_cclockwise_cell, const double* nodes_x,
+    const double* nodes_y, const double* nodes_z,
+    const double* cell_centroids_x, const double* cell_centroids_y,
+    const double* cell_centroids_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    const double* velocity_x, const double* velocity_y,
+    const double* velocity_z, const double* nodal_soundspeed,
+    const double* nodal_mass, const double* nodal_volumes,
+    const double* limiter, double* subcell_force_x, double* subcell_force_y,
+    double* subcell_force_z) {
 
-      // Now we will sum the contributions at each of the nodes
-      for (int nn2 = 0; nn2 < nnodes_by_face; ++nn2) {
-        const int node_index = faces_to_nodes[(face_to_nodes_off + nn2)];
-        const int face_clockwise = (faces_cclockwise_cell[(face_index)] != cc);
-        const int next_node = (nn2 == nnodes_by_face - 1) ? 0 : nn2 + 1;
-        const int prev_node = (nn2 == 0) ? nnodes_by_face - 1 : nn2 - 1;
-        const int rnode_off = (face_clockwise ? prev_node : next_node);
-        const int rnode_index = faces_to_nodes[(face_to_nodes_off + rnode_off)];
+#pragma omp parallel for
+  for (int ii = 0; ii < ncells; ++ii) {
+    const int cc = (cell_list ? cell_list[(ii)] : ii);
+    const int cell_to_faces_off = cc * NFACES_BY_HEX_CELL;
 
-        // Get the halfway point on the right edge
-        vec_t half_edge = {
-            0.5 * (nodes_x[(node_index)] + nodes_x[(rnode_index)]),
-            0.5 * (nodes_y[(node_index)] + nodes_y[(rnode_index)]),
-            0.5 * (nodes_z[(node_index)] + nodes_z[(rnode_index)])};
+    // Look at all of the faces attached to the cell
+    for (int ff = 0; ff < NFACES_BY_HEX_CELL; ++ff) {
+      const int face_index = cells_to_faces[(cell_to_faces_off + ff)];
+      add_face_viscous_forces(
+          cc, face_index, NNODES_BY_HEX_FACE, face_index * NNODES_BY_HEX_FACE,
+          visc_coeff1, visc_coeff2, faces_to_nodes, faces_to_cells0,
+          faces_nodes_to_subcells0, faces_nodes_to_subcells1,
+          faces_cclockwise_cell, nodes_x, nodes_y, nodes_z, cell_centroids_x,
+          cell_centroids_y, cell_centroids_z, face_centroids_x,
+          face_centroids_y, face_centroids_z, velocity_x, velocity_y,
+          velocity_z, nodal_soundspeed, nodal_mass, nodal_volumes, limiter,
+          subcell_force_x, subcell_force_y, subcell_force_z);
+    }
+  }
+}
 
-        // Setup basis on plane of tetrahedron
-        vec_t a = {(cell_centroids_x[(cc)] - face_c.x),
-                   (cell_centroids_y[(cc)] - face_c.y),
-                   (cell_centroids_z[(cc)] - face_c.z)};
-        vec_t b = {(half_edge.x - face_c.x), (half_edge.y - face_c.y),
-                   (half_edge.z - face_c.z)};
-
-        vec_t S = {0.5 * (a.y * b.z - a.z * b.y),
-                   -0.5 * (a.x * b.z - a.z * b.x),
-                   0.5 * (a.x * b.y - a.y * b.x)};
-
-        // Calculate the velocity gradients
-        vec_t dvel = {velocity_x[(node_index)] - velocity_x[(rnode_index)],
-                      velocity_y[(node_index)] - velocity_y[(rnode_index)],
-                      velocity_z[(node_index)] - velocity_z[(rnode_index)]};
-
-        const double dvel_mag =
-            sqrt(dvel.x * dvel.x + dvel.y * dvel.y + dvel.z * dvel.z);
-
-        // Calculate the unit vectors of the velocity gradients
-        vec_t dvel_unit = {(dvel_mag != 0.0) ? dvel.x / dvel_mag : 0.0,
-                           (dvel_mag != 0.0) ? dvel.y / dvel_mag : 0.0,
-                           (dvel_mag != 0.0) ? dvel.z / dvel_mag : 0.0};
-
-        // Get the edge-centered density
-        double nodal_density =
-            nodal_mass[(node_index)] / nodal_volumes[(node_index)];
-        double rnodal_density =
-            nodal_mass[(rnode_index)] / nodal_volumes[(rnode_index)];
-        const double density_edge = (2.0 * nodal_density * rnodal_density) /
-                                    (nodal_density + rnodal_density);
-
-        // Calculate the artificial viscous force term for the edge
-        double expansion_term = (dvel.x * S.x + dvel.y * S.y + dvel.z * S.z);
-
-        // If the cell is compressing, calculate the edge forces and add
-        // their contributions to the node forces
-        if (expansion_term <= 0.0) {
-          // Calculate the minimum soundspeed
-          const double cs = min(nodal_soundspeed[(node_index)],
-                                nodal_soundspeed[(rnode_index)]);
-          const double t = 0.25 * (GAM + 1.0);
-          const double edge_visc_force_x =
-              density_edge *
+// Calculates the artificial viscous forces for momentum acceleration edge by
+// edge, so the velocity difference, edge density and viscous coefficients are
+// computed once for each edge. The edges of a colour share no nodes, so their
+// subcell forces can be updated without races. Only the subcells of the cells
+// in cells_frontier are updated, or of every cell when it is NULL.
+void calc_artificial_viscosity_by_edge(
+    const int nedge_colours, const int* edge_colour_offsets,
+    const int* edges_by_colour, const int* edges_to_nodes,
+    const int* edges_to_faces_offsets, const int* edges_to_faces,
+    const int* edges_to_face_edges, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_to_cells1, const int* cells_frontier,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const int* faces_cclockwise_cell, const double visc_coeff1,
+    const double visc_coeff2, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, const double* cell_centroids_x,
+    const double* cell_centroids_y, const double* cell_centroids_z,
+    const double* face_centroids_x, const double* face_centroids_y,
+    const double* face_centroids_z, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    const double* nodal_soundspeed, const double* nodal_mass,
+    const double* nodal_volumes, const double* limiter, double* subcell_force_x,
+    double* subcell_force_y, double* subcell_force_z) {
+
+  const double t = 0.25 * (GAM + 1.0);
+
+  for (int colour = 0; colour < nedge_colours; ++colour) {
+#pragma omp parallel for
+    for (int ee = edge_colour_offsets[(colour)];
+         ee < edge_colour_offsets[(colour + 1)]; ++ee) {
+      const int edge_index = edges_by_colour[(ee)];
+      const int node0_index = edges_to_nodes[(edge_index * 2)];
+      const int node1_index = edges_to_nodes[(edge_index * 2 + 1)];
+
+      // Get the halfway point on the edge
+      const vec_t half_edge = {
+          0.5 * (nodes_x[(node0_index)] + nodes_x[(node1_index)]),
+          0.5 * (nodes_y[(node0_index)] + nodes_y[(node1_index)]),
+          0.5 * (nodes_z[(node0_index)] + nodes_z[(node1_index)])};
+
+      // Calculate the velocity gradients from the first node of the edge
+      const vec_t dvel = {
+          velocity_x[(node0_index)] - velocity_x[(node1_index)],
+          velocity_y[(node0_index)] - velocity_y[(node1_index)],
+          velocity_z[(node0_index)] - velocity_z[(node1_index)]};
+
+      const double dvel_mag =
+          sqrt(dvel.x * dvel.x + dvel.y * dvel.y + dvel.z * dvel.z);
+
+      // Calculate the unit vectors of the velocity gradients
+      const vec_t dvel_unit = {(dvel_mag != 0.0) ? dvel.x / dvel_mag : 0.0,
+                               (dvel_mag != 0.0) ? dvel.y / dvel_mag : 0.0,
+                               (dvel_mag != 0.0) ? dvel.z / dvel_mag : 0.0};
+
+      // Get the edge-centered density
+      const double nodal_density =
+          nodal_mass[(node0_index)] / nodal_volumes[(node0_index)];
+      const double rnodal_density =
+          nodal_mass[(node1_index)] / nodal_volumes[(node1_index)];
+      const double density_edge = (2.0 * nodal_density * rnodal_density) /
+                                  (nodal_density + rnodal_density);
+
+      // Calculate the minimum soundspeed, and the viscous coefficients, which
+      // don't depend on the direction the edge is traversed in
+      const double cs = min(nodal_soundspeed[(node0_index)],
+                            nodal_soundspeed[(node1_index)]);
+      const vec_t edge_visc = {
+          density_edge *
               (visc_coeff2 * t * fabs(dvel.x) +
                sqrt(visc_coeff2 * visc_coeff2 * t * t * dvel.x * dvel.x +
-                    visc_coeff1 * visc_coeff1 * cs * cs)) *
-              (1.0 - limiter[(node_index)]) * expansion_term * dvel_unit.x;
-          const double edge_visc_force_y =
-              density_edge *
+                    visc_coeff1 * visc_coeff1 * cs * cs)),
+          density_edge *
               (visc_coeff2 * t * fabs(dvel.y) +
                sqrt(visc_coeff2 * visc_coeff2 * t * t * dvel.y * dvel.y +
-                    visc_coeff1 * visc_coeff1 * cs * cs)) *
-              (1.0 - limiter[(node_index)]) * expansion_term * dvel_unit.y;
-          const double edge_visc_force_z =
-              density_edge *
+                    visc_coeff1 * visc_coeff1 * cs * cs)),
+          density_edge *
               (visc_coeff2 * t * fabs(dvel.z) +
                sqrt(visc_coeff2 * visc_coeff2 * t * t * dvel.z * dvel.z +
-                    visc_coeff1 * visc_coeff1 * cs * cs)) *
-              (1.0 - limiter[(node_index)]) * expansion_term * dvel_unit.z;
-
-          int subcell_index;
-          int rsubcell_index;
-          for (int nn3 = 0; nn3 < nnodes_by_cell; ++nn3) {
-            if (cells_to_nodes[(cell_to_nodes_off + nn3)] == node_index) {
-              subcell_index = cell_to_nodes_off + nn3;
-            } else if (cells_to_nodes[(cell_to_nodes_off + nn3)] ==
-                       rnode_index) {
-              rsubcell_index = cell_to_nodes_off + nn3;
-            }
+                    visc_coeff1 * visc_coeff1 * cs * cs))};
+
+      // Apply the edge to the subcells of each cell on each face holding it
+      const int edge_to_faces_off = edges_to_faces_offsets[(edge_index)];
+      const int nfaces_by_edge =
+          edges_to_faces_offsets[(edge_index + 1)] - edge_to_faces_off;
+      for (int ff = 0; ff < nfaces_by_edge; ++ff) {
+        const int face_index = edges_to_faces[(edge_to_faces_off + ff)];
+        const int face_to_nodes_off = faces_to_nodes_offsets[(face_index)];
+        const int nnodes_by_face =
+            faces_to_nodes_offsets[(face_index + 1)] - face_to_nodes_off;
+
+        // The face edge and the face edge following it in the face's order
+        const int face_edge_index =
+            edges_to_face_edges[(edge_to_faces_off + ff)];
+        const int rface_edge_index =
+            (face_edge_index + 1 < face_to_nodes_off + nnodes_by_face)
+                ? face_edge_index + 1
+                : face_to_nodes_off;
+
+        const vec_t face_c = {face_centroids_x[(face_index)],
+                              face_centroids_y[(face_index)],
+                              face_centroids_z[(face_index)]};
+
+        for (int cc = 0; cc < 2; ++cc) {
+          const int cell_index =
+              (cc == 0) ? faces_to_cells0[(face_index)]
+                        : faces_to_cells1[(face_index)];
+          if (cell_index == -1 ||
+              (cells_frontier && !cells_frontier[(cell_index)])) {
+            continue;
           }
 
-          // Add the contributions of the edge based artifical viscous terms
-          // to the main force terms
-          subcell_force_x[(subcell_index)] += edge_visc_force_x;
-          subcell_force_y[(subcell_index)] += edge_visc_force_y;
-          subcell_force_z[(subcell_index)] += edge_visc_force_z;
-          subcell_force_x[(rsubcell_index)] -= edge_visc_force_x;
-          subcell_force_y[(rsubcell_index)] -= edge_visc_force_y;
-          subcell_force_z[(rsubcell_index)] -= edge_visc_force_z;
+          // The node leading the edge in the cell's counter-clockwise
+          // traversal of the face takes the positive contribution, and the
+          // velocity gradient is taken from it
+          const int* face_nodes_to_subcells =
+              (cc == 0) ? faces_nodes_to_subcells0 : faces_nodes_to_subcells1;
+          const int face_cclockwise =
+              (faces_cclockwise_cell[(face_index)] == cell_index);
+          const int node_face_edge_index =
+              face_cclockwise ? face_edge_index : rface_edge_index;
+          const int rnode_face_edge_index =
+              face_cclockwise ? rface_edge_index : face_edge_index;
+          const int node_index = faces_to_nodes[(node_face_edge_index)];
+          const double dir = (node_index == node0_index) ? 1.0 : -1.0;
+
+          // Setup basis on plane of tetrahedron
+          const vec_t a = {(cell_centroids_x[(cell_index)] - face_c.x),
+                           (cell_centroids_y[(cell_index)] - face_c.y),
+                           (cell_centroids_z[(cell_index)] - face_c.z)};
+          const vec_t b = {(half_edge.x - face_c.x), (half_edge.y - face_c.y),
+                           (half_edge.z - face_c.z)};
+
+          const vec_t S = {0.5 * (a.y * b.z - a.z * b.y),
+                           -0.5 * (a.x * b.z - a.z * b.x),
+                           0.5 * (a.x * b.y - a.y * b.x)};
+
+          // Calculate the artificial viscous force term for the edge
+          const double expansion_term =
+              (dir * dvel.x * S.x + dir * dvel.y * S.y + dir * dvel.z * S.z);
+
+          // If the cell is compressing, add the edge forces to the subcells
+          if (expansion_term <= 0.0) {
+            const double node_limiter = 1.0 - limiter[(node_index)];
+            const double edge_visc_force_x = edge_visc.x * node_limiter *
+                                             expansion_term *
+                                             (dir * dvel_unit.x);
+            const double edge_visc_force_y = edge_visc.y * node_limiter *
+                                             expansion_term *
+                                             (dir * dvel_unit.y);
+            const double edge_visc_force_z = edge_visc.z * node_limiter *
+                                             expansion_term *
+                                             (dir * dvel_unit.z);
+
+            const int subcell_index =
+                face_nodes_to_subcells[(node_face_edge_index)];
+            const int rsubcell_index =
+                face_nodes_to_subcells[(rnode_face_edge_index)];
+            subcell_force_x[(subcell_index)] += edge_visc_force_x;
+            subcell_force_y[(subcell_index)] += edge_visc_force_y;
+            subcell_force_z[(subcell_index)] += edge_visc_force_z;
+            subcell_force_x[(rsubcell_index)] -= edge_visc_force_x;
+            subcell_force_y[(rsubcell_index)] -= edge_visc_force_y;
+            subcell_force_z[(rsubcell_index)] -= edge_visc_force_z;
+          }
         }
       }
     }
   }
 }
+
+// Calculates the artificial viscous forces, with the edge centric, hexahedral
+// or general kernel
+void calc_viscous_forces(UnstructuredMesh* umesh, HaleData* hale_data,
+                         const double* nodes_x, const double* nodes_y,
+                         const double* nodes_z, const double* velocity_x,
+                         const double* velocity_y, const double* velocity_z) {
+
+  if (hale_data->edge_centric_viscosity) {
+    calc_artificial_viscosity_by_edge(
+        hale_data->nedge_colours, hale_data->frontier_edge_colour_offsets,
+        hale_data->frontier_edges_by_colour, hale_data->edges_to_nodes,
+        hale_data->edges_to_faces_offsets, hale_data->edges_to_faces,
+        hale_data->edges_to_face_edges, umesh->faces_to_nodes_offsets,
+        umesh->faces_to_nodes, umesh->faces_to_cells0, umesh->faces_to_cells1,
+        hale_data->cells_frontier, hale_data->faces_nodes_to_subcells0,
+        hale_data->faces_nodes_to_subcells1, umesh->faces_cclockwise_cell,
+        hale_data->visc_coeff1, hale_data->visc_coeff2, nodes_x, nodes_y,
+        nodes_z, umesh->cell_centroids_x, umesh->cell_centroids_y,
+        umesh->cell_centroids_z, hale_data->face_centroids_x,
+        hale_data->face_centroids_y, hale_data->face_centroids_z, velocity_x,
+        velocity_y, velocity_z, hale_data->nodal_soundspeed,
+        hale_data->nodal_mass, hale_data->nodal_volumes, hale_data->limiter,
+        hale_data->subcell_force_x, hale_data->subcell_force_y,
+        hale_data->subcell_force_z);
+  } else if (hale_data->hex_mesh) {
+    calc_artificial_viscosity_hex(
+        hale_data->nfrontier_cells, hale_data->frontier_cells,
+        hale_data->visc_coeff1, hale_data->visc_coeff2, umesh->cells_to_faces,
+        umesh->faces_to_nodes, umesh->faces_to_cells0,
+        hale_data->faces_nodes_to_subcells0,
+        hale_data->faces_nodes_to_subcells1, umesh->faces_cclockwise_cell,
+        nodes_x, nodes_y, nodes_z, umesh->cell_centroids_x,
+        umesh->cell_centroids_y, umesh->cell_centroids_z,
+        hale_data->face_centroids_x, hale_data->face_centroids_y,
+        hale_data->face_centroids_z, velocity_x, velocity_y, velocity_z,
+        hale_data->nodal_soundspeed, hale_data->nodal_mass,
+        hale_data->nodal_volumes, hale_data->limiter,
+        hale_data->subcell_force_x, hale_data->subcell_force_y,
+        hale_data->subcell_force_z);
+  } else {
+    calc_artificial_viscosity(
+        hale_data->nfrontier_cells, hale_data->frontier_cells,
+        hale_data->visc_coeff1, hale_data->visc_coeff2, umesh->faces_to_cells0,
+        hale_data->faces_nodes_to_subcells0,
+        hale_data->faces_nodes_to_subcells1, umesh->faces_cclockwise_cell,
+        nodes_x, nodes_y, nodes_z, umesh->cell_centroids_x,
+        umesh->cell_centroids_y, umesh->cell_centroids_z,
+        hale_data->face_centroids_x, hale_data->face_centroids_y,
+        hale_data->face_centroids_z, velocity_x, velocity_y, velocity_z,
+        hale_data->nodal_soundspeed, hale_data->nodal_mass,
+        hale_data->nodal_volumes, hale_data->limiter,
+        hale_data->subcell_force_x, hale_data->subcell_force_y,
+        hale_data->subcell_force_z, umesh->faces_to_nodes_offsets,
+        umesh->faces_to_nodes, umesh->cells_to_faces_offsets,
+        umesh->cells_to_faces);
+  }
+}
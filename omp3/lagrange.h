@@ -7,44 +7,83 @@ void predictor(Mesh* mesh, UnstructuredMesh* umesh, HaleData* hale_data);
 void corrector(Mesh* mesh, UnstructuredMesh* umesh, HaleData* hale_data);
 
 // A simple ideal gas equation of state
-void equation_of_state(const int ncells, const double* energy,
-                       const double* density, double* pressure);
-
-// Calculates the nodal volume and sound speed
-void calc_nodal_vol_and_c(const int nnodes, const int* nodes_to_faces_offsets,
-                          const int* nodes_to_faces,
-                          const int* faces_to_nodes_offsets,
-                          const int* faces_to_nodes, const int* faces_to_cells0,
-                          const int* faces_to_cells1, const double* nodes_x,
-                          const double* nodes_y, const double* nodes_z,
-                          const double* cell_centroids_x,
-                          const double* cell_centroids_y,
-                          const double* cell_centroids_z, const double* energy,
-                          double* nodal_volumes, double* nodal_soundspeed);
+void equation_of_state(const int ncells, const int* cell_list,
+                       const double* energy, const double* density,
+                       double* pressure);
 
 // Sets all of the subcell forces to 0
-void zero_subcell_forces(const int ncells, const int* cells_offsets,
-                         double* subcell_force_x, double* subcell_force_y,
-                         double* subcell_force_z);
+void zero_subcell_forces(const int ncells, const int* cell_list,
+                         const int* cells_offsets, double* subcell_force_x,
+                         double* subcell_force_y, double* subcell_force_z);
 
+// Calculate the subcell force from pressure gradients
 void calc_subcell_force_from_pressure(
-    const int ncells, const int* cells_to_faces_offsets,
-    const int* cells_offsets, const int* cells_to_faces,
-    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
-    const int* cells_to_nodes, const int* face_cclockwise_cell,
-    const double* nodes_x, const double* nodes_y, const double* nodes_z,
+    const int ncells, const int* cell_list, const int* cells_to_faces_offsets,
+    const int* cells_to_faces, const int* faces_to_nodes_offsets,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const int* face_cclockwise_cell,
+    const double* face_edge_area_x, const double* face_edge_area_y,
+    const double* face_edge_area_z, const double* pressure,
+    double* subcell_force_x, double* subcell_force_y, double* subcell_force_z);
+
+// Calculate the subcell force from pressure gradients on a hexahedral mesh
+void calc_subcell_force_from_pressure_hex(
+    const int ncells, const int* cell_list, const int* cells_to_faces,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const int* faces_cclockwise_cell,
+    const double* face_edge_area_x, const double* face_edge_area_y,
+    const double* face_edge_area_z, const double* pressure,
+    double* subcell_force_x, double* subcell_force_y, double* subcell_force_z);
+
+// Calculate the subcell force from pressure gradients, visiting each face once
+// and applying the equal and opposite contributions to both adjacent cells
+void calc_subcell_force_from_pressure_by_face(
+    const int nface_colours, const int* face_colour_offsets,
+    const int* faces_by_colour, const int* faces_to_cells0,
+    const int* faces_to_cells1, const int* faces_to_nodes_offsets,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const int* faces_cclockwise_cell, const double* face_edge_area_x,
+    const double* face_edge_area_y, const double* face_edge_area_z,
     const double* pressure, double* subcell_force_x, double* subcell_force_y,
     double* subcell_force_z);
 
-// Scale the soundspeed by the inverse of the nodal volume
-void scale_soundspeed(const int nnodes, const double* nodal_volumes,
-                      double* nodal_soundspeed);
+// Calculates the subcell forces from the pressure, with the face centric,
+// hexahedral or general cell centric kernel
+void calc_pressure_forces(UnstructuredMesh* umesh, HaleData* hale_data,
+                          const double* pressure);
+
+// Calculates the pressure with the equation of state and sets the subcell
+// forces from it, without a separate pass to zero the forces
+void calc_eos_and_subcell_force(
+    const int ncells, const int* cell_list, const int* cells_to_faces_offsets,
+    const int* cells_to_nodes_offsets, const int* cells_to_faces,
+    const int* faces_to_nodes_offsets, const int* faces_to_cells0,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const int* faces_cclockwise_cell, const double* face_edge_area_x,
+    const double* face_edge_area_y, const double* face_edge_area_z,
+    const double* energy, const double* density, double* pressure,
+    double* subcell_force_x, double* subcell_force_y, double* subcell_force_z);
+
+// Calculates the pressure with the equation of state and sets the subcell
+// forces from it on a hexahedral mesh
+void calc_eos_and_subcell_force_hex(
+    const int ncells, const int* cell_list, const int* cells_to_faces,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const int* faces_cclockwise_cell,
+    const double* face_edge_area_x, const double* face_edge_area_y,
+    const double* face_edge_area_z, const double* energy, const double* density,
+    double* pressure, double* subcell_force_x, double* subcell_force_y,
+    double* subcell_force_z);
+
+// Calculates the pressure and the subcell forces from it in a single cell
+// pass, with the hexahedral or general kernel
+void calc_eos_and_pressure_forces(UnstructuredMesh* umesh,
+                                  HaleData* hale_data);
 
 // Calculate the time centered evolved velocities, by calculating the predicted
 // values at the new timestep and averaging with current velocity
-void calc_new_velocity(const int nnodes, const double dt,
-                       const int* nodes_offsets, const int* nodes_to_cells,
-                       const int* cells_offsets, const int* cells_to_nodes,
+void calc_new_velocity(const int nnodes, const int* node_list, const double dt,
+                       const int* nodes_offsets, const int* nodes_to_subcells,
                        const double* subcell_force_x,
                        const double* subcell_force_y,
                        const double* subcell_force_z, const double* nodal_mass,
@@ -53,109 +92,201 @@ void calc_new_velocity(const int nnodes, const double dt,
                        double* velocity_y1, double* velocity_z1);
 
 // Moves the nodes to the next time level
-void move_nodes(const int nnodes, const double dt, const double* nodes_x0,
-                const double* nodes_y0, const double* nodes_z0,
-                const double* velocity_x1, const double* velocity_y1,
-                const double* velocity_z1, double* nodes_x1, double* nodes_y1,
-                double* nodes_z1);
+void move_nodes(const int nnodes, const int* node_list, const double dt,
+                const double* nodes_x0, const double* nodes_y0,
+                const double* nodes_z0, const double* velocity_x1,
+                const double* velocity_y1, const double* velocity_z1,
+                double* nodes_x1, double* nodes_y1, double* nodes_z1);
 
 // calculates a new density from the pressure gradients
-void calc_predicted_density(const int ncells, const int* cells_to_faces_offsets,
-                            const int* cells_to_faces,
-                            const int* faces_to_nodes_offsets,
-                            const int* faces_to_nodes, const double* nodes_x1,
-                            const double* nodes_y1, const double* nodes_z1,
-                            const double* cell_centroids_x,
-                            const double* cell_centroids_y,
-                            const double* cell_centroids_z,
+void calc_predicted_density(const int ncells, const int* cell_list,
+                            const int* cells_to_nodes_offsets,
+                            const double* subcell_volume,
                             const double* cell_mass, double* density1);
 
 // Time centers the pressure
-void time_center_pressure(const int ncells, const double* energy1,
-                          const double* density1, const double* pressure0,
-                          double* pressure1);
+void time_center_pressure(const int ncells, const int* cell_list,
+                          const double* energy1, const double* density1,
+                          const double* pressure0, double* pressure1);
 
 // Time centers the nodal positions
-void time_center_nodes(const int nnodes, const double* nodes_x0,
-                       const double* nodes_y0, const double* nodes_z0,
-                       double* nodes_x1, double* nodes_y1, double* nodes_z1);
+void time_center_nodes(const int nnodes, const int* node_list,
+                       const double* nodes_x0, const double* nodes_y0,
+                       const double* nodes_z0, double* nodes_x1,
+                       double* nodes_y1, double* nodes_z1);
 
 // Updates and time center velocity in the corrector step
 void update_and_time_center_velocity(
-    const int nnodes, const double dt, const int* nodes_offsets,
-    const int* nodes_to_cells, const int* cells_offsets,
-    const int* cells_to_nodes, const double* nodal_mass,
-    const double* subcell_force_x, const double* subcell_force_y,
-    const double* subcell_force_z, double* velocity_x0, double* velocity_y0,
-    double* velocity_z0, double* velocity_x1, double* velocity_y1,
-    double* velocity_z1);
+    const int nnodes, const int* node_list, const double dt,
+    const int* nodes_offsets, const int* nodes_to_subcells,
+    const double* nodal_mass, const double* subcell_force_x,
+    const double* subcell_force_y, const double* subcell_force_z,
+    double* velocity_x0, double* velocity_y0, double* velocity_z0,
+    double* velocity_x1, double* velocity_y1, double* velocity_z1);
 
 // Advances the nodes using the corrected velocity
-void advance_nodes_corrected(const int nnodes, const double dt,
-                             const double* velocity_x0,
+void advance_nodes_corrected(const int nnodes, const int* node_list,
+                             const double dt, const double* velocity_x0,
                              const double* velocity_y0,
                              const double* velocity_z0, double* nodes_x0,
                              double* nodes_y0, double* nodes_z0);
 
 // Calculate the new energy base on subcell forces
-void calc_predicted_energy(const int ncells, const double dt,
-                           const int* cells_offsets, const int* cells_to_nodes,
-                           const double* velocity_x1, const double* velocity_y1,
-                           const double* velocity_z1,
+void calc_predicted_energy(const int ncells, const int* cell_list,
+                           const double dt, const int* cells_offsets,
+                           const int* cells_to_nodes, const double* velocity_x1,
+                           const double* velocity_y1, const double* velocity_z1,
                            const double* subcell_force_x,
                            const double* subcell_force_y,
                            const double* subcell_force_z, const double* energy0,
                            const double* cell_mass, double* energy1);
 
 // Calculates the energy from the correct subcell pressures and velocity
-void calc_corrected_energy(const int ncells, const double dt,
-                           const int* cells_offsets, const int* cells_to_nodes,
-                           const double* velocity_x0, const double* velocity_y0,
-                           const double* velocity_z0,
+void calc_corrected_energy(const int ncells, const int* cell_list,
+                           const double dt, const int* cells_offsets,
+                           const int* cells_to_nodes, const double* velocity_x0,
+                           const double* velocity_y0, const double* velocity_z0,
                            const double* subcell_force_x,
                            const double* subcell_force_y,
                            const double* subcell_force_z,
                            const double* cell_mass, double* energy0);
 
-// Calculates the density from the corrected volume
-void calc_corrected_density(
-    const int ncells, const int* cells_to_faces_offsets,
-    const int* cells_to_faces, const int* faces_to_nodes_offsets,
-    const int* faces_to_nodes, const double* nodes_x, const double* nodes_y,
-    const double* nodes_z, const double* cell_centroids_x,
-    const double* cell_centroids_y, const double* cell_centroids_z,
-    const double* cell_mass, double* cell_volume, double* density);
+// Calculates the density from the corrected volume, returning the shortest
+// time for a cell to change by its own volume at the rate of this timestep
+time_limit_t calc_corrected_density(const int ncells, const int* cell_list,
+                                    const double dt,
+                                    const int* cells_to_nodes_offsets,
+                                    const double* subcell_volume,
+                                    const double* cell_mass,
+                                    double* cell_volume, double* density);
+
+// Calculates the corrected cell centroids, subcell geometry, volumes,
+// densities and energies in a single cell pass, returning the shortest volume
+// change time
+time_limit_t calc_corrected_cell_state(
+    const int ncells, const int* cell_list, const double dt,
+    const int* cells_to_nodes_offsets, const int* cells_to_nodes,
+    const int* cells_to_faces_offsets, const int* cells_to_faces,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const double* nodes_x,
+    const double* nodes_y, const double* nodes_z, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    const double* subcell_force_x, const double* subcell_force_y,
+    const double* subcell_force_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    const double* cell_mass, double* cell_centroids_x, double* cell_centroids_y,
+    double* cell_centroids_z, double* subcell_volume,
+    double* subcell_centroids_x, double* subcell_centroids_y,
+    double* subcell_centroids_z, double* cell_volume, double* density,
+    double* energy0);
+
+// Calculates the corrected cell state in a single pass on a hexahedral mesh,
+// with the fixed numbers of nodes and faces by cell
+time_limit_t calc_corrected_cell_state_hex(
+    const int ncells, const int* cell_list, const double dt,
+    const int* cells_to_nodes, const int* cells_to_faces,
+    const int* faces_to_nodes_offsets, const int* faces_to_nodes,
+    const int* faces_to_cells0, const int* faces_nodes_to_subcells0,
+    const int* faces_nodes_to_subcells1, const double* nodes_x,
+    const double* nodes_y, const double* nodes_z, const double* velocity_x,
+    const double* velocity_y, const double* velocity_z,
+    const double* subcell_force_x, const double* subcell_force_y,
+    const double* subcell_force_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    const double* cell_mass, double* cell_centroids_x, double* cell_centroids_y,
+    double* cell_centroids_z, double* subcell_volume,
+    double* subcell_centroids_x, double* subcell_centroids_y,
+    double* subcell_centroids_z, double* cell_volume, double* density,
+    double* energy0);
+
+// Updates the corrected cell state in a single cell pass, with the hexahedral
+// or general kernel, returning the shortest volume change time
+time_limit_t update_corrected_cells(UnstructuredMesh* umesh,
+                                    HaleData* hale_data, const double dt);
 
 // Calculates the artificial viscous forces for momentum acceleration
 void calc_artificial_viscosity(
-    const int ncells, const double visc_coeff1, const double visc_coeff2,
-    const int* cells_offsets, const int* cells_to_nodes,
+    const int ncells, const int* cell_list, const double visc_coeff1,
+    const double visc_coeff2, const int* faces_to_cells0,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
     const int* face_cclockwise_cell, const double* nodes_x,
     const double* nodes_y, const double* nodes_z,
     const double* cell_centroids_x, const double* cell_centroids_y,
-    const double* cell_centroids_z, const double* velocity_x,
+    const double* cell_centroids_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    const double* velocity_x, const double* velocity_y,
+    const double* velocity_z, const double* nodal_soundspeed,
+    const double* nodal_mass, const double* nodal_volumes,
+    const double* limiter, double* subcell_force_x, double* subcell_force_y,
+    double* subcell_force_z, int* faces_to_nodes_offsets, int* faces_to_nodes,
+    int* cells_to_faces_offsets, int* cells_to_faces);
+
+// Calculates the artificial viscous forces for momentum acceleration on a
+// hexahedral mesh
+void calc_artificial_viscosity_hex(
+    const int ncells, const int* cell_list, const double visc_coeff1,
+    const double visc_coeff2, const int* cells_to_faces,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const int* faces_cclockwise_cell, const double* nodes_x,
+    const double* nodes_y, const double* nodes_z,
+    const double* cell_centroids_x, const double* cell_centroids_y,
+    const double* cell_centroids_z, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    const double* velocity_x, const double* velocity_y,
+    const double* velocity_z, const double* nodal_soundspeed,
+    const double* nodal_mass, const double* nodal_volumes,
+    const double* limiter, double* subcell_force_x, double* subcell_force_y,
+    double* subcell_force_z);
+
+// Calculates the artificial viscous forces for momentum acceleration edge by
+// edge, so the velocity difference, edge density and viscous coefficients are
+// computed once for each edge. The edges of a colour share no nodes, so their
+// subcell forces can be updated without races. Only the subcells of the cells
+// in cells_frontier are updated, or of every cell when it is NULL.
+void calc_artificial_viscosity_by_edge(
+    const int nedge_colours, const int* edge_colour_offsets,
+    const int* edges_by_colour, const int* edges_to_nodes,
+    const int* edges_to_faces_offsets, const int* edges_to_faces,
+    const int* edges_to_face_edges, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_to_cells1, const int* cells_frontier,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const int* faces_cclockwise_cell, const double visc_coeff1,
+    const double visc_coeff2, const double* nodes_x, const double* nodes_y,
+    const double* nodes_z, const double* cell_centroids_x,
+    const double* cell_centroids_y, const double* cell_centroids_z,
+    const double* face_centroids_x, const double* face_centroids_y,
+    const double* face_centroids_z, const double* velocity_x,
     const double* velocity_y, const double* velocity_z,
     const double* nodal_soundspeed, const double* nodal_mass,
     const double* nodal_volumes, const double* limiter, double* subcell_force_x,
-    double* subcell_force_y, double* subcell_force_z,
-    int* faces_to_nodes_offsets, int* faces_to_nodes,
-    int* cells_to_faces_offsets, int* cells_to_faces);
+    double* subcell_force_y, double* subcell_force_z);
 
-// Calculates the volume in a cell by tetrahedral decomposition
-double calc_cell_volume(const int cc, const int nfaces_by_cell,
-                        const int cell_to_faces_off, const int* cells_to_faces,
-                        const int* faces_to_nodes_offsets,
-                        const int* faces_to_nodes, const double* nodes_x,
-                        const double* nodes_y, const double* nodes_z,
-                        const double* cell_centroids_x,
-                        const double* cell_centroids_y,
-                        const double* cell_centroids_z);
-
-// Calculates the volume of a subsubcell
-double calc_subsubcell_volume(const int cc, const int next_node,
-                              const int current_node, vec_t face_c,
-                              const double* nodes_x, const double* nodes_y,
-                              const double* nodes_z,
-                              const double* cell_centroids_x,
-                              const double* cell_centroids_y,
-                              const double* cell_centroids_z);
+// Calculates the artificial viscous forces, with the edge centric, hexahedral
+// or general kernel
+void calc_viscous_forces(UnstructuredMesh* umesh, HaleData* hale_data,
+                         const double* nodes_x, const double* nodes_y,
+                         const double* nodes_z, const double* velocity_x,
+                         const double* velocity_y, const double* velocity_z);
+
+// Calculates the volume of a cell as the sum of its subcell volumes
+double calc_cell_volume(const int cell_to_nodes_off, const int nnodes_by_cell,
+                        const double* subcell_volume);
+
+// Calculates the volumes and centroids of the subcells of a cell, returning
+// the cell volume. The tetrahedron between each face edge, the face centroid
+// and the cell centroid is split at the edge midpoint between the subcells of
+// the edge's two nodes
+double calc_cell_subcell_geometry(
+    const int cc, const int cell_to_nodes_off, const int nnodes_by_cell,
+    const int cell_to_faces_off, const int nfaces_by_cell,
+    const int* cells_to_faces, const int* faces_to_nodes_offsets,
+    const int* faces_to_nodes, const int* faces_to_cells0,
+    const int* faces_nodes_to_subcells0, const int* faces_nodes_to_subcells1,
+    const double* nodes_x, const double* nodes_y, const double* nodes_z,
+    const vec_t cell_c, const double* face_centroids_x,
+    const double* face_centroids_y, const double* face_centroids_z,
+    double* subcell_volume, double* subcell_centroids_x,
+    double* subcell_centroids_y, double* subcell_centroids_z);
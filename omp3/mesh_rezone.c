@@ -31,11 +31,104 @@ void eulerian_rezone(UnstructuredMesh* umesh, HaleData* hale_data) {
                       hale_data->rezoned_nodes_y, hale_data->rezoned_nodes_z,
                       umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0);
 
-  // Determine the new cell centroids
-  init_cell_centroids(umesh->ncells, umesh->cells_to_nodes_offsets,
-                      umesh->cells_to_nodes, umesh->nodes_x0, umesh->nodes_y0,
-                      umesh->nodes_z0, umesh->cell_centroids_x,
-                      umesh->cell_centroids_y, umesh->cell_centroids_z);
+  // The new cell centroids and face geometry are those of the rezoned mesh
+  update_rezoned_geometry(umesh, hale_data);
+  copy_rezoned_geometry(umesh->ncells, hale_data->rezoned_cell_centroids_x,
+                        umesh->cell_centroids_x);
+  copy_rezoned_geometry(umesh->ncells, hale_data->rezoned_cell_centroids_y,
+                        umesh->cell_centroids_y);
+  copy_rezoned_geometry(umesh->ncells, hale_data->rezoned_cell_centroids_z,
+                        umesh->cell_centroids_z);
+  copy_rezoned_geometry(umesh->nfaces, hale_data->rezoned_face_centroids_x,
+                        hale_data->face_centroids_x);
+  copy_rezoned_geometry(umesh->nfaces, hale_data->rezoned_face_centroids_y,
+                        hale_data->face_centroids_y);
+  copy_rezoned_geometry(umesh->nfaces, hale_data->rezoned_face_centroids_z,
+                        hale_data->face_centroids_z);
+
+  const int nface_edges = umesh->faces_to_nodes_offsets[(umesh->nfaces)];
+  copy_rezoned_geometry(nface_edges, hale_data->rezoned_face_edge_area_x,
+                        hale_data->face_edge_area_x);
+  copy_rezoned_geometry(nface_edges, hale_data->rezoned_face_edge_area_y,
+                        hale_data->face_edge_area_y);
+  copy_rezoned_geometry(nface_edges, hale_data->rezoned_face_edge_area_z,
+                        hale_data->face_edge_area_z);
+  copy_rezoned_geometry(nface_edges, hale_data->rezoned_face_edge_lengths,
+                        hale_data->face_edge_lengths);
+}
+
+// Calculates the geometry of the rezoned mesh, unless the cached geometry is
+// still valid for the rezoned nodes
+void update_rezoned_geometry(UnstructuredMesh* umesh, HaleData* hale_data) {
+
+  if (hale_data->rezoned_geometry_valid) {
+    return;
+  }
+
+  if (hale_data->hex_mesh) {
+    calc_cell_centroids_hex(
+        umesh->ncells, NULL, umesh->cells_to_nodes, hale_data->rezoned_nodes_x,
+        hale_data->rezoned_nodes_y, hale_data->rezoned_nodes_z,
+        hale_data->rezoned_cell_centroids_x,
+        hale_data->rezoned_cell_centroids_y,
+        hale_data->rezoned_cell_centroids_z);
+    calc_face_geometry_hex(
+        umesh->nfaces, umesh->faces_to_nodes, umesh->faces_to_cells0,
+        umesh->faces_to_cells1, hale_data->rezoned_nodes_x,
+        hale_data->rezoned_nodes_y, hale_data->rezoned_nodes_z, NULL, NULL,
+        NULL, NULL, hale_data->rezoned_face_centroids_x,
+        hale_data->rezoned_face_centroids_y,
+        hale_data->rezoned_face_centroids_z,
+        hale_data->rezoned_face_edge_area_x,
+        hale_data->rezoned_face_edge_area_y,
+        hale_data->rezoned_face_edge_area_z,
+        hale_data->rezoned_face_edge_lengths);
+  } else {
+    init_cell_centroids(umesh->ncells, NULL, umesh->cells_to_nodes_offsets,
+                        umesh->cells_to_nodes, hale_data->rezoned_nodes_x,
+                        hale_data->rezoned_nodes_y, hale_data->rezoned_nodes_z,
+                        hale_data->rezoned_cell_centroids_x,
+                        hale_data->rezoned_cell_centroids_y,
+                        hale_data->rezoned_cell_centroids_z);
+    calc_face_geometry(
+        umesh->nfaces, umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+        umesh->faces_to_cells0, umesh->faces_to_cells1,
+        hale_data->rezoned_nodes_x, hale_data->rezoned_nodes_y,
+        hale_data->rezoned_nodes_z, NULL, NULL, NULL, NULL,
+        hale_data->rezoned_face_centroids_x,
+        hale_data->rezoned_face_centroids_y,
+        hale_data->rezoned_face_centroids_z,
+        hale_data->rezoned_face_edge_area_x,
+        hale_data->rezoned_face_edge_area_y,
+        hale_data->rezoned_face_edge_area_z,
+        hale_data->rezoned_face_edge_lengths);
+  }
+
+  calc_subcell_geometry(
+      umesh->ncells, NULL, umesh->cells_to_nodes_offsets,
+      umesh->cells_to_faces_offsets, umesh->cells_to_faces,
+      umesh->faces_to_nodes_offsets, umesh->faces_to_nodes,
+      umesh->faces_to_cells0, hale_data->faces_nodes_to_subcells0,
+      hale_data->faces_nodes_to_subcells1, hale_data->rezoned_nodes_x,
+      hale_data->rezoned_nodes_y, hale_data->rezoned_nodes_z,
+      hale_data->rezoned_cell_centroids_x, hale_data->rezoned_cell_centroids_y,
+      hale_data->rezoned_cell_centroids_z, hale_data->rezoned_face_centroids_x,
+      hale_data->rezoned_face_centroids_y, hale_data->rezoned_face_centroids_z,
+      hale_data->rezoned_subcell_volume, hale_data->rezoned_subcell_centroids_x,
+      hale_data->rezoned_subcell_centroids_y,
+      hale_data->rezoned_subcell_centroids_z);
+
+  hale_data->rezoned_geometry_valid = 1;
+}
+
+// Copies cached rezoned geometry into the geometry of the current mesh
+void copy_rezoned_geometry(const int n, const double* rezoned_data,
+                           double* data) {
+
+#pragma omp parallel for
+  for (int ii = 0; ii < n; ++ii) {
+    data[(ii)] = rezoned_data[(ii)];
+  }
 }
 
 // Correct the subcell data by the determined fluxes
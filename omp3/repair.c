@@ -27,6 +27,10 @@
 
 // Repairs the subcell extrema for mass
 void repair_subcell_extrema(const int ncells, const int* cells_to_nodes_offsets,
+                            const int* cells_to_faces_offsets,
+                            const int* cells_to_faces,
+                            const int* faces_to_cells0,
+                            const int* faces_to_cells1, const int* cells_active,
                             const int* subcells_to_subcells_offsets,
                             const int* subcells_to_subcells,
                             double* subcell_volume, double* subcell_mass);
@@ -58,6 +62,9 @@ void mass_repair_phase(UnstructuredMesh* umesh, HaleData* hale_data) {
 
   // Advects mass and energy through the subcell faces using swept edge approx
   repair_subcell_extrema(umesh->ncells, umesh->cells_to_nodes_offsets,
+                         umesh->cells_to_faces_offsets, umesh->cells_to_faces,
+                         umesh->faces_to_cells0, umesh->faces_to_cells1,
+                         hale_data->cells_active,
                          hale_data->subcells_to_subcells_offsets,
                          hale_data->subcells_to_subcells,
                          hale_data->subcell_volume, hale_data->subcell_mass);
@@ -402,6 +409,10 @@ void repair_energy_extrema(const int ncells, const int* cells_to_faces_offsets,
 
 // Repairs the subcell extrema for mass
 void repair_subcell_extrema(const int ncells, const int* cells_to_nodes_offsets,
+                            const int* cells_to_faces_offsets,
+                            const int* cells_to_faces,
+                            const int* faces_to_cells0,
+                            const int* faces_to_cells1, const int* cells_active,
                             const int* subcells_to_subcells_offsets,
                             const int* subcells_to_subcells,
                             double* subcell_volume, double* subcell_mass) {
@@ -412,6 +423,13 @@ void repair_subcell_extrema(const int ncells, const int* cells_to_nodes_offsets,
     const int nnodes_by_cell =
         cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
 
+    // The advection can only introduce an extremum into a subcell whose own
+    // mass, or a neighbour's, has changed, which needs a nearby active cell
+    if (!is_near_active_cell(cc, cells_to_faces_offsets, cells_to_faces,
+                             faces_to_cells0, faces_to_cells1, cells_active)) {
+      continue;
+    }
+
     // Looping over corner subcells here
     for (int nn = 0; nn < nnodes_by_cell; ++nn) {
       const int subcell_index = cell_to_nodes_off + nn;
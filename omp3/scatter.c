@@ -6,19 +6,16 @@
 
 // Scatter the subcell energy and mass quantities back to the cell centers
 void scatter_energy_and_mass(
-    const int ncells, const double* nodes_x, const double* nodes_y,
-    const double* nodes_z, double* cell_volume, double* energy, double* density,
-    double* ke_mass, double* velocity_x, double* velocity_y, double* velocity_z,
-    double* cell_mass, double* subcell_mass, double* subcell_ie_mass,
-    double* subcell_ke_mass, int* faces_to_nodes, int* faces_to_nodes_offsets,
-    int* cells_to_faces_offsets, int* cells_to_faces,
+    const int ncells, const double* subcell_volume, double* cell_volume,
+    double* energy, double* density, double* ke_mass, double* velocity_x,
+    double* velocity_y, double* velocity_z, double* cell_mass,
+    double* subcell_mass, double* subcell_ie_mass, double* subcell_ke_mass,
     int* cells_to_nodes_offsets, int* cells_to_nodes, double initial_mass,
     double initial_ie_mass, double initial_ke_mass);
 
 // Scatter the subcell momentum to the node centered velocities
 void scatter_momentum(const int nnodes, vec_t* initial_momentum,
-                      int* nodes_to_cells_offsets, int* nodes_to_cells,
-                      int* cells_to_nodes_offsets, int* cells_to_nodes,
+                      int* nodes_to_cells_offsets, int* nodes_to_subcells,
                       double* velocity_x, double* velocity_y,
                       double* velocity_z, double* nodal_mass,
                       double* subcell_mass, double* subcell_momentum_x,
@@ -29,49 +26,43 @@ void scatter_phase(UnstructuredMesh* umesh, HaleData* hale_data,
                    vec_t* initial_momentum, double initial_mass,
                    double initial_ie_mass, double initial_ke_mass) {
 
-  // Calculates the cell volume, subcell volume and the subcell centroids
-  calc_volumes_centroids(
-      umesh->ncells, umesh->nnodes, hale_data->nnodes_by_subcell,
-      umesh->cells_to_nodes_offsets, umesh->cells_to_nodes,
-      hale_data->subcells_to_faces_offsets, hale_data->subcells_to_faces,
-      umesh->faces_to_nodes, umesh->faces_to_nodes_offsets,
-      umesh->faces_cclockwise_cell, umesh->nodes_x0, umesh->nodes_y0,
-      umesh->nodes_z0, hale_data->subcell_centroids_x,
-      hale_data->subcell_centroids_y, hale_data->subcell_centroids_z,
-      hale_data->subcell_volume, hale_data->cell_volume,
-      hale_data->nodal_volumes, umesh->nodes_to_cells_offsets,
-      umesh->nodes_to_cells);
+  // The subcell volumes and centroids are those of the rezoned mesh
+  copy_rezoned_geometry(hale_data->nsubcells, hale_data->rezoned_subcell_volume,
+                        hale_data->subcell_volume);
+  copy_rezoned_geometry(hale_data->nsubcells,
+                        hale_data->rezoned_subcell_centroids_x,
+                        hale_data->subcell_centroids_x);
+  copy_rezoned_geometry(hale_data->nsubcells,
+                        hale_data->rezoned_subcell_centroids_y,
+                        hale_data->subcell_centroids_y);
+  copy_rezoned_geometry(hale_data->nsubcells,
+                        hale_data->rezoned_subcell_centroids_z,
+                        hale_data->subcell_centroids_z);
 
   // Scatter the subcell momentum to the node centered velocities
   scatter_momentum(
       umesh->nnodes, initial_momentum, umesh->nodes_to_cells_offsets,
-      umesh->nodes_to_cells, umesh->cells_to_nodes_offsets,
-      umesh->cells_to_nodes, hale_data->velocity_x0, hale_data->velocity_y0,
-      hale_data->velocity_z0, hale_data->nodal_mass, hale_data->subcell_mass,
-      hale_data->subcell_momentum_x, hale_data->subcell_momentum_y,
-      hale_data->subcell_momentum_z);
+      hale_data->nodes_to_subcells, hale_data->velocity_x0,
+      hale_data->velocity_y0, hale_data->velocity_z0, hale_data->nodal_mass,
+      hale_data->subcell_mass, hale_data->subcell_momentum_x,
+      hale_data->subcell_momentum_y, hale_data->subcell_momentum_z);
 
   // Scatter the subcell energy and mass quantities back to the cell centers
   scatter_energy_and_mass(
-      umesh->ncells, umesh->nodes_x0, umesh->nodes_y0, umesh->nodes_z0,
-      hale_data->cell_volume, hale_data->energy0, hale_data->density0,
-      hale_data->ke_mass, hale_data->velocity_x0, hale_data->velocity_y0,
-      hale_data->velocity_z0, hale_data->cell_mass, hale_data->subcell_mass,
-      hale_data->subcell_ie_mass, hale_data->subcell_ke_mass,
-      umesh->faces_to_nodes, umesh->faces_to_nodes_offsets,
-      umesh->cells_to_faces_offsets, umesh->cells_to_faces,
-      umesh->cells_to_nodes_offsets, umesh->cells_to_nodes, initial_mass,
-      initial_ie_mass, initial_ke_mass);
+      umesh->ncells, hale_data->subcell_volume, hale_data->cell_volume,
+      hale_data->energy0, hale_data->density0, hale_data->ke_mass,
+      hale_data->velocity_x0, hale_data->velocity_y0, hale_data->velocity_z0,
+      hale_data->cell_mass, hale_data->subcell_mass, hale_data->subcell_ie_mass,
+      hale_data->subcell_ke_mass, umesh->cells_to_nodes_offsets,
+      umesh->cells_to_nodes, initial_mass, initial_ie_mass, initial_ke_mass);
 }
 
 // Scatter the subcell energy and mass quantities back to the cell centers
 void scatter_energy_and_mass(
-    const int ncells, const double* nodes_x, const double* nodes_y,
-    const double* nodes_z, double* cell_volume, double* energy, double* density,
-    double* ke_mass, double* velocity_x, double* velocity_y, double* velocity_z,
-    double* cell_mass, double* subcell_mass, double* subcell_ie_mass,
-    double* subcell_ke_mass, int* faces_to_nodes, int* faces_to_nodes_offsets,
-    int* cells_to_faces_offsets, int* cells_to_faces,
+    const int ncells, const double* subcell_volume, double* cell_volume,
+    double* energy, double* density, double* ke_mass, double* velocity_x,
+    double* velocity_y, double* velocity_z, double* cell_mass,
+    double* subcell_mass, double* subcell_ie_mass, double* subcell_ke_mass,
     int* cells_to_nodes_offsets, int* cells_to_nodes, double initial_mass,
     double initial_ie_mass, double initial_ke_mass) {
 
@@ -83,20 +74,19 @@ void scatter_energy_and_mass(
     const int cell_to_nodes_off = cells_to_nodes_offsets[(cc)];
     const int nnodes_by_cell =
         cells_to_nodes_offsets[(cc + 1)] - cell_to_nodes_off;
-    const int cell_to_faces_off = cells_to_faces_offsets[(cc)];
-    const int nfaces_by_cell =
-        cells_to_faces_offsets[(cc + 1)] - cell_to_faces_off;
 
     double total_mass = 0.0;
     double new_ke_mass = 0.0;
     double total_ie_mass = 0.0;
     double total_ke_mass = 0.0;
+    double total_volume = 0.0;
     for (int nn = 0; nn < nnodes_by_cell; ++nn) {
       const int node_index = cells_to_nodes[(cell_to_nodes_off + nn)];
       const int subcell_index = cell_to_nodes_off + nn;
       total_mass += subcell_mass[(subcell_index)];
       total_ie_mass += subcell_ie_mass[(subcell_index)];
       total_ke_mass += subcell_ke_mass[(subcell_index)];
+      total_volume += subcell_volume[(subcell_index)];
       new_ke_mass += subcell_mass[(subcell_index)] * 0.5 *
                      (velocity_x[(node_index)] * velocity_x[(node_index)] +
                       velocity_y[(node_index)] * velocity_y[(node_index)] +
@@ -104,12 +94,7 @@ void scatter_energy_and_mass(
     }
 
     // Update the volume of the cell to the new rezoned mesh
-    vec_t cell_c = {0.0, 0.0, 0.0};
-    calc_centroid(nnodes_by_cell, nodes_x, nodes_y, nodes_z, cells_to_nodes,
-                  cell_to_nodes_off, &cell_c);
-    calc_volume(cell_to_faces_off, nfaces_by_cell, cells_to_faces,
-                faces_to_nodes, faces_to_nodes_offsets, nodes_x, nodes_y,
-                nodes_z, &cell_c, &cell_volume[(cc)]);
+    cell_volume[(cc)] = total_volume;
 
     // Scatter the energy and density
     cell_mass[(cc)] = total_mass;
@@ -136,8 +121,7 @@ void scatter_energy_and_mass(
 
 // Scatter the subcell momentum to the node centered velocities
 void scatter_momentum(const int nnodes, vec_t* initial_momentum,
-                      int* nodes_to_cells_offsets, int* nodes_to_cells,
-                      int* cells_to_nodes_offsets, int* cells_to_nodes,
+                      int* nodes_to_cells_offsets, int* nodes_to_subcells,
                       double* velocity_x, double* velocity_y,
                       double* velocity_z, double* nodal_mass,
                       double* subcell_mass, double* subcell_momentum_x,
@@ -160,20 +144,7 @@ void scatter_momentum(const int nnodes, vec_t* initial_momentum,
     double node_momentum_z = 0.0;
 
     for (int cc = 0; cc < ncells_by_node; ++cc) {
-      const int cell_index = nodes_to_cells[(node_to_cells_off + cc)];
-      const int cell_to_nodes_off = cells_to_nodes_offsets[(cell_index)];
-      const int nnodes_by_cell =
-          cells_to_nodes_offsets[(cell_index + 1)] - cell_to_nodes_off;
-
-      // Determine the position of the node in the cell
-      int nn2;
-      for (nn2 = 0; nn2 < nnodes_by_cell; ++nn2) {
-        if (cells_to_nodes[(cell_to_nodes_off + nn2)] == nn) {
-          break;
-        }
-      }
-
-      const int subcell_index = cell_to_nodes_off + nn2;
+      const int subcell_index = nodes_to_subcells[(node_to_cells_off + cc)];
       node_momentum_x += subcell_momentum_x[(subcell_index)];
       node_momentum_y += subcell_momentum_y[(subcell_index)];
       node_momentum_z += subcell_momentum_z[(subcell_index)];